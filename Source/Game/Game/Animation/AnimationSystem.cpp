@@ -387,6 +387,39 @@ namespace Animation
 		_storage.dirtyInstances.resize(numInstances);
 	}
 
+	void AnimationSystem::RemapInstanceIDs(const std::vector<InstanceID>& oldToNewInstanceID)
+	{
+		bool isEnabled = CVAR_AnimationSystemEnabled.Get();
+		if (!isEnabled)
+		{
+			return;
+		}
+
+		u32 numInstances = _storage.instancesIndex.load();
+		for (u32 i = 0; i < numInstances; i++)
+		{
+			InstanceID& instanceID = _storage.instanceIDs[i];
+			instanceID = oldToNewInstanceID[instanceID];
+		}
+
+		u32 numDirtyInstances = _storage.dirtyInstancesIndex.load();
+		for (u32 i = 0; i < numDirtyInstances; i++)
+		{
+			InstanceID& instanceID = _storage.dirtyInstances[i];
+			instanceID = oldToNewInstanceID[instanceID];
+		}
+
+		robin_hood::unordered_map<InstanceID, AnimationInstance> remappedInstances;
+		remappedInstances.reserve(_storage.instanceIDToData.size());
+
+		for (auto& [instanceID, instance] : _storage.instanceIDToData)
+		{
+			remappedInstances[oldToNewInstanceID[instanceID]] = std::move(instance);
+		}
+
+		_storage.instanceIDToData.swap(remappedInstances);
+	}
+
 	void AnimationSystem::Clear()
 	{
 		bool isEnabled = CVAR_AnimationSystemEnabled.Get();
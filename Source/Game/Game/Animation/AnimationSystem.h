@@ -117,6 +117,8 @@ namespace Animation
 		void FitToBuffersAfterLoad();
 		void Clear();
 
+		void RemapInstanceIDs(const std::vector<InstanceID>& oldToNewInstanceID);
+
 	private:
 		mat4x4 GetBoneMatrix(const AnimationSkeleton& skeleton, AnimationBoneState& animBone, const Model::ComplexModel::Bone& bone);
 		mat4x4 HandleBoneAnimation(const AnimationSkeleton& skeleton, AnimationBoneState& animBone, const Model::ComplexModel::Bone& bone, f32 deltaTime);
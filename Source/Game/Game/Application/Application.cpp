@@ -17,6 +17,7 @@
 #include <Game/Util/ServiceLocator.h>
 #include <Game/Loaders/LoaderSystem.h>
 #include <Game/Scripting/LuaManager.h>
+#include <Game/Scripting/LuaProfiler.h>
 #include <Game/Scripting/Systems/LuaSystemBase.h>
 
 #include <enkiTS/TaskScheduler.h>
@@ -65,6 +66,12 @@ void Application::Stop()
 
 void Application::Cleanup()
 {
+	Scripting::LuaProfiler::Shutdown();
+
+	if (_ecsScheduler)
+	{
+		_ecsScheduler->Shutdown(*_registries.gameRegistry);
+	}
 }
 
 void Application::PassMessage(MessageInbound& message)
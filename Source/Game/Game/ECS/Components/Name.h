@@ -1,4 +1,6 @@
 #pragma once
+#include "Game/Util/StringInterner.h"
+
 #include <Base/Types.h>
 #include <Base/Util/Reflection.h>
 
@@ -7,8 +9,8 @@ namespace ECS::Components
 	struct Name
 	{
 	public:
-		std::string name;
-		std::string fullName;
+		Util::InternedString name;
+		Util::InternedString fullName;
 		u32 nameHash;
 	};
 }
@@ -17,4 +19,4 @@ REFL_TYPE(ECS::Components::Name)
 	REFL_FIELD(name, Reflection::ReadOnly())
 	REFL_FIELD(fullName, Reflection::ReadOnly())
 	REFL_FIELD(nameHash, Reflection::Hidden())
-REFL_END
\ No newline at end of file
+REFL_END
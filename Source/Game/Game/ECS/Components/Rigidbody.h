@@ -0,0 +1,31 @@
+#pragma once
+#include <Base/Types.h>
+#include <Base/Util/Reflection.h>
+
+#include <limits>
+
+namespace ECS::Components
+{
+	struct Rigidbody
+	{
+	public:
+		static constexpr u32 InvalidBodyID = std::numeric_limits<u32>().max();
+
+		// JPH::BodyID::GetIndexAndSequenceNumber(), kept as a plain u32 so this header doesn't need Jolt
+		u32 bodyID = InvalidBodyID;
+
+		// Body state of the last two fixed steps, the Transform gets interpolated between them
+		vec3 previousPosition = vec3(0.0f, 0.0f, 0.0f);
+		quat previousRotation = quat(1.0f, 0.0f, 0.0f, 0.0f);
+		vec3 currentPosition = vec3(0.0f, 0.0f, 0.0f);
+		quat currentRotation = quat(1.0f, 0.0f, 0.0f, 0.0f);
+	};
+}
+
+REFL_TYPE(ECS::Components::Rigidbody)
+	REFL_FIELD(bodyID, Reflection::ReadOnly())
+	REFL_FIELD(previousPosition, Reflection::Hidden())
+	REFL_FIELD(previousRotation, Reflection::Hidden())
+	REFL_FIELD(currentPosition, Reflection::Hidden())
+	REFL_FIELD(currentRotation, Reflection::Hidden())
+REFL_END
@@ -5,7 +5,9 @@
 #include <Game/ECS/Singletons/ActiveCamera.h>
 #include <Game/ECS/Singletons/EngineStats.h>
 #include <Game/ECS/Singletons/RenderState.h>
+#include <Game/ECS/Components/AABB.h>
 #include <Game/ECS/Components/Camera.h>
+#include <Game/ECS/Components/DebugRenderTransform.h>
 #include <Game/ECS/Components/Transform.h>
 
 #include <Game/ECS/Systems/CalculateCameraMatrices.h>
@@ -16,11 +18,35 @@
 #include <Game/ECS/Systems/UpdateScripts.h>
 #include <Game/ECS/Systems/CalculateTransformMatrices.h>
 #include <Game/ECS/Systems/UpdateAABBs.h>
+#include <Game/Util/ServiceLocator.h>
+
+#include <Base/Util/Timer.h>
 
 #include <entt/entt.hpp>
+#include <tracy/Tracy.hpp>
 
 namespace ECS
 {
+	NativeSystemTask::NativeSystemTask(const SystemAccess& access, UpdateFunc update) : _access(access), _update(update)
+	{
+		m_SetSize = 1;
+	}
+
+	void NativeSystemTask::ExecuteRange(enki::TaskSetPartition range, u32 threadNum)
+	{
+		ZoneScoped;
+
+		// Waiting from a task keeps the thread busy with other tasks, so this never blocks a worker
+		enki::TaskScheduler* scheduler = ServiceLocator::GetTaskScheduler();
+		for (NativeSystemTask* dependency : _dependencies)
+		{
+			scheduler->WaitforTask(dependency);
+		}
+
+		Systems::UpdateScripts::WaitFor(*_registry, _access);
+		_update(*_registry, _deltaTime);
+	}
+
 	Scheduler::Scheduler()
 	{
 
@@ -34,6 +60,16 @@ namespace ECS
 		Systems::FreeflyingCamera::Init(registry);
 		Systems::UpdateScripts::Init(registry);
 
+		// Native systems run next to each other and the scripts, a view that has to create a missing storage from a task would race them
+		registry.storage<Components::Transform>();
+		registry.storage<Components::DirtyTransform>();
+		registry.storage<Components::AABB>();
+		registry.storage<Components::WorldAABB>();
+		registry.storage<Components::DebugRenderTransform>();
+
+		AddNativeSystem(Systems::UpdateAABBs::Access, &Systems::UpdateAABBs::Update);
+		AddNativeSystem(Systems::DrawDebugMesh::Access, &Systems::DrawDebugMesh::Update);
+
 		entt::registry::context& ctx = registry.ctx();
 		Singletons::EngineStats& engineStats = ctx.emplace<Singletons::EngineStats>();
 		
@@ -43,15 +79,70 @@ namespace ECS
 	void Scheduler::Update(entt::registry& registry, f32 deltaTime)
 	{
 		// TODO: You know, actually scheduling stuff and multithreading (enkiTS tasks?)
-		Systems::CalculateTransformMatrices::Update(registry, deltaTime);
-		Systems::UpdateAABBs::Update(registry, deltaTime);
 		Systems::NetworkConnection::Update(registry, deltaTime);
+
+		// Physics flags the bodies it moved as dirty, so it needs to run before the transforms are calculated
 		Systems::UpdatePhysics::Update(registry, deltaTime);
-		Systems::DrawDebugMesh::Update(registry, deltaTime);
+		Systems::CalculateTransformMatrices::Update(registry, deltaTime);
 		Systems::FreeflyingCamera::Update(registry, deltaTime);
 		Systems::CalculateCameraMatrices::Update(registry, deltaTime);
 
-		// Note: For now UpdateScripts should always be run last
+		// Scripts run on the task scheduler from here until Finish, native systems in between only wait for the systems they conflict with
 		Systems::UpdateScripts::Update(registry, deltaTime);
+
+		{
+			ZoneScopedN("Native Systems");
+
+			Timer timer;
+			enki::TaskScheduler* scheduler = ServiceLocator::GetTaskScheduler();
+
+			for (NativeSystemTask* nativeSystem : _nativeSystems)
+			{
+				nativeSystem->_registry = &registry;
+				nativeSystem->_deltaTime = deltaTime;
+
+				scheduler->AddTaskSetToPipe(nativeSystem);
+			}
+
+			for (NativeSystemTask* nativeSystem : _nativeSystems)
+			{
+				scheduler->WaitforTask(nativeSystem);
+			}
+
+			Singletons::EngineStats& engineStats = registry.ctx().at<Singletons::EngineStats>();
+			engineStats.AddNamedStat("Native Systems MS", static_cast<f32>(timer.GetLifeTime() * 1000.0));
+		}
+
+		Systems::UpdateScripts::Finish(registry);
+
+		// Everything sent this frame goes out together
+		Systems::NetworkConnection::Flush(registry);
+	}
+
+	void Scheduler::Shutdown(entt::registry& registry)
+	{
+		Systems::NetworkConnection::Shutdown(registry);
+
+		for (NativeSystemTask* nativeSystem : _nativeSystems)
+		{
+			delete nativeSystem;
+		}
+		_nativeSystems.clear();
+	}
+
+	void Scheduler::AddNativeSystem(const SystemAccess& access, NativeSystemTask::UpdateFunc update)
+	{
+		NativeSystemTask* nativeSystem = new NativeSystemTask(access, update);
+
+		// Systems added earlier keep running first when they touch the same data
+		for (NativeSystemTask* other : _nativeSystems)
+		{
+			if (other->_access.ConflictsWith(access))
+			{
+				nativeSystem->_dependencies.push_back(other);
+			}
+		}
+
+		_nativeSystems.push_back(nativeSystem);
 	}
 }
\ No newline at end of file
@@ -1,10 +1,38 @@
 #pragma once
+#include "Game/ECS/SystemAccess.h"
+
 #include <Base/Types.h>
 
+#include <enkiTS/TaskScheduler.h>
 #include <entt/fwd.hpp>
 
+#include <vector>
+
 namespace ECS
 {
+	// Runs a native system on the task scheduler. It first waits for the script systems and the native systems before it
+	// that conflict with its access, everything else it overlaps with
+	class NativeSystemTask : public enki::ITaskSet
+	{
+	public:
+		using UpdateFunc = void(*)(entt::registry& registry, f32 deltaTime);
+
+		NativeSystemTask(const SystemAccess& access, UpdateFunc update);
+
+		void ExecuteRange(enki::TaskSetPartition range, u32 threadNum) override;
+
+	private:
+		friend class Scheduler;
+
+		SystemAccess _access;
+		UpdateFunc _update;
+
+		entt::registry* _registry = nullptr;
+		f32 _deltaTime = 0.0f;
+
+		std::vector<NativeSystemTask*> _dependencies;
+	};
+
 	class Scheduler
 	{
 	public:
@@ -12,7 +40,12 @@ namespace ECS
 
 		void Init(entt::registry & registry);
 		void Update(entt::registry& registry, f32 deltaTime);
+		void Shutdown(entt::registry& registry);
+
+	private:
+		void AddNativeSystem(const SystemAccess& access, NativeSystemTask::UpdateFunc update);
 
 	private:
+		std::vector<NativeSystemTask*> _nativeSystems;
 	};
-}
\ No newline at end of file
+}
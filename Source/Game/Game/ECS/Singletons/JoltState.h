@@ -1,6 +1,10 @@
 #pragma once
 #include "Game/Application/EnttRegistries.h"
 #include "Game/ECS/Singletons/JoltState.h"
+#include "Game/Physics/BodyPool.h"
+#include "Game/Physics/GrowingTempAllocator.h"
+#include "Game/Physics/SceneQuery.h"
+#include "Game/Physics/ShapeCache.h"
 #include "Game/Util/ServiceLocator.h"
 
 #include <Base/Types.h>
@@ -15,18 +19,11 @@
 
 #include <entt/entt.hpp>
 
+#include <mutex>
 #include <thread>
 
 namespace Jolt
 {
-	namespace Settings
-	{
-		static constexpr u32 maxBodies = 4096;
-		static constexpr u32 numBodyMutexes = 0;
-		static constexpr u32 maxBodyPairs = 4096;
-		static constexpr u32 maxContactConstraints = 16384;
-	}
-
 	namespace Layers
 	{
 		static constexpr u8 NON_MOVING = 0;
@@ -142,6 +139,13 @@ namespace Jolt
 		}
 	};
 
+	struct DeactivatedBody
+	{
+	public:
+		JPH::BodyID bodyID;
+		u64 userData; // What the body belonged to when it went to sleep, pooled bodies keep their ID when they are handed to someone else
+	};
+
 	class MyBodyActivationListener : public JPH::BodyActivationListener
 	{
 	public:
@@ -150,10 +154,25 @@ namespace Jolt
 			//DebugHandler::Print("A body got activated");
 		}
 
+		// Called from the physics job threads while stepping
 		virtual void OnBodyDeactivated(const JPH::BodyID& inBodyID, u64 inBodyUserData) override
 		{
-			//DebugHandler::Print("A body went to sleep");
+			std::scoped_lock lock(_mutex);
+			_deactivatedBodies.push_back({ inBodyID, inBodyUserData });
+		}
+
+		// Bodies that went to sleep since the last call, must not be called while the simulation is stepping
+		void ConsumeDeactivatedBodies(std::vector<DeactivatedBody>& bodies)
+		{
+			std::scoped_lock lock(_mutex);
+
+			bodies.clear();
+			bodies.swap(_deactivatedBodies);
 		}
+
+	private:
+		std::mutex _mutex;
+		std::vector<DeactivatedBody> _deactivatedBodies;
 	};
 };
 
@@ -162,10 +181,10 @@ namespace ECS::Singletons
 	struct JoltState
 	{
 	public:
-		JoltState() : allocator(1000u * 1024u * 1024u), scheduler(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1) { }
+		JoltState(size_t tempAllocatorInitialSize, size_t tempAllocatorMaxSize) : allocator(tempAllocatorInitialSize, tempAllocatorMaxSize), scheduler(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1) { }
 		
 		JPH::PhysicsSystem physicsSystem;
-		JPH::TempAllocatorImpl allocator;
+		Jolt::GrowingTempAllocator allocator;
 		JPH::JobSystemThreadPool scheduler;
 
 		Jolt::BPLayerInterfaceImpl broadPhaseLayerInterface;
@@ -174,6 +193,14 @@ namespace ECS::Singletons
 		Jolt::MyBodyActivationListener bodyActivationListener;
 		Jolt::MyContactListener contactListener;
 
+		Jolt::ShapeCache shapeCache;
+		Jolt::BodyPool bodyPool;
+		Jolt::SceneQuery sceneQuery;
+
 		JPH::BodyID floorID;
+
+		f32 accumulatedTime = 0.0f;
+		JPH::BodyIDVector activeBodyIDs;
+		std::vector<Jolt::DeactivatedBody> deactivatedBodies;
 	};
 }
\ No newline at end of file
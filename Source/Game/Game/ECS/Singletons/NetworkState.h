@@ -1,4 +1,7 @@
 #pragma once
+#include "Game/Network/NetworkIOThread.h"
+#include "Game/Network/PacketView.h"
+
 #include <memory>
 
 namespace Network
@@ -14,5 +17,11 @@ namespace ECS::Singletons
 	public:
 		std::unique_ptr<Network::Client> client;
 		std::unique_ptr<Network::PacketHandler> packetHandler;
+
+		// Owns the socket of the client once the connection has been started, packets are sent through it
+		std::unique_ptr<NetworkIOThread> ioThread;
+
+		// Inbound packets are dispatched through this, their payloads stay in the receive ring of the network thread
+		PacketView packetView;
 	};
 }
\ No newline at end of file
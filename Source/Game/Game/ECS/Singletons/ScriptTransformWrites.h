@@ -0,0 +1,29 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <entt/fwd.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace ECS::Singletons
+{
+	// Transforms written back by scripts through Entities.Commit and static placements to promote through Entities.Promote,
+	// applied by Scripting::EntityHandler::ApplyWrites once no script is running
+	struct ScriptTransformWrites
+	{
+	public:
+		struct Write
+		{
+		public:
+			entt::entity entity;
+			vec3 position;
+			quat rotation;
+			vec3 scale;
+		};
+
+		std::mutex mutex;
+		std::vector<Write> writes;
+		std::vector<u32> promotions;
+	};
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <Base/Types.h>
+
+namespace ECS
+{
+	// Data shared between systems, used to declare what a system reads and writes
+	namespace SystemResource
+	{
+		static constexpr u32 Transform = 1 << 0;
+		static constexpr u32 Model = 1 << 1;
+		static constexpr u32 AABB = 1 << 2;
+		static constexpr u32 Camera = 1 << 3;
+		static constexpr u32 Physics = 1 << 4;
+		static constexpr u32 DebugRender = 1 << 5;
+		static constexpr u32 Network = 1 << 6;
+	};
+
+	struct SystemAccess
+	{
+	public:
+		u32 reads = 0;
+		u32 writes = 0;
+
+		// Two systems can only run at the same time if neither writes something the other one reads or writes
+		bool ConflictsWith(const SystemAccess& other) const
+		{
+			return (writes & (other.reads | other.writes)) != 0 || (other.writes & reads) != 0;
+		}
+	};
+}
@@ -1,6 +1,8 @@
 #include "NetworkConnection.h"
 
+#include "Game/ECS/Singletons/EngineStats.h"
 #include "Game/ECS/Singletons/NetworkState.h"
+#include "Game/Network/NetworkIOThread.h"
 #include "Game/Util/ServiceLocator.h"
 
 #include <Base/CVarSystem/CVarSystem.h>
@@ -70,6 +72,10 @@ namespace ECS::Systems
                     DebugHandler::PrintError("Network : Failed to connect to ({0}, {1})", ipAddress, port);
                 }
             }
+
+            // The client belongs to the network thread from here on
+            networkState.ioThread = std::make_unique<NetworkIOThread>(networkState.client.get());
+            networkState.ioThread->Start();
 		}
 	}
 
@@ -78,9 +84,13 @@ namespace ECS::Systems
 		entt::registry::context& ctx = registry.ctx();
 
 		Singletons::NetworkState& networkState = ctx.at<Singletons::NetworkState>();
-		
+		if (!networkState.ioThread)
+			return;
+
+        NetworkIOThread* ioThread = networkState.ioThread.get();
+
         static bool wasConnected = false;
-        if (networkState.client->IsConnected())
+        if (ioThread->IsConnected())
         {
             if (!wasConnected)
             {
@@ -99,75 +109,63 @@ namespace ECS::Systems
             }
         }
 
-        Network::Socket::Result readResult = networkState.client->Read();
-		if (readResult == Network::Socket::Result::SUCCESS)
-		{
-            std::shared_ptr<Bytebuffer>& buffer = networkState.client->GetReadBuffer();
-            while (size_t activeSize = buffer->GetActiveSize())
+        // Packets were read and parsed on the network thread as they arrived, only the handlers run here
+        u32 numPackets = 0;
+        u64 totalLatencyNS = 0;
+
+        NetworkIOThread::InboundPacket inboundPacket;
+        while (ioThread->TryDequeue(inboundPacket))
+        {
+            totalLatencyNS += NetworkIOThread::GetTimeNS() - inboundPacket.receiveTimeNS;
+            ioThread->AddDispatchLatency(inboundPacket);
+            numPackets++;
+
+            // The payload is read straight out of the receive ring, handlers that keep it past returning copy it with PacketView::Copy
+            std::shared_ptr<Network::Packet>& packet = networkState.packetView.Set(inboundPacket.header, ioThread->GetPayload(inboundPacket));
+            bool result = networkState.packetHandler->CallHandler(Network::SOCKET_ID_INVALID, packet);
+
+            networkState.packetView.Reset();
+            ioThread->Release(inboundPacket);
+
+            if (!result)
             {
-                // We have received a partial header and need to read more
-                if (activeSize < sizeof(Network::Packet::Header))
-                {
-                    buffer->Normalize();
-                    break;
-                }
+                ioThread->Close();
+            }
+        }
 
-                Network::Packet::Header* header = reinterpret_cast<Network::Packet::Header*>(buffer->GetReadPointer());
+        Singletons::EngineStats& engineStats = ctx.at<Singletons::EngineStats>();
+        engineStats.AddNamedStat("Network Packets", static_cast<f32>(numPackets));
+        engineStats.AddNamedStat("Network Packet Allocations", static_cast<f32>(networkState.packetView.ConsumeNumAllocations()));
+        engineStats.AddNamedStat("Network Dispatch Latency MS", numPackets > 0 ? static_cast<f32>(static_cast<f64>(totalLatencyNS) / numPackets / 1000000.0) : 0.0f);
+	}
 
-                if (header->opcode == Network::Opcode::INVALID || header->opcode > Network::Opcode::MAX_COUNT)
-                {
-#ifdef NC_Debug
-                    DebugHandler::PrintError("Network : Received Invalid Opcode ({0}) from server", static_cast<std::underlying_type<Network::Opcode>::type>(header->opcode));
-#endif // NC_Debug
-                    networkState.client->Close();
-                    break;
-                }
+	void NetworkConnection::Flush(entt::registry& registry)
+	{
+		entt::registry::context& ctx = registry.ctx();
 
-                if (header->size > Network::DEFAULT_BUFFER_SIZE)
-                {
-#ifdef NC_Debug
-                    DebugHandler::PrintError("Network : Received Invalid Opcode Size ({0} : {1}) from server", static_cast<std::underlying_type<Network::Opcode>::type>(header->opcode), header->size);
-#endif // NC_Debug
-                    networkState.client->Close();
-                    break;
-                }
+		Singletons::NetworkState& networkState = ctx.at<Singletons::NetworkState>();
+		if (!networkState.ioThread)
+			return;
 
-                size_t receivedPayloadSize = activeSize - sizeof(Network::Packet::Header);
-                if (receivedPayloadSize < header->size)
-                {
-                    buffer->Normalize();
-                    break;
-                }
+		networkState.ioThread->Flush();
 
-                buffer->SkipRead(sizeof(Network::Packet::Header));
+		// Sends happen on the network thread, so these trail the frame that queued them by however long it takes to get to them
+		NetworkIOThread::SendStats sendStats = networkState.ioThread->ConsumeSendStats();
 
-                std::shared_ptr<Network::Packet> packet = Network::Packet::Borrow();
-                {
-                    // Header
-                    {
-                        packet->header = *header;
-                    }
-
-                    // Payload
-                    {
-                        if (packet->header.size)
-                        {
-                            packet->payload = Bytebuffer::Borrow<Network::DEFAULT_BUFFER_SIZE>();
-                            packet->payload->size = packet->header.size;
-                            packet->payload->writtenData = packet->header.size;
-                            std::memcpy(packet->payload->GetDataPointer(), buffer->GetReadPointer(), packet->header.size);
-
-                            // Skip Payload
-                            buffer->SkipRead(header->size);
-                        }
-                    }
-
-                    if (!networkState.packetHandler->CallHandler(Network::SOCKET_ID_INVALID, packet))
-                    {
-                        networkState.client->Close();
-                    }
-                }
-            }
-		}
+		Singletons::EngineStats& engineStats = ctx.at<Singletons::EngineStats>();
+		engineStats.AddNamedStat("Network Sends", static_cast<f32>(sendStats.numSends));
+		engineStats.AddNamedStat("Network Packets Sent", static_cast<f32>(sendStats.numPackets));
+		engineStats.AddNamedStat("Network Bytes Sent", static_cast<f32>(sendStats.numBytes));
+	}
+
+	void NetworkConnection::Shutdown(entt::registry& registry)
+	{
+		entt::registry::context& ctx = registry.ctx();
+
+		Singletons::NetworkState* networkState = ctx.find<Singletons::NetworkState>();
+		if (networkState == nullptr || !networkState->ioThread)
+			return;
+
+		networkState->ioThread->Stop();
 	}
 }
\ No newline at end of file
@@ -9,5 +9,9 @@ namespace ECS::Systems
 	public:
 		static void Init(entt::registry& registry);
 		static void Update(entt::registry& registry, f32 deltaTime);
+		static void Shutdown(entt::registry& registry);
+
+		// Sends everything queued during the frame as one batch, called once every other system ran
+		static void Flush(entt::registry& registry);
 	};
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include "Game/ECS/SystemAccess.h"
+
 #include <Base/Types.h>
 #include <entt/fwd.hpp>
 
@@ -7,6 +9,8 @@ namespace ECS::Systems
 	class UpdateAABBs
 	{
 	public:
+		static constexpr SystemAccess Access = { SystemResource::Transform | SystemResource::AABB, SystemResource::AABB };
+
 		static void Update(entt::registry& registry, f32 deltaTime);
 	};
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 #include <Game/ECS/Components/DebugRenderTransform.h>
 #include "Game/ECS/Components/DynamicMesh.h"
 #include "Game/ECS/Components/KinematicMesh.h"
+#include "Game/ECS/Components/Rigidbody.h"
 #include "Game/ECS/Components/Transform.h"
 #include "Game/ECS/Components/StaticMesh.h"
+#include "Game/ECS/Singletons/EngineStats.h"
 #include "Game/ECS/Singletons/JoltState.h"
 #include "Game/ECS/Singletons/ActiveCamera.h"
 #include "Game/Rendering/GameRenderer.h"
@@ -12,11 +14,14 @@
 #include "Game/Util/ServiceLocator.h"
 
 #include <Base/Util/DebugHandler.h>
+#include <Base/Util/Timer.h>
+#include <Base/CVarSystem/CVarSystem.h>
 
 #include <Input/KeybindGroup.h>
 #include <Input/InputManager.h>
 
 #include <entt/entt.hpp>
+#include <tracy/Tracy.hpp>
 
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
@@ -25,103 +30,176 @@
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
-#include <Jolt/Physics/Collision/Shape/BoxShape.h>
 
 using namespace JPH::literals;
 
+AutoCVar_Float CVAR_PhysicsFixedTimeStep("physics.fixedTimeStep", "the duration of a single physics step in seconds", 1.0f / 60.0f);
+AutoCVar_Int CVAR_PhysicsMaxBodies("physics.maxBodies", "the maximum number of bodies the physics world can hold, read on init", 65536);
+AutoCVar_Int CVAR_PhysicsNumBodyMutexes("physics.numBodyMutexes", "the number of mutexes protecting the bodies, 0 lets Jolt pick, read on init", 0);
+AutoCVar_Int CVAR_PhysicsMaxBodyPairs("physics.maxBodyPairs", "the maximum number of body pairs the broadphase can queue per step, read on init", 65536);
+AutoCVar_Int CVAR_PhysicsMaxContactConstraints("physics.maxContactConstraints", "the maximum number of contact constraints per step, read on init", 16384);
+AutoCVar_Int CVAR_PhysicsTempAllocatorInitialSizeMB("physics.tempAllocatorInitialSizeMB", "the initial size of the physics temp allocator in MB, read on init", 8);
+AutoCVar_Int CVAR_PhysicsTempAllocatorMaxSizeMB("physics.tempAllocatorMaxSizeMB", "the size in MB the physics temp allocator may grow to before it keeps falling back to the heap", 256);
+AutoCVar_Int CVAR_PhysicsMaxStepsPerFrame("physics.maxStepsPerFrame", "the maximum number of physics steps we will run in a frame to catch up, remaining time is dropped", 4);
+
 namespace ECS::Systems
 {
-	void OnStaticMeshCreated(entt::registry& registry, entt::entity entity)
+	void AddRigidbody(entt::registry& registry, entt::entity entity, JPH::EMotionType motionType, JPH::ObjectLayer objectLayer)
 	{
 		entt::registry::context& ctx = registry.ctx();
 		auto& joltState = ctx.at<Singletons::JoltState>();
-		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
 
-		// Create Body
-		{
-			auto& transform = registry.get<ECS::Components::Transform>(entity);
+		auto& transform = registry.get<ECS::Components::Transform>(entity);
 
-			JPH::BoxShapeSettings shapeSetting(JPH::Vec3(transform.scale.x * 0.5f, transform.scale.y * 0.5f, transform.scale.z * 0.5f));
+		// Shapes are shared between all bodies with the same dimensions
+		vec3 halfExtents = transform.scale * 0.5f;
+		JPH::ShapeRefC shape = joltState.shapeCache.GetBox(halfExtents);
+		if (shape == nullptr)
+			return;
 
-			// Create the shape
-			JPH::ShapeSettings::ShapeResult shapeResult = shapeSetting.Create();
-			JPH::ShapeRefC shape = shapeResult.Get(); // We don't expect an error here, but you can check floor_shape_result for HasError() / GetError()
+		// Create the settings for the body itself. Note that here you can also set other properties like the restitution / friction.
+		JPH::BodyCreationSettings bodySettings(shape, JPH::RVec3(transform.position.x, transform.position.y, transform.position.z), JPH::Quat::sIdentity(), motionType, objectLayer);
+		bodySettings.mUserData = JPH::uint64(entt::to_integral(entity));
 
-			// Create the settings for the body itself. Note that here you can also set other properties like the restitution / friction.
-			JPH::BodyCreationSettings bodySettings(shape, JPH::RVec3(transform.position.x, transform.position.y, transform.position.z), JPH::Quat::sIdentity(), JPH::EMotionType::Static, Jolt::Layers::NON_MOVING);
+		if (motionType == JPH::EMotionType::Dynamic)
+		{
+			bodySettings.mAngularDamping = 0.8f;
+		}
 
-			// Create the actual rigid body
-			JPH::Body* body = bodyInterface.CreateBody(bodySettings); // Note that if we run out of bodies this can return nullptr
+		// The pool hands us a recycled body if it has one, it gets added to the world in a batch before the next step
+		JPH::BodyID bodyID = joltState.bodyPool.Acquire(bodySettings);
+		if (bodyID.IsInvalid())
+			return;
 
-			body->SetUserData(JPH::uint64(entt::to_integral(entity)));
+		auto& rigidbody = registry.emplace<ECS::Components::Rigidbody>(entity);
+		rigidbody.bodyID = bodyID.GetIndexAndSequenceNumber();
+		rigidbody.previousPosition = transform.position;
+		rigidbody.currentPosition = transform.position;
+	}
 
-			// Add it to the world
-			JPH::BodyID bodyID = body->GetID();
-			bodyInterface.AddBody(bodyID, JPH::EActivation::DontActivate);
-		}
+	void OnStaticMeshCreated(entt::registry& registry, entt::entity entity)
+	{
+		AddRigidbody(registry, entity, JPH::EMotionType::Static, Jolt::Layers::NON_MOVING);
 	}
 
 	void OnKinematicMeshCreated(entt::registry& registry, entt::entity entity)
 	{
-		entt::registry::context& ctx = registry.ctx();
-		auto& joltState = ctx.at<Singletons::JoltState>();
-		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+		AddRigidbody(registry, entity, JPH::EMotionType::Kinematic, Jolt::Layers::MOVING);
+	}
 
-		// Create Body
-		{
-			auto& transform = registry.get<ECS::Components::Transform>(entity);
+	void OnDynamicMeshCreated(entt::registry& registry, entt::entity entity)
+	{
+		AddRigidbody(registry, entity, JPH::EMotionType::Dynamic, Jolt::Layers::MOVING);
+	}
 
-			JPH::BoxShapeSettings shapeSetting(JPH::Vec3(transform.scale.x * 0.5f, transform.scale.y * 0.5f, transform.scale.z * 0.5f));
+	void OnRigidbodyDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		auto& joltState = registry.ctx().at<Singletons::JoltState>();
+		auto& rigidbody = registry.get<ECS::Components::Rigidbody>(entity);
 
-			// Create the shape
-			JPH::ShapeSettings::ShapeResult shapeResult = shapeSetting.Create();
-			JPH::ShapeRefC shape = shapeResult.Get(); // We don't expect an error here, but you can check floor_shape_result for HasError() / GetError()
+		if (rigidbody.bodyID == Components::Rigidbody::InvalidBodyID)
+			return;
 
-			// Create the settings for the body itself. Note that here you can also set other properties like the restitution / friction.
-			JPH::BodyCreationSettings bodySettings(shape, JPH::RVec3(transform.position.x, transform.position.y, transform.position.z), JPH::Quat::sIdentity(), JPH::EMotionType::Kinematic, Jolt::Layers::MOVING);
+		joltState.bodyPool.Release(JPH::BodyID(rigidbody.bodyID));
+	}
 
-			// Create the actual rigid body
-			JPH::Body* body = bodyInterface.CreateBody(bodySettings); // Note that if we run out of bodies this can return nullptr
+	template <typename Func>
+	void ForEachActiveRigidbody(entt::registry& registry, Singletons::JoltState& joltState, Func&& func)
+	{
+		// Only bodies that are awake can have moved, so we never need to look at the rest
+		joltState.physicsSystem.GetActiveBodies(joltState.activeBodyIDs);
+
+		// The simulation is done stepping, so nothing else touches the bodies and we can skip taking a lock per body
+		const JPH::BodyLockInterfaceNoLock& bodyLockInterface = joltState.physicsSystem.GetBodyLockInterfaceNoLock();
+		auto& rigidbodyStorage = registry.storage<Components::Rigidbody>();
 
-			body->SetUserData(JPH::uint64(entt::to_integral(entity)));
+		for (JPH::BodyID bodyID : joltState.activeBodyIDs)
+		{
+			const JPH::Body* body = bodyLockInterface.TryGetBody(bodyID);
+			if (body == nullptr)
+				continue;
 
-			// Add it to the world
-			JPH::BodyID bodyID = body->GetID();
-			bodyInterface.AddBody(bodyID, JPH::EActivation::Activate);
+			// Released bodies have their user data cleared by the pool, so one waiting for reuse doesn't resolve to the entity it belonged to
+			entt::entity entity = static_cast<entt::entity>(static_cast<u32>(body->GetUserData()));
+			if (!rigidbodyStorage.contains(entity))
+				continue;
+
+			func(entity, *body, rigidbodyStorage.get(entity));
 		}
 	}
 
-	void OnDynamicMeshCreated(entt::registry& registry, entt::entity entity)
+	void CaptureBodyStates(entt::registry& registry, Singletons::JoltState& joltState)
 	{
-		auto& activeCamera = registry.ctx().at<ECS::Singletons::ActiveCamera>();
-		auto& cameraTransform = registry.get<ECS::Components::Transform>(activeCamera.entity);
+		ZoneScoped;
 
-		entt::registry::context& ctx = registry.ctx();
-		auto& joltState = ctx.at<Singletons::JoltState>();
-		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+		ForEachActiveRigidbody(registry, joltState, [&](entt::entity entity, const JPH::Body& body, Components::Rigidbody& rigidbody)
+		{
+			JPH::RVec3 bodyPos = body.GetPosition();
+			JPH::Quat bodyRot = body.GetRotation();
 
-		// Create Body
+			rigidbody.previousPosition = rigidbody.currentPosition;
+			rigidbody.previousRotation = rigidbody.currentRotation;
+			rigidbody.currentPosition = vec3(bodyPos.GetX(), bodyPos.GetY(), bodyPos.GetZ());
+			rigidbody.currentRotation = quat(bodyRot.GetW(), bodyRot.GetX(), bodyRot.GetY(), bodyRot.GetZ());
+		});
+	}
+
+	void UpdatePhysics::SyncToECS(entt::registry& registry, Singletons::JoltState& joltState, f32 alpha)
+	{
+		ZoneScoped;
+
+		auto& transformStorage = registry.storage<Components::Transform>();
+
+		ForEachActiveRigidbody(registry, joltState, [&](entt::entity entity, const JPH::Body& body, Components::Rigidbody& rigidbody)
 		{
-			auto& transform = registry.get<ECS::Components::Transform>(entity);
+			if (!transformStorage.contains(entity))
+				return;
+
+			auto& transform = transformStorage.get(entity);
+			transform.position = glm::mix(rigidbody.previousPosition, rigidbody.currentPosition, alpha);
+			transform.rotation = glm::slerp(rigidbody.previousRotation, rigidbody.currentRotation, alpha);
+			transform.isDirty = true;
+
+			registry.get_or_emplace<Components::DirtyTransform>(entity);
+		});
+
+		// Sleeping bodies are no longer in the active list, so the pose they came to rest in is written once here without blending
+		joltState.bodyActivationListener.ConsumeDeactivatedBodies(joltState.deactivatedBodies);
+
+		const JPH::BodyLockInterfaceNoLock& bodyLockInterface = joltState.physicsSystem.GetBodyLockInterfaceNoLock();
+		auto& rigidbodyStorage = registry.storage<Components::Rigidbody>();
+
+		for (const Jolt::DeactivatedBody& deactivatedBody : joltState.deactivatedBodies)
+		{
+			// Bodies that woke up again in the same update were just synced above
+			const JPH::Body* body = bodyLockInterface.TryGetBody(deactivatedBody.bodyID);
+			if (body == nullptr || body->IsActive())
+				continue;
+
+			// The pool hands out bodies with the same ID again, one that was released or given to another entity since it went to sleep has a different owner now
+			if (body->GetUserData() != deactivatedBody.userData)
+				continue;
 
-			JPH::BoxShapeSettings shapeSetting(JPH::Vec3(transform.scale.x * 0.5f, transform.scale.y * 0.5f, transform.scale.z * 0.5f));
+			entt::entity entity = static_cast<entt::entity>(static_cast<u32>(deactivatedBody.userData));
+			if (!rigidbodyStorage.contains(entity) || !transformStorage.contains(entity))
+				continue;
 
-			// Create the shape
-			JPH::ShapeSettings::ShapeResult shapeResult = shapeSetting.Create();
-			JPH::ShapeRefC shape = shapeResult.Get(); // We don't expect an error here, but you can check floor_shape_result for HasError() / GetError()
+			Components::Rigidbody& rigidbody = rigidbodyStorage.get(entity);
 
-			// Create the settings for the body itself. Note that here you can also set other properties like the restitution / friction.
-			JPH::BodyCreationSettings bodySettings(shape, JPH::RVec3(transform.position.x, transform.position.y, transform.position.z), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Jolt::Layers::MOVING);
+			JPH::RVec3 bodyPos = body->GetPosition();
+			JPH::Quat bodyRot = body->GetRotation();
 
-			// Create the actual rigid body
-			JPH::Body* body = bodyInterface.CreateBody(bodySettings); // Note that if we run out of bodies this can return nullptr
-			body->GetMotionProperties()->SetAngularDamping(0.8f);
+			rigidbody.currentPosition = vec3(bodyPos.GetX(), bodyPos.GetY(), bodyPos.GetZ());
+			rigidbody.currentRotation = quat(bodyRot.GetW(), bodyRot.GetX(), bodyRot.GetY(), bodyRot.GetZ());
+			rigidbody.previousPosition = rigidbody.currentPosition;
+			rigidbody.previousRotation = rigidbody.currentRotation;
 
-			body->SetUserData(JPH::uint64(entt::to_integral(entity)));
+			auto& transform = transformStorage.get(entity);
+			transform.position = rigidbody.currentPosition;
+			transform.rotation = rigidbody.currentRotation;
+			transform.isDirty = true;
 
-			// Add it to the world
-			JPH::BodyID bodyID = body->GetID();
-			bodyInterface.AddBody(bodyID, JPH::EActivation::Activate);
+			registry.get_or_emplace<Components::DirtyTransform>(entity);
 		}
 	}
 
@@ -134,11 +212,21 @@ namespace ECS::Systems
 		JPH::RegisterTypes();
 
 		// We must initialize Jolt before creating the JoltState Singleton as it depends on Jolt
-        auto& joltState = ctx.emplace<Singletons::JoltState>();
+		size_t tempAllocatorInitialSize = static_cast<size_t>(glm::max(CVAR_PhysicsTempAllocatorInitialSizeMB.Get(), 1)) * 1024 * 1024;
+		size_t tempAllocatorMaxSize = static_cast<size_t>(glm::max(CVAR_PhysicsTempAllocatorMaxSizeMB.Get(), 1)) * 1024 * 1024;
+        auto& joltState = ctx.emplace<Singletons::JoltState>(tempAllocatorInitialSize, tempAllocatorMaxSize);
 
-		joltState.physicsSystem.Init(Jolt::Settings::maxBodies, Jolt::Settings::numBodyMutexes, Jolt::Settings::maxBodyPairs, Jolt::Settings::maxContactConstraints, joltState.broadPhaseLayerInterface, joltState.objectVSBroadPhaseLayerFilter, joltState.objectVSObjectLayerFilter);
+		u32 maxBodies = static_cast<u32>(glm::max(CVAR_PhysicsMaxBodies.Get(), 1));
+		u32 numBodyMutexes = static_cast<u32>(glm::max(CVAR_PhysicsNumBodyMutexes.Get(), 0));
+		u32 maxBodyPairs = static_cast<u32>(glm::max(CVAR_PhysicsMaxBodyPairs.Get(), 1));
+		u32 maxContactConstraints = static_cast<u32>(glm::max(CVAR_PhysicsMaxContactConstraints.Get(), 1));
+
+		joltState.physicsSystem.Init(maxBodies, numBodyMutexes, maxBodyPairs, maxContactConstraints, joltState.broadPhaseLayerInterface, joltState.objectVSBroadPhaseLayerFilter, joltState.objectVSObjectLayerFilter);
+		DebugHandler::Print("Physics : Initialized with {0} max bodies, {1} max body pairs, {2} max contact constraints and a {3} MB temp allocator", maxBodies, maxBodyPairs, maxContactConstraints, tempAllocatorInitialSize / (1024 * 1024));
 		joltState.physicsSystem.SetBodyActivationListener(&joltState.bodyActivationListener);
 		joltState.physicsSystem.SetContactListener(&joltState.contactListener);
+		joltState.bodyPool.Init(&joltState.physicsSystem);
+		joltState.sceneQuery.Init(&joltState.physicsSystem);
 
 		// Setup StaticMesh Sink
 		{
@@ -158,6 +246,12 @@ namespace ECS::Systems
 			sink.connect<&OnDynamicMeshCreated>();
 		}
 
+		// Setup Rigidbody Sink
+		{
+			auto& sink = registry.on_destroy<Components::Rigidbody>();
+			sink.connect<&OnRigidbodyDestroyed>();
+		}
+
 		InputManager* inputManager = ServiceLocator::GetGameRenderer()->GetInputManager();
 		KeybindGroup* keybindGroup = inputManager->GetKeybindGroupByHash("Debug"_h);
 		keybindGroup->AddKeyboardCallback("Spawn Physics OBB", GLFW_KEY_G, KeybindAction::Press, KeybindModifier::None, [&](i32 key, KeybindAction action, KeybindModifier modifier)
@@ -196,48 +290,72 @@ namespace ECS::Systems
 		GameRenderer* gameRenderer = ServiceLocator::GetGameRenderer();
 		DebugRenderer* debugRenderer = gameRenderer->GetDebugRenderer();
 
-		// Step the world
+		// Insert and remove the bodies spawned and despawned since the last update in one batch
+		joltState.bodyPool.Flush();
+
+		// Step the world with a fixed timestep
+		Timer timer;
+
+		f32 fixedTimeStep = glm::max(static_cast<f32>(CVAR_PhysicsFixedTimeStep.GetFloat()), 0.001f);
+		u32 maxStepsPerFrame = static_cast<u32>(glm::max(CVAR_PhysicsMaxStepsPerFrame.Get(), 1));
+
+		joltState.accumulatedTime += deltaTime;
+
+		u32 numSteps = 0;
+		while (joltState.accumulatedTime >= fixedTimeStep && numSteps < maxStepsPerFrame)
 		{
+			constexpr i32 collisionSteps = 1;
 			constexpr i32 integrationSubSteps = 1;
-			constexpr f32 minTimePerStep = 1 / 60.0f;
-			const i32 collisionSteps = static_cast<i32>(glm::ceil(deltaTime / minTimePerStep));
+			joltState.physicsSystem.Update(fixedTimeStep, collisionSteps, integrationSubSteps, &joltState.allocator, &joltState.scheduler);
+
+			CaptureBodyStates(registry, joltState);
 
-			joltState.physicsSystem.Update(deltaTime, collisionSteps, integrationSubSteps, &joltState.allocator, &joltState.scheduler);
+			joltState.accumulatedTime -= fixedTimeStep;
+			numSteps++;
 		}
 
-		// Update ECS with new Physics State
+		// If we couldn't catch up within our budget we drop the remaining time instead of trying to make it up next frame
+		u32 numDroppedSteps = 0;
+		if (joltState.accumulatedTime >= fixedTimeStep)
 		{
-			JPH::BodyIDVector activeBodyIDs;
-			joltState.physicsSystem.GetActiveBodies(activeBodyIDs);
-
-			if (activeBodyIDs.size() > 0)
-			{
-				JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
-
-				for (u32 i = 0; i < activeBodyIDs.size(); i++)
-				{
-					JPH::BodyID bodyID = activeBodyIDs[i];
-
-					u32 userData = static_cast<u32>(bodyInterface.GetUserData(bodyID));
-					entt::entity entityID = static_cast<entt::entity>(userData);
-
-					bool needsPhysicsWriteToECS = registry.any_of<Components::StaticMesh, Components::KinematicMesh, Components::DynamicMesh>(entityID);
-					if (needsPhysicsWriteToECS)
-					{
-						auto& transform = registry.get<ECS::Components::Transform>(entityID);
-
-						JPH::Vec3 bodyPos;
-						JPH::Quat bodyRot;
-						bodyInterface.GetPositionAndRotation(bodyID, bodyPos, bodyRot);
-						
-						vec3 newPosition = vec3(bodyPos.GetX(), bodyPos.GetY(), bodyPos.GetZ());
-						quat newRotation = glm::quat(bodyRot.GetW(), bodyRot.GetX(), bodyRot.GetY(), bodyRot.GetZ());
-
-						transform.position = newPosition;
-						transform.rotation = newRotation;
-					}
-				}
-			}
+			numDroppedSteps = static_cast<u32>(joltState.accumulatedTime / fixedTimeStep);
+			joltState.accumulatedTime -= numDroppedSteps * fixedTimeStep;
 		}
+
+		f32 stepTimeMS = timer.GetLifeTime() * 1000.0f;
+
+		joltState.allocator.EndUpdate();
+
+		auto& engineStats = ctx.at<Singletons::EngineStats>();
+		engineStats.AddNamedStat("Physics Step MS", stepTimeMS);
+		engineStats.AddNamedStat("Physics Steps", static_cast<f32>(numSteps));
+		engineStats.AddNamedStat("Physics Dropped Steps", static_cast<f32>(numDroppedSteps));
+		engineStats.AddNamedStat("Physics Bodies", static_cast<f32>(joltState.physicsSystem.GetNumBodies()));
+		engineStats.AddNamedStat("Physics Max Bodies", static_cast<f32>(joltState.physicsSystem.GetMaxBodies()));
+
+		Jolt::BodyPool::Stats bodyPoolStats = joltState.bodyPool.ConsumeStats();
+		engineStats.AddNamedStat("Physics Bodies Created", static_cast<f32>(bodyPoolStats.numCreated));
+		engineStats.AddNamedStat("Physics Bodies Reused", static_cast<f32>(bodyPoolStats.numReused));
+		engineStats.AddNamedStat("Physics Pooled Bodies", static_cast<f32>(joltState.bodyPool.GetNumPooledBodies()));
+		engineStats.AddNamedStat("Physics Cached Shapes", static_cast<f32>(joltState.shapeCache.GetNumShapes()));
+
+		// Queries made since the last update, mostly from scripts which run after physics
+		Jolt::SceneQuery::Stats sceneQueryStats = joltState.sceneQuery.ConsumeStats();
+		engineStats.AddNamedStat("Physics Query Rays", static_cast<f32>(sceneQueryStats.numRays));
+		engineStats.AddNamedStat("Physics Query Overlaps", static_cast<f32>(sceneQueryStats.numOverlaps));
+		engineStats.AddNamedStat("Physics Query MS", sceneQueryStats.timeMS);
+		engineStats.AddNamedStat("Physics Temp Peak KB", static_cast<f32>(joltState.allocator.GetUpdatePeak()) / 1024.0f);
+		engineStats.AddNamedStat("Physics Temp High Water KB", static_cast<f32>(joltState.allocator.GetHighWaterMark()) / 1024.0f);
+		engineStats.AddNamedStat("Physics Temp Capacity KB", static_cast<f32>(joltState.allocator.GetCapacity()) / 1024.0f);
+		engineStats.AddNamedStat("Physics Temp Overflows", static_cast<f32>(joltState.allocator.GetNumOverflowAllocations()));
+
+		// Update ECS with the Physics State interpolated between the last two steps
+		f32 alpha = joltState.accumulatedTime / fixedTimeStep;
+
+		timer.Reset();
+		SyncToECS(registry, joltState, alpha);
+
+		engineStats.AddNamedStat("Physics Sync MS", timer.GetLifeTime() * 1000.0f);
+		engineStats.AddNamedStat("Physics Active Bodies", static_cast<f32>(joltState.activeBodyIDs.size()));
 	}
 }
\ No newline at end of file
@@ -2,6 +2,11 @@
 #include <Base/Types.h>
 #include <entt/fwd.hpp>
 
+namespace ECS::Singletons
+{
+	struct JoltState;
+}
+
 namespace ECS::Systems
 {
 	class UpdatePhysics
@@ -9,5 +14,9 @@ namespace ECS::Systems
 	public:
 		static void Init(entt::registry& registry);
 		static void Update(entt::registry& registry, f32 deltaTime);
+
+		// Writes the state of every active body, interpolated by alpha between the last two steps, and of every body that went to sleep
+		// since the last call to the Transform of its entity. Must not be called while the simulation is stepping.
+		static void SyncToECS(entt::registry& registry, Singletons::JoltState& joltState, f32 alpha);
 	};
 }
\ No newline at end of file
@@ -1,12 +1,27 @@
 #include "UpdateScripts.h"
 
+#include "Game/ECS/Components/Model.h"
+#include "Game/ECS/Components/Name.h"
+#include "Game/ECS/Components/Transform.h"
+#include "Game/ECS/Singletons/EngineStats.h"
+#include "Game/ECS/Singletons/ScriptTransformWrites.h"
 #include "Game/Scripting/LuaManager.h"
+#include "Game/Scripting/Handlers/EntityHandler.h"
 #include "Game/Util/ServiceLocator.h"
 
+#include <entt/entt.hpp>
+
 namespace ECS::Systems
 {
 	void UpdateScripts::Init(entt::registry& registry)
 	{
+		entt::registry::context& ctx = registry.ctx();
+		ctx.emplace<Singletons::ScriptTransformWrites>();
+
+		// Scripts query the registry from several threads at once, looking up a storage that doesn't exist yet would create it
+		registry.storage<Components::Transform>();
+		registry.storage<Components::Model>();
+		registry.storage<Components::Name>();
 	}
 
 	void UpdateScripts::Update(entt::registry& registry, f32 deltaTime)
@@ -14,4 +29,37 @@ namespace ECS::Systems
 		Scripting::LuaManager* luaManager = ServiceLocator::GetLuaManager();
 		luaManager->Update(deltaTime);
 	}
+
+	void UpdateScripts::WaitFor(entt::registry& registry, const SystemAccess& access)
+	{
+		Scripting::LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		luaManager->WaitForSystems(access);
+	}
+
+	void UpdateScripts::Finish(entt::registry& registry)
+	{
+		Scripting::LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		luaManager->WaitForSystems();
+
+		// Transforms committed by scripts are picked up by CalculateTransformMatrices next frame, the same as everything else written after it
+		Scripting::EntityHandler::ApplyWrites(registry);
+
+		Scripting::LuaMemoryStats memoryStats;
+		luaManager->ConsumeMemoryStats(memoryStats);
+
+		Scripting::LuaSystemStats systemStats;
+		luaManager->ConsumeSystemStats(systemStats);
+
+		auto& engineStats = registry.ctx().at<Singletons::EngineStats>();
+		engineStats.AddNamedStat("Script Heap KB", static_cast<f32>(memoryStats.heapBytes) / 1024.0f);
+		engineStats.AddNamedStat("Script Reserved KB", static_cast<f32>(memoryStats.reservedBytes) / 1024.0f);
+		engineStats.AddNamedStat("Script Allocations", static_cast<f32>(memoryStats.numAllocations));
+		engineStats.AddNamedStat("Script Failed Allocations", static_cast<f32>(memoryStats.numFailedAllocations));
+		engineStats.AddNamedStat("Script Full Collections", static_cast<f32>(memoryStats.numFullCollections));
+		engineStats.AddNamedStat("Script GC MS", static_cast<f32>(memoryStats.gcTimeMS));
+		engineStats.AddNamedStat("Script VM Creates", static_cast<f32>(memoryStats.numBasesCreated));
+		engineStats.AddNamedStat("Script VM Create MS", static_cast<f32>(memoryStats.baseCreateMS));
+		engineStats.AddNamedStat("Script Run MS", static_cast<f32>(systemStats.runTimeMS));
+		engineStats.AddNamedStat("Script Wait MS", static_cast<f32>(systemStats.waitTimeMS));
+	}
 }
\ No newline at end of file
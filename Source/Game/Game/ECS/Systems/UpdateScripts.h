@@ -1,4 +1,6 @@
 #pragma once
+#include "Game/ECS/SystemAccess.h"
+
 #include <Base/Types.h>
 #include <entt/fwd.hpp>
 
@@ -8,6 +10,11 @@ namespace ECS::Systems
 	{
 	public:
 		static void Init(entt::registry& registry);
+		// Launches the script systems, they keep running next to the native systems until Finish
 		static void Update(entt::registry& registry, f32 deltaTime);
+
+		// Call before running a native system next to the scripts, waits for the script systems that conflict with it
+		static void WaitFor(entt::registry& registry, const SystemAccess& access);
+		static void Finish(entt::registry& registry);
 	};
 }
\ No newline at end of file
@@ -75,4 +75,12 @@ namespace Editor
 		}
 	}
 
+	void ActionStackEditor::RemapInstanceIDs(const std::vector<u32>& oldToNewInstanceID)
+	{
+		for (BaseAction* action : _actionStack)
+		{
+			action->RemapInstanceIDs(oldToNewInstanceID);
+		}
+	}
+
 }
\ No newline at end of file
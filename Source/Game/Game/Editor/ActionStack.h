@@ -1,6 +1,7 @@
 #pragma once
 #include "BaseEditor.h"
 #include <deque>
+#include <vector>
 
 namespace Editor
 {
@@ -12,6 +13,9 @@ namespace Editor
 		virtual void Undo() = 0;
 		virtual void Draw() = 0;
 
+		// Called when ModelLoader sorted the instances, actions that refer to an InstanceID have to update it
+		virtual void RemapInstanceIDs(const std::vector<u32>& oldToNewInstanceID) { }
+
 		bool isOpen;
 	};
 
@@ -26,6 +30,7 @@ namespace Editor
 		virtual void DrawImGui() override;
 
 		void AddAction(BaseAction* action);
+		void RemapInstanceIDs(const std::vector<u32>& oldToNewInstanceID);
 
 	private:
 		u32 _maxSize = 0;
@@ -86,7 +86,7 @@ namespace Editor
 					}
 
 					u32 i = entt::to_integral(entity);
-					if (ImGui::TreeNodeEx((void*)(intptr_t)i, flags, "%s", name.name.c_str()))
+					if (ImGui::TreeNodeEx((void*)(intptr_t)i, flags, "%s", Util::StringInterner::Resolve(name.name).c_str()))
 					{
 						ImGui::TreePop();
 					}
@@ -66,10 +66,7 @@ namespace Editor
             GameRenderer* gameRenderer = ServiceLocator::GetGameRenderer();
             ModelRenderer* modelRenderer = gameRenderer->GetModelRenderer();
 
-            Renderer::GPUVector<mat4x4>& instances = modelRenderer->GetInstanceMatrices();
-
-            instances.Get()[_instanceID] = _preEditValue;
-            instances.SetDirtyElement(_instanceID);
+            modelRenderer->SetInstanceMatrix(_instanceID, _preEditValue);
         }
 
         virtual void Draw() override
@@ -95,6 +92,14 @@ namespace Editor
             ImGui::Unindent();
         }
 
+        virtual void RemapInstanceIDs(const std::vector<u32>& oldToNewInstanceID) override
+        {
+            if (_instanceID < oldToNewInstanceID.size())
+            {
+                _instanceID = oldToNewInstanceID[_instanceID];
+            }
+        }
+
     private:
         u32 _instanceID;
         mat4x4 _preEditValue;
@@ -278,7 +283,7 @@ namespace Editor
         ModelRenderer* modelRenderer = gameRenderer->GetModelRenderer();
 
         entt::entity selectedEntity;
-        if (modelLoader->GetEntityIDFromInstanceID(instanceID, selectedEntity))
+        if (modelLoader->GetOrPromoteEntityFromInstanceID(instanceID, selectedEntity))
         {
             _selectedEntity = selectedEntity;
             _hierarchy->SelectEntity(_selectedEntity);
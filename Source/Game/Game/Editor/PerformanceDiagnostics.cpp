@@ -9,6 +9,7 @@
 #include <Game/Rendering/Terrain/TerrainRenderer.h>
 #include <Game/Application/EnttRegistries.h>
 #include <Game/ECS/Singletons/EngineStats.h>
+#include <Game/Scripting/LuaProfiler.h>
 #include <Game/Util/ImguiUtil.h>
 
 #include <entt/entt.hpp>
@@ -56,6 +57,7 @@ namespace Editor
                     ImGui::Checkbox("Frame Times", &_showFrameTime);
                     ImGui::Checkbox("Render Pass", &_showRenderPass);
                     ImGui::Checkbox("Frame Graph", &_showFrameGraph);
+                    ImGui::Checkbox("Systems", &_showSystems);
 
                     ImGui::EndMenu();
                 }
@@ -85,7 +87,8 @@ namespace Editor
                 _showSurvivingTriangle,
                 _showFrameTime,
                 _showRenderPass,
-                _showFrameGraph
+                _showFrameGraph,
+                _showSystems
             };
 
             i32 howManySectionToDraw = 0;
@@ -138,6 +141,9 @@ namespace Editor
                         case 4:
                             DrawFrameTimesGraph(heightConstraint, stats);
                             break;
+                        case 5:
+                            DrawSystemStats(heightConstraint, stats, flags);
+                            break;
                         default:
                             break;
                         }
@@ -187,6 +193,9 @@ namespace Editor
                         case 4:
                             DrawFrameTimesGraph(heightConstraint, stats, widthConstraint);
                             break;
+                        case 5:
+                            DrawSystemStats(heightConstraint, stats, flags, widthConstraint);
+                            break;
                         default:
                             break;
                         }
@@ -208,7 +217,7 @@ namespace Editor
                 {
                     // fakeOrder is to calculate the real proportions if only half item in a row
                     // is showed, like that he can stretch horizontally, this is an easy fix
-                    std::vector<bool> fakeOrder = {false, false, false, false, true};
+                    std::vector<bool> fakeOrder = {false, false, false, false, true, _showSystems};
                     if (_showSurvivingTriangle || _showSurvivingDrawCalls)
                         fakeOrder[0] = true;
                     if (_showFrameTime || _showRenderPass)
@@ -248,6 +257,7 @@ namespace Editor
                     }
 
                     DrawFrameTimesGraph(newHeightProportions[4], stats);
+                    DrawSystemStats(newHeightProportions[5], stats, flags);
                 }
                 else // row display
                 {
@@ -266,6 +276,7 @@ namespace Editor
                     DrawFrameTimes(newHeightProportions[2], average, flags);
                     DrawRenderPass(newHeightProportions[3], renderer, stats, flags);
                     DrawFrameTimesGraph(newHeightProportions[4], stats);
+                    DrawSystemStats(newHeightProportions[5], stats, flags);
                 }
             }
         }
@@ -547,6 +558,132 @@ namespace Editor
         }
     }
 
+    struct SystemStatEntry
+    {
+        const char* label;
+        const char* statName;
+        const char* format;
+    };
+
+    // Functions listed under the system stats while the script profiler has samples
+    static constexpr u32 NUM_SCRIPT_PROFILE_FUNCTIONS = 15;
+
+    // Named stats pushed into EngineStats by the CPU side systems
+    static const SystemStatEntry systemStatEntries[] =
+    {
+        { "Instance Upload (KB)", "Instance Upload KB", "%.2f" },
+        { "Instance Upload Regions", "Instance Upload Regions", "%.0f" },
+        { "Instance Collect (ms / 10k)", "Instance Collect MS Per 10k", "%.3f" },
+        { "Physics Step (ms)", "Physics Step MS", "%.3f" },
+        { "Physics Steps", "Physics Steps", "%.2f" },
+        { "Physics Dropped Steps", "Physics Dropped Steps", "%.2f" },
+        { "Physics Sync (ms)", "Physics Sync MS", "%.3f" },
+        { "Physics Active Bodies", "Physics Active Bodies", "%.0f" },
+        { "Physics Bodies", "Physics Bodies", "%.0f" },
+        { "Physics Max Bodies", "Physics Max Bodies", "%.0f" },
+        { "Physics Bodies Created", "Physics Bodies Created", "%.2f" },
+        { "Physics Bodies Reused", "Physics Bodies Reused", "%.2f" },
+        { "Physics Pooled Bodies", "Physics Pooled Bodies", "%.0f" },
+        { "Physics Cached Shapes", "Physics Cached Shapes", "%.0f" },
+        { "Physics Query Rays", "Physics Query Rays", "%.0f" },
+        { "Physics Query Overlaps", "Physics Query Overlaps", "%.0f" },
+        { "Physics Query (ms)", "Physics Query MS", "%.3f" },
+        { "Chunk Collision Build (ms)", "Chunk Collision Build MS", "%.2f" },
+        { "Chunk Collision Bodies", "Chunk Collision Bodies", "%.0f" },
+        { "Chunk Collision Sub Shapes", "Chunk Collision Sub Shapes", "%.0f" },
+        { "Physics Temp Peak (KB)", "Physics Temp Peak KB", "%.1f" },
+        { "Physics Temp High Water (KB)", "Physics Temp High Water KB", "%.1f" },
+        { "Physics Temp Capacity (KB)", "Physics Temp Capacity KB", "%.1f" },
+        { "Physics Temp Overflows", "Physics Temp Overflows", "%.2f" },
+        { "Script Heap (KB)", "Script Heap KB", "%.1f" },
+        { "Script Reserved (KB)", "Script Reserved KB", "%.1f" },
+        { "Script Allocations", "Script Allocations", "%.0f" },
+        { "Script Failed Allocations", "Script Failed Allocations", "%.2f" },
+        { "Script Full Collections", "Script Full Collections", "%.2f" },
+        { "Script GC (ms)", "Script GC MS", "%.3f" },
+        { "Script VM Creates", "Script VM Creates", "%.2f" },
+        { "Script VM Create (ms)", "Script VM Create MS", "%.3f" },
+        { "Script Run (ms)", "Script Run MS", "%.3f" },
+        { "Script Wait (ms)", "Script Wait MS", "%.3f" },
+        { "Native Systems (ms)", "Native Systems MS", "%.3f" },
+        { "Network Packets", "Network Packets", "%.2f" },
+        { "Network Packet Allocations", "Network Packet Allocations", "%.2f" },
+        { "Network Dispatch Latency (ms)", "Network Dispatch Latency MS", "%.3f" },
+        { "Network Sends", "Network Sends", "%.2f" },
+        { "Network Packets Sent", "Network Packets Sent", "%.2f" },
+        { "Network Bytes Sent", "Network Bytes Sent", "%.0f" },
+    };
+
+    void PerformanceDiagnostics::DrawSystemStats(f32 constraint, ECS::Singletons::EngineStats& stats, const ImGuiTableFlags& flags, f32 widthConstraint)
+    {
+        if (!_showSystems)
+            return;
+
+        ImGui::SetNextWindowSizeConstraints(ImVec2(-1.f, -1.f), ImVec2(widthConstraint, constraint));
+        if (ImGui::BeginChild("##SystemStats", ImVec2(0, (constraint < 0.f) ? 0 : constraint), true, ImGuiWindowFlags_HorizontalScrollbar))
+        {
+            ImGui::Text("Systems (CPU)");
+            if (ImGui::BeginTable("systemstats", 2, flags))
+            {
+                for (const SystemStatEntry& entry : systemStatEntries)
+                {
+                    f32 average = 0.0f;
+                    if (stats.AverageNamed(entry.statName, 240, average))
+                    {
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%s", entry.label);
+                        ImGui::TableNextColumn();
+                        ImGui::Text(entry.format, average);
+                    }
+                }
+
+                ImGui::EndTable();
+            }
+
+            DrawScriptProfile(flags);
+
+            ImGui::EndChild();
+        }
+    }
+
+    void PerformanceDiagnostics::DrawScriptProfile(const ImGuiTableFlags& flags)
+    {
+        u64 numTicks = Scripting::LuaProfiler::GetNumTicks();
+        if (numTicks == 0)
+            return;
+
+        f64 tickDurationMS = Scripting::LuaProfiler::GetTickDurationMS();
+
+        static std::vector<const Scripting::LuaProfileFunction*> functions;
+        Scripting::LuaProfiler::GetTopFunctions(NUM_SCRIPT_PROFILE_FUNCTIONS, functions);
+
+        ImGui::Spacing();
+        ImGui::Text("Scripts (Sampled, %.1f ms%s)", static_cast<f64>(numTicks) * tickDurationMS, Scripting::LuaProfiler::IsRunning() ? "" : ", Stopped");
+
+        if (ImGui::BeginTable("scriptprofile", 3, flags))
+        {
+            ImGui::TableSetupColumn("Function");
+            ImGui::TableSetupColumn("Self (ms)");
+            ImGui::TableSetupColumn("Total (ms)");
+            ImGui::TableHeadersRow();
+
+            for (const Scripting::LuaProfileFunction* function : functions)
+            {
+                f64 selfMS = static_cast<f64>(function->selfTicks) * tickDurationMS;
+                f64 selfPercent = static_cast<f64>(function->selfTicks) / static_cast<f64>(numTicks) * 100.0;
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%s", function->name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f (%.1f%%)", selfMS, selfPercent);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<f64>(function->totalTicks) * tickDurationMS);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
     void PerformanceDiagnostics::DrawCullingDrawCallStatsView(u32 viewID, f32 textPos, u32& totalDrawCalls, u32& totalSurvivingDrawcalls)
     {
         GameRenderer* gameRenderer = ServiceLocator::GetGameRenderer();
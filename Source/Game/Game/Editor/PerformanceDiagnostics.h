@@ -43,6 +43,8 @@ namespace Editor
         void DrawFrameTimes(f32 constraint, const ECS::Singletons::FrameTimes& average, const ImGuiTableFlags& flags, f32 widthConstraint = -1.f);
         void DrawRenderPass(f32 constraint, Renderer::Renderer* renderer, ECS::Singletons::EngineStats& stats, const ImGuiTableFlags& flags, f32 widthConstraint = -1.f);
         void DrawFrameTimesGraph(f32 constraint, const ECS::Singletons::EngineStats& stats, f32 widthConstraint = -1.f);
+        void DrawSystemStats(f32 constraint, ECS::Singletons::EngineStats& stats, const ImGuiTableFlags& flags, f32 widthConstraint = -1.f);
+        void DrawScriptProfile(const ImGuiTableFlags& flags);
 
         f32 CalculateTotalParam(const std::vector<f32>& params, const std::vector<bool>& shownItems);
         std::vector<f32> CalculateProportions(const std::vector<f32>& params, const std::vector<bool>& shownItems);
@@ -56,9 +58,10 @@ namespace Editor
         bool _showFrameTime = true;
         bool _showRenderPass = true;
         bool _showFrameGraph = true;
+        bool _showSystems = true;
 
-        const std::vector<f32> _sectionParamHorizontal = {0.175f, 0.175f, 0.15f, 0.15f, 0.3f};
-        const std::vector<f32> _sectionParamVerticalMultiColumn = {0.25f, 0.25f, 0.25f, 0.25f, 0.35f};
-        const std::vector<f32> _sectionParamVertical = {0.18f, 0.18f, 0.162f, 0.18f, 0.30f};
+        const std::vector<f32> _sectionParamHorizontal = {0.15f, 0.15f, 0.125f, 0.125f, 0.25f, 0.2f};
+        const std::vector<f32> _sectionParamVerticalMultiColumn = {0.25f, 0.25f, 0.25f, 0.25f, 0.35f, 0.25f};
+        const std::vector<f32> _sectionParamVertical = {0.15f, 0.15f, 0.135f, 0.15f, 0.25f, 0.165f};
 	};
 }
\ No newline at end of file
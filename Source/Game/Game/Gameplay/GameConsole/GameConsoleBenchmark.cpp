@@ -0,0 +1,34 @@
+#include "GameConsoleBenchmark.h"
+#include "GameConsole.h"
+#include "Game/Scripting/LuaManager.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+u32 BenchmarkArgs::Next(u32 defaultValue, u32 minValue, u32 maxValue)
+{
+	u32 index = _index++;
+	if (index >= _subCommands.size())
+		return defaultValue;
+
+	const std::string& arg = _subCommands[index];
+
+	char* end = nullptr;
+	i64 value = std::strtoll(arg.c_str(), &end, 10);
+	if (end == arg.c_str())
+		return defaultValue;
+
+	return static_cast<u32>(std::clamp(value, static_cast<i64>(minValue), static_cast<i64>(maxValue)));
+}
+
+void GameConsoleBenchmark::Begin()
+{
+	// Commands run on the main thread, but a script system could still be finishing on a worker and most benchmarks use the same VMs and workers
+	ServiceLocator::GetLuaManager()->WaitForSystems();
+}
+
+void GameConsoleBenchmark::End(GameConsole* gameConsole, f64 seconds)
+{
+	gameConsole->Print("Finished in %.1f ms", seconds * 1000.0);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <Base/Types.h>
+#include <Base/Util/Timer.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+class GameConsole;
+
+// Numeric arguments of a benchmark command, read in order. Missing or unparsable ones keep their default, the rest is clamped to the range
+class BenchmarkArgs
+{
+public:
+	BenchmarkArgs(const std::vector<std::string>& subCommands, u32 firstIndex = 0) : _subCommands(subCommands), _index(firstIndex) { }
+
+	u32 Next(u32 defaultValue, u32 minValue = 1, u32 maxValue = std::numeric_limits<u32>().max());
+
+private:
+	const std::vector<std::string>& _subCommands;
+	u32 _index;
+};
+
+// The game has no headless target, so benchmarks run in game from the console and share the script VMs, the task scheduler and the
+// registries with it. Run joins any script system still in flight before calling run, which prints its own results, and prints how long
+// the whole benchmark took if run succeeded
+class GameConsoleBenchmark
+{
+public:
+	template <typename RunFunc>
+	static bool Run(GameConsole* gameConsole, RunFunc&& run)
+	{
+		Begin();
+
+		Timer timer;
+		bool result = run();
+
+		if (result)
+		{
+			End(gameConsole, timer.GetLifeTime());
+		}
+
+		return result;
+	}
+
+private:
+	static void Begin();
+	static void End(GameConsole* gameConsole, f64 seconds);
+};
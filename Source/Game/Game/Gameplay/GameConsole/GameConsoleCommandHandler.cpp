@@ -15,6 +15,19 @@ GameConsoleCommandHandler::GameConsoleCommandHandler()
     RegisterCommand("reload"_h, GameConsoleCommands::HandleReloadScripts);
     RegisterCommand("reloadscripts"_h, GameConsoleCommands::HandleReloadScripts);
     RegisterCommand("setcursor"_h, GameConsoleCommands::HandleSetCursor);
+    RegisterCommand("physicsbench"_h, GameConsoleCommands::HandlePhysicsBenchmark);
+    RegisterCommand("raybench"_h, GameConsoleCommands::HandleRaycastBenchmark);
+    RegisterCommand("chunkcollisionbench"_h, GameConsoleCommands::HandleChunkCollisionBenchmark);
+    RegisterCommand("luastatebench"_h, GameConsoleCommands::HandleLuaStateBenchmark);
+    RegisterCommand("luaeventbench"_h, GameConsoleCommands::HandleLuaEventBenchmark);
+    RegisterCommand("luanativebench"_h, GameConsoleCommands::HandleLuaNativeBenchmark);
+    RegisterCommand("luabindbench"_h, GameConsoleCommands::HandleLuaBindingBenchmark);
+    RegisterCommand("luaentitybench"_h, GameConsoleCommands::HandleLuaEntityBenchmark);
+    RegisterCommand("luataskbench"_h, GameConsoleCommands::HandleLuaTaskBenchmark);
+    RegisterCommand("netpacketbench"_h, GameConsoleCommands::HandleNetworkPacketBenchmark);
+    RegisterCommand("netsendbench"_h, GameConsoleCommands::HandleNetworkSendBenchmark);
+    RegisterCommand("netlatency"_h, GameConsoleCommands::HandleNetworkLatency);
+    RegisterCommand("luaprofile"_h, GameConsoleCommands::HandleLuaProfile);
 }
 
 bool GameConsoleCommandHandler::HandleCommand(GameConsole* gameConsole, std::string& command)
@@ -1,10 +1,29 @@
 #include "GameConsoleCommands.h"
 #include "GameConsole.h"
+#include "GameConsoleBenchmark.h"
 #include "Game/Application/EnttRegistries.h"
+#include "Game/ECS/Components/Transform.h"
+#include "Game/ECS/Singletons/ActiveCamera.h"
+#include "Game/ECS/Singletons/JoltState.h"
 #include "Game/ECS/Singletons/NetworkState.h"
+#include "Game/Network/NetworkPacketBenchmark.h"
+#include "Game/Network/NetworkSendBenchmark.h"
+#include "Game/Physics/ChunkCollisionBenchmark.h"
+#include "Game/Physics/RaycastBenchmark.h"
+#include "Game/Physics/SpawnBenchmark.h"
+#include "Game/Physics/SyncBenchmark.h"
+#include "Game/Scripting/LuaBindingBenchmark.h"
+#include "Game/Scripting/LuaEntityBenchmark.h"
+#include "Game/Scripting/LuaEventBenchmark.h"
 #include "Game/Scripting/LuaManager.h"
+#include "Game/Scripting/LuaNativeBenchmark.h"
+#include "Game/Scripting/LuaProfiler.h"
+#include "Game/Scripting/LuaStateBenchmark.h"
+#include "Game/Scripting/LuaProfilerBenchmark.h"
+#include "Game/Scripting/LuaTaskBenchmark.h"
 #include "Game/Util/ServiceLocator.h"
 #include "Game/Rendering/GameRenderer.h"
+#include "Game/Rendering/Model/ModelLoader.h"
 
 #include <Base/Memory/Bytebuffer.h>
 
@@ -68,7 +87,10 @@ bool GameConsoleCommands::HandleLogin(GameConsole* gameConsole, std::vector<std:
 	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
 
 	ECS::Singletons::NetworkState& networkState = registry->ctx().at<ECS::Singletons::NetworkState>();
-	networkState.client->Send(buffer);
+	if (!networkState.ioThread)
+		return false;
+
+	networkState.ioThread->Send(buffer);
 
 	return true;
 }
@@ -94,3 +116,389 @@ bool GameConsoleCommands::HandleSetCursor(GameConsole* gameConsole, std::vector<
 
 	return false;
 }
+
+bool GameConsoleCommands::HandlePhysicsBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+		ECS::Singletons::JoltState& joltState = registry->ctx().at<ECS::Singletons::JoltState>();
+
+		// physicsbench sync [maxBodies] [numFrames], sweeps the body count up to maxBodies
+		if (subCommands.size() > 0 && subCommands[0] == "sync")
+		{
+			BenchmarkArgs args(subCommands, 1);
+			u32 maxBodies = args.Next(16384);
+			u32 numFrames = args.Next(100);
+
+			std::vector<Jolt::SyncBenchmarkStep> steps;
+			Jolt::RunSyncBenchmark(joltState, maxBodies, numFrames, steps);
+
+			gameConsole->Print("-- Physics Sync Benchmark (up to %u bodies, %u frames) --", maxBodies, numFrames);
+
+			for (const Jolt::SyncBenchmarkStep& step : steps)
+			{
+				gameConsole->Print("%6u bodies (%6u active) : %.4f ms per frame", step.numBodies, step.numActiveBodies, step.syncMSPerFrame);
+			}
+
+			return true;
+		}
+
+		BenchmarkArgs args(subCommands);
+		u32 numBodies = args.Next(1000);
+		u32 numRounds = args.Next(10);
+
+		Jolt::SpawnBenchmarkResult result;
+		Jolt::RunSpawnBenchmark(joltState, numBodies, numRounds, result);
+
+		gameConsole->Print("-- Physics Spawn Benchmark (%u bodies, %u rounds) --", numBodies, numRounds);
+		gameConsole->Print("Naive  : spawn %.3f ms, despawn %.3f ms", result.naiveSpawnMS, result.naiveDespawnMS);
+		gameConsole->Print("Pooled : spawn %.3f ms, despawn %.3f ms (%u cached shapes)", result.pooledSpawnMS, result.pooledDespawnMS, result.numCachedShapes);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleRaycastBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numRays = args.Next(100000);
+
+		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+		entt::registry::context& ctx = registry->ctx();
+
+		ECS::Singletons::JoltState& joltState = ctx.at<ECS::Singletons::JoltState>();
+		ECS::Singletons::ActiveCamera& activeCamera = ctx.at<ECS::Singletons::ActiveCamera>();
+
+		// Cast around the camera so the rays hit whatever is loaded there
+		vec3 origin = vec3(0.0f, 0.0f, 0.0f);
+		if (activeCamera.entity != entt::null)
+		{
+			origin = registry->get<ECS::Components::Transform>(activeCamera.entity).position;
+		}
+
+		Jolt::RaycastBenchmarkResult result;
+		Jolt::RunRaycastBenchmark(joltState, origin, numRays, result);
+
+		gameConsole->Print("-- Raycast Benchmark (%u rays, %u hits) --", numRays, result.numHits);
+		gameConsole->Print("Serial  : %.0f rays/s", result.serialRaysPerSecond);
+		gameConsole->Print("Batched : %.0f rays/s", result.batchedRaysPerSecond);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleChunkCollisionBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numQueries = args.Next(10000);
+
+		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+		ECS::Singletons::JoltState& joltState = registry->ctx().at<ECS::Singletons::JoltState>();
+		ModelLoader* modelLoader = ServiceLocator::GetGameRenderer()->GetModelLoader();
+
+		Jolt::ChunkCollisionBenchmarkResult result;
+		if (!Jolt::RunChunkCollisionBenchmark(joltState, *modelLoader, numQueries, result))
+		{
+			gameConsole->PrintError("No chunk collision loaded, enable modelLoader.physics.enabled and load a map");
+			return false;
+		}
+
+		gameConsole->Print("-- Chunk Collision Benchmark (chunk %u, %u shapes, %u queries) --", result.chunkID, result.numSubShapes, numQueries);
+		gameConsole->Print("Compound   : ray %.3f us, overlap %.3f us, %u ray hits", result.compoundRayUS, result.compoundOverlapUS, result.compoundRayHits);
+		gameConsole->Print("Placements : ray %.3f us, overlap %.3f us, %u ray hits (added in %.3f ms)", result.placementRayUS, result.placementOverlapUS, result.placementRayHits, result.placementAddMS);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleLuaStateBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numStates = args.Next(64);
+
+		Scripting::LuaStateBenchmarkResult result;
+		Scripting::LuaStateBenchmark::Run(numStates, result);
+
+		gameConsole->Print("-- Lua State Benchmark (%u states) --", numStates);
+		gameConsole->Print("From Scratch : %.3f ms, %.1f KB per state", result.freshMSPerState, result.freshKBPerState);
+		gameConsole->Print("Pool Base    : %.3f ms, %.1f KB once", result.baseMS, result.baseKB);
+		gameConsole->Print("Pooled New   : %.3f ms, %.1f KB per state", result.pooledMSPerState, result.pooledKBPerState);
+		gameConsole->Print("Pooled Reuse : %.3f ms per state", result.reusedMSPerState);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleLuaEventBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numStates = args.Next(8);
+		u32 numEvents = args.Next(10000);
+
+		Scripting::LuaEventBenchmarkResult result;
+		Scripting::LuaEventBenchmark::Run(numStates, numEvents, result);
+
+		gameConsole->Print("-- Lua Event Benchmark (%u states, %u events each, %u callbacks per event) --", numStates, numEvents, Scripting::LuaEventBenchmark::NUM_CALLBACKS);
+		gameConsole->Print("Serial   : %.0f events/s", result.serialEventsPerSecond);
+		gameConsole->Print("Parallel : %.0f events/s (%.0f callbacks/s)", result.parallelEventsPerSecond, result.parallelCallbacksPerSecond);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleLuaNativeBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numIterations = args.Next(1000000);
+
+		Scripting::LuaNativeBenchmarkResult result;
+		Scripting::LuaNativeBenchmark::Run(numIterations, result);
+
+		gameConsole->Print("-- Lua Native Benchmark (%u iterations) --", numIterations);
+
+		if (!result.isSupported)
+		{
+			gameConsole->Print("Native code generation isn't supported on this platform, only the interpreter was measured");
+		}
+
+		for (const Scripting::LuaNativeBenchmarkWorkload& workload : result.workloads)
+		{
+			f64 speedup = workload.nativeMS > 0.0 ? workload.interpreterMS / workload.nativeMS : 0.0;
+
+			gameConsole->Print("%-8s : Interpreter %.2f ms, Native %.2f ms (%.2fx), Compile %.3f ms, +%.1f KB", workload.name, workload.interpreterMS, workload.nativeMS, speedup, workload.compileMS, workload.extraKB);
+		}
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleLuaBindingBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numCalls = args.Next(1000000);
+		u32 numStates = args.Next(100);
+
+		Scripting::LuaBindingBenchmarkResult result;
+		Scripting::LuaBindingBenchmark::Run(numCalls, numStates, result);
+
+		gameConsole->Print("-- Lua Binding Benchmark (%u calls, %u states) --", numCalls, numStates);
+		gameConsole->Print("Empty : %.1f ns per call", result.emptyNSPerCall);
+		gameConsole->Print("Manual : %.1f ns per call (+%.1f ns)", result.manualNSPerCall, result.manualNSPerCall - result.emptyNSPerCall);
+		gameConsole->Print("Bound : %.1f ns per call (+%.1f ns)", result.boundNSPerCall, result.boundNSPerCall - result.emptyNSPerCall);
+		gameConsole->Print("Setup : %.3f ms per state, %.3f ms of it for %u globals", result.setupMSPerState, result.globalsMSPerState, result.numGlobals);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleLuaEntityBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numEntities = args.Next(10000);
+		u32 numIterations = args.Next(100);
+
+		Scripting::LuaEntityBenchmarkResult result;
+		Scripting::LuaEntityBenchmark::Run(numEntities, numIterations, result);
+
+		f64 speedup = result.naiveEntitiesPerMS > 0.0 ? result.batchedEntitiesPerMS / result.naiveEntitiesPerMS : 0.0;
+
+		gameConsole->Print("-- Lua Entity Benchmark (%u entities, %u iterations) --", numEntities, numIterations);
+		gameConsole->Print("Naive   : %.0f entities/ms", result.naiveEntitiesPerMS);
+		gameConsole->Print("Batched : %.0f entities/ms (%.2fx), %.3f ms per iteration applying writes", result.batchedEntitiesPerMS, speedup, result.applyMSPerIteration);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleLuaTaskBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numTasks = args.Next(100000);
+		u32 numFrames = args.Next(60);
+
+		Scripting::LuaTaskBenchmarkResult result;
+		Scripting::LuaTaskBenchmark::Run(numTasks, numFrames, result);
+
+		gameConsole->Print("-- Lua Task Benchmark (%u tasks, %u frames) --", numTasks, numFrames);
+		gameConsole->Print("Spawn    : %.2f ms, %.0f bytes per task, %u waiting", result.spawnMS, result.bytesPerTask, result.numWaiting);
+		gameConsole->Print("Sleeping : %.4f ms per frame", result.idleUpdateMS);
+		gameConsole->Print("Polling  : %.4f ms per frame", result.pollingUpdateMS);
+		gameConsole->Print("Waking   : %.4f ms per frame, %.0f resumes/ms", result.wakeUpdateMS, result.wakesPerMS);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleNetworkPacketBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numPackets = args.Next(10000);
+		u32 payloadSize = args.Next(8, NetworkPacketBenchmark::MIN_PAYLOAD_SIZE, NetworkPacketBenchmark::MAX_PAYLOAD_SIZE);
+
+		NetworkPacketBenchmarkResult result;
+		NetworkPacketBenchmark::Run(numPackets, payloadSize, result);
+
+		f64 speedup = result.copyPacketsPerMS > 0.0 ? result.viewPacketsPerMS / result.copyPacketsPerMS : 0.0;
+
+		gameConsole->Print("-- Network Packet Benchmark (%u packets, %u byte payloads) --", numPackets, payloadSize);
+		gameConsole->Print("Copy : %.0f packets/ms, %.0f allocations per 10k packets", result.copyPacketsPerMS, result.copyAllocationsPer10K);
+		gameConsole->Print("View : %.0f packets/ms (%.2fx), %.0f allocations per 10k packets", result.viewPacketsPerMS, speedup, result.viewAllocationsPer10K);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleNetworkSendBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	return GameConsoleBenchmark::Run(gameConsole, [&]()
+	{
+		BenchmarkArgs args(subCommands);
+		u32 numMessages = args.Next(64);
+		u32 numFrames = args.Next(1000);
+		u32 messageSize = args.Next(32, 1, Network::DEFAULT_BUFFER_SIZE);
+
+		NetworkSendBenchmarkResult result;
+		NetworkSendBenchmark::Run(numMessages, numFrames, messageSize, result);
+
+		gameConsole->Print("-- Network Send Benchmark (%u messages of %u bytes per frame, %u frames at %u fps) --", numMessages, messageSize, numFrames, NetworkSendBenchmark::FRAMES_PER_SECOND);
+		gameConsole->Print("Unbatched : %.0f sends/s, %.1f KB/s on the wire", result.unbatchedSendsPerSecond, result.unbatchedWireBytesPerSecond / 1024.0);
+		gameConsole->Print("Batched   : %.0f sends/s, %.1f KB/s on the wire, %.4f ms per frame batching", result.batchedSendsPerSecond, result.batchedWireBytesPerSecond / 1024.0, result.batchMSPerFrame);
+
+		return true;
+	});
+}
+
+bool GameConsoleCommands::HandleNetworkLatency(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+
+	ECS::Singletons::NetworkState& networkState = registry->ctx().at<ECS::Singletons::NetworkState>();
+	if (!networkState.ioThread)
+		return false;
+
+	if (subCommands.size() > 0 && subCommands[0] == "reset")
+	{
+		networkState.ioThread->ResetLatencyStats();
+		gameConsole->Print("Network latency samples cleared");
+		return true;
+	}
+
+	NetworkIOThread::LatencyStats stats = networkState.ioThread->GetLatencyStats();
+
+	gameConsole->Print("-- Network Receive To Dispatch Latency (last %u packets, %s) --", stats.numSamples, networkState.ioThread->IsConnected() ? "connected" : "not connected");
+	gameConsole->Print("Average : %.3f ms", stats.averageMS);
+	gameConsole->Print("p50     : %.3f ms", stats.p50MS);
+	gameConsole->Print("p95     : %.3f ms", stats.p95MS);
+	gameConsole->Print("p99     : %.3f ms", stats.p99MS);
+	gameConsole->Print("Max     : %.3f ms", stats.maxMS);
+
+	return true;
+}
+
+bool GameConsoleCommands::HandleLuaProfile(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	const std::string action = subCommands.size() > 0 ? subCommands[0] : "";
+
+	if (action == "start")
+	{
+		Scripting::LuaProfiler::Start();
+		gameConsole->Print("Script profiler starts with the next script update");
+		return true;
+	}
+
+	if (action == "stop")
+	{
+		Scripting::LuaProfiler::Stop();
+		gameConsole->Print("Script profiler stops with the next script update");
+		return true;
+	}
+
+	if (action == "reset")
+	{
+		Scripting::LuaProfiler::Reset();
+		gameConsole->Print("Script profile is cleared with the next script update");
+		return true;
+	}
+
+	if (action == "export")
+	{
+		const std::string name = subCommands.size() > 1 ? subCommands[1] : "ScriptProfile";
+
+		bool result = Scripting::LuaProfiler::ExportFolded(name + ".folded");
+		result &= Scripting::LuaProfiler::ExportChromeTrace(name + ".json");
+
+		if (!result)
+		{
+			gameConsole->Print("Failed to export the script profile to %s", name.c_str());
+			return false;
+		}
+
+		gameConsole->Print("Exported the script profile to %s.folded and %s.json", name.c_str(), name.c_str());
+		return true;
+	}
+
+	if (action == "bench")
+	{
+		return GameConsoleBenchmark::Run(gameConsole, [&]()
+		{
+			BenchmarkArgs args(subCommands, 1);
+			u32 numIterations = args.Next(200);
+			u32 sampleRate = args.Next(1000, 10, 10000);
+
+			Scripting::LuaProfilerBenchmarkResult result;
+			if (!Scripting::LuaProfilerBenchmark::Run(numIterations, sampleRate, result))
+			{
+				gameConsole->Print("Script profiler benchmark failed, the profiler has to be stopped to run it");
+				return false;
+			}
+
+			gameConsole->Print("-- Lua Profiler Benchmark (%u iterations, %u Hz) --", numIterations, result.sampleRate);
+			gameConsole->Print("Off : %.3f ms", result.offMS);
+			gameConsole->Print("On  : %.3f ms, %llu samples", result.onMS, static_cast<unsigned long long>(result.numSamples));
+			gameConsole->Print("Overhead : %.2f%%", result.overheadPercent);
+			return true;
+		});
+	}
+
+	if (!action.empty())
+	{
+		gameConsole->Print("Usage : luaprofile [start|stop|reset|export [name]|bench [iterations] [sampleRateHz]]");
+		return false;
+	}
+
+	f64 tickDurationMS = Scripting::LuaProfiler::GetTickDurationMS();
+	u64 numTicks = Scripting::LuaProfiler::GetNumTicks();
+
+	gameConsole->Print("-- Lua Profile (%s, %.1f ms sampled, %llu samples, %llu dropped) --", Scripting::LuaProfiler::IsRunning() ? "running" : "stopped", static_cast<f64>(numTicks) * tickDurationMS, static_cast<unsigned long long>(Scripting::LuaProfiler::GetNumSamples()), static_cast<unsigned long long>(Scripting::LuaProfiler::GetNumDroppedSamples()));
+
+	std::vector<const Scripting::LuaProfileFunction*> functions;
+	Scripting::LuaProfiler::GetTopFunctions(10, functions);
+
+	for (const Scripting::LuaProfileFunction* function : functions)
+	{
+		f64 selfPercent = numTicks > 0 ? static_cast<f64>(function->selfTicks) / static_cast<f64>(numTicks) * 100.0 : 0.0;
+
+		gameConsole->Print("%5.1f%% Self %.2f ms, Total %.2f ms : %s", selfPercent, static_cast<f64>(function->selfTicks) * tickDurationMS, static_cast<f64>(function->totalTicks) * tickDurationMS, function->name.c_str());
+	}
+
+	return true;
+}
@@ -11,4 +11,17 @@ public:
 	static bool HandleLogin(GameConsole* gameConsole, std::vector<std::string> subCommands);
 	static bool HandleReloadScripts(GameConsole* gameConsole, std::vector<std::string> subCommands);
 	static bool HandleSetCursor(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandlePhysicsBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleRaycastBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleChunkCollisionBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaStateBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaEventBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaNativeBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaBindingBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaEntityBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaTaskBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleNetworkPacketBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleNetworkSendBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleNetworkLatency(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleLuaProfile(GameConsole* gameConsole, std::vector<std::string> subCommands);
 };
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "NetworkIOThread.h"
+
+#include <Base/CVarSystem/CVarSystem.h>
+#include <Base/Util/DebugHandler.h>
+
+#include <Network/Client.h>
+#include <Network/Define.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+AutoCVar_Int CVAR_NetworkPollIntervalUS("network.pollIntervalUS", "how long the network thread sleeps between reads in microseconds right after it received something, read when it starts", 250);
+AutoCVar_Int CVAR_NetworkMaxPollIntervalUS("network.maxPollIntervalUS", "the longest the network thread sleeps between reads in microseconds once the connection went quiet, read when it starts", 8000);
+AutoCVar_Int CVAR_NetworkDisconnectedPollIntervalMS("network.disconnectedPollIntervalMS", "how long the network thread sleeps between checks in milliseconds while there is no connection, read when it starts", 100);
+AutoCVar_Int CVAR_NetworkBatchOutbound("network.batchOutbound", "coalesce the packets sent during a frame into one send", 1, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_NetworkReceiveRingSizeKB("network.receiveRingSizeKB", "the size of the ring received payloads wait in until the game thread dispatched them, read on init", 1024);
+
+NetworkIOThread::NetworkIOThread(Network::Client* client) : _client(client)
+{
+	_latencySamplesMS.reserve(MAX_LATENCY_SAMPLES);
+
+	// Has to fit at least two of the largest payloads, so one can be written while the other is being dispatched
+	size_t receiveRingSize = static_cast<size_t>(std::max(CVAR_NetworkReceiveRingSizeKB.Get(), 1)) * 1024;
+	_receiveRing.Init(std::max(receiveRingSize, static_cast<size_t>(Network::DEFAULT_BUFFER_SIZE) * 2));
+}
+
+NetworkIOThread::~NetworkIOThread()
+{
+	Stop();
+}
+
+void NetworkIOThread::Start()
+{
+	if (_thread.joinable())
+		return;
+
+	_isConnected = _client->IsConnected();
+	_isRunning = true;
+	_thread = std::thread(&NetworkIOThread::Run, this);
+}
+
+void NetworkIOThread::Stop()
+{
+	if (!_thread.joinable())
+		return;
+
+	{
+		std::scoped_lock lock(_wakeMutex);
+		_isRunning = false;
+	}
+
+	_wakeCondition.notify_one();
+	_thread.join();
+}
+
+void NetworkIOThread::Send(const std::shared_ptr<Bytebuffer>& buffer)
+{
+	_numPacketsQueued++;
+
+	if (CVAR_NetworkBatchOutbound.Get() == 0)
+	{
+		Flush();
+		QueueSend(buffer);
+		return;
+	}
+
+	_outboundBatcher.Add(buffer, [this](std::shared_ptr<Bytebuffer> batch)
+	{
+		QueueSend(std::move(batch));
+	});
+}
+
+void NetworkIOThread::Flush()
+{
+	std::shared_ptr<Bytebuffer> batch = _outboundBatcher.Flush();
+	if (batch)
+	{
+		QueueSend(std::move(batch));
+	}
+}
+
+void NetworkIOThread::QueueSend(std::shared_ptr<Bytebuffer> buffer)
+{
+	_outboundPackets.enqueue(std::move(buffer));
+
+	{
+		std::scoped_lock lock(_wakeMutex);
+		_hasPendingSends = true;
+	}
+
+	_wakeCondition.notify_one();
+}
+
+void NetworkIOThread::Close()
+{
+	_isCloseRequested = true;
+}
+
+bool NetworkIOThread::TryDequeue(InboundPacket& inboundPacket)
+{
+	return _inboundPackets.try_dequeue(inboundPacket);
+}
+
+void NetworkIOThread::AddDispatchLatency(const InboundPacket& inboundPacket)
+{
+	f32 latencyMS = static_cast<f32>(static_cast<f64>(GetTimeNS() - inboundPacket.receiveTimeNS) / 1000000.0);
+
+	if (_latencySamplesMS.size() < MAX_LATENCY_SAMPLES)
+	{
+		_latencySamplesMS.push_back(latencyMS);
+		return;
+	}
+
+	_latencySamplesMS[_nextLatencySample] = latencyMS;
+	_nextLatencySample = (_nextLatencySample + 1) % MAX_LATENCY_SAMPLES;
+}
+
+NetworkIOThread::LatencyStats NetworkIOThread::GetLatencyStats() const
+{
+	LatencyStats stats;
+
+	if (_latencySamplesMS.empty())
+		return stats;
+
+	std::vector<f32> samples = _latencySamplesMS;
+	std::sort(samples.begin(), samples.end());
+
+	size_t numSamples = samples.size();
+	auto getPercentile = [&samples, numSamples](f64 percentile)
+	{
+		size_t index = std::min(static_cast<size_t>(percentile * static_cast<f64>(numSamples)), numSamples - 1);
+		return static_cast<f64>(samples[index]);
+	};
+
+	f64 totalMS = 0.0;
+	for (f32 sample : samples)
+	{
+		totalMS += sample;
+	}
+
+	stats.numSamples = static_cast<u32>(numSamples);
+	stats.averageMS = totalMS / static_cast<f64>(numSamples);
+	stats.p50MS = getPercentile(0.50);
+	stats.p95MS = getPercentile(0.95);
+	stats.p99MS = getPercentile(0.99);
+	stats.maxMS = static_cast<f64>(samples.back());
+
+	return stats;
+}
+
+void NetworkIOThread::ResetLatencyStats()
+{
+	_latencySamplesMS.clear();
+	_nextLatencySample = 0;
+}
+
+NetworkIOThread::SendStats NetworkIOThread::ConsumeSendStats()
+{
+	SendStats stats;
+	stats.numSends = _numSends.exchange(0, std::memory_order_relaxed);
+	stats.numPackets = _numPacketsQueued;
+	stats.numBytes = _numBytesSent.exchange(0, std::memory_order_relaxed);
+
+	_numPacketsQueued = 0;
+	return stats;
+}
+
+u64 NetworkIOThread::GetTimeNS()
+{
+	auto timeSinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeSinceEpoch).count());
+}
+
+void NetworkIOThread::Run()
+{
+	tracy::SetThreadName("Network Thread");
+
+	std::chrono::microseconds minPollInterval(std::max(CVAR_NetworkPollIntervalUS.Get(), 1));
+	std::chrono::microseconds maxPollInterval(std::max(CVAR_NetworkMaxPollIntervalUS.Get(), CVAR_NetworkPollIntervalUS.Get()));
+	std::chrono::microseconds disconnectedPollInterval(std::max(CVAR_NetworkDisconnectedPollIntervalMS.Get(), 1) * 1000);
+
+	// The client doesn't expose its socket to wait on, so the thread backs off instead. Every quiet wakeup doubles the sleep up to the max,
+	// anything read or sent drops it back to the minimum, and queued sends wake the thread right away no matter how long it sleeps
+	std::chrono::microseconds pollInterval = minPollInterval;
+
+	while (_isRunning)
+	{
+		if (_isCloseRequested.exchange(false))
+		{
+			_client->Close();
+		}
+
+		// Sends go first so a reply the game thread queued in response to the last packet isn't held back by the next read
+		bool didWork = SendPackets();
+		didWork |= ReadPackets();
+
+		bool isConnected = _client->IsConnected();
+		_isConnected.store(isConnected, std::memory_order_relaxed);
+
+		if (didWork)
+		{
+			pollInterval = minPollInterval;
+			continue;
+		}
+
+		std::chrono::microseconds sleepInterval = isConnected ? pollInterval : disconnectedPollInterval;
+		pollInterval = std::min(pollInterval * 2, maxPollInterval);
+
+		std::unique_lock lock(_wakeMutex);
+		_wakeCondition.wait_for(lock, sleepInterval, [this]() { return _hasPendingSends || !_isRunning; });
+		_hasPendingSends = false;
+	}
+}
+
+bool NetworkIOThread::ReadPackets()
+{
+	ZoneScoped;
+
+	// Complete packets that didn't fit in the ring last time are parsed again even if nothing new arrived
+	Network::Socket::Result readResult = _client->Read();
+	if (readResult != Network::Socket::Result::SUCCESS && !_isReceiveRingFull)
+		return false;
+
+	_isReceiveRingFull = false;
+
+	// Every packet of one read arrived at the same time, as far as the game thread can tell
+	u64 receiveTimeNS = GetTimeNS();
+	bool didRead = false;
+
+	std::shared_ptr<Bytebuffer>& buffer = _client->GetReadBuffer();
+	while (size_t activeSize = buffer->GetActiveSize())
+	{
+		// We have received a partial header and need to read more
+		if (activeSize < sizeof(Network::Packet::Header))
+		{
+			buffer->Normalize();
+			break;
+		}
+
+		Network::Packet::Header* header = reinterpret_cast<Network::Packet::Header*>(buffer->GetReadPointer());
+
+		if (header->opcode == Network::Opcode::INVALID || header->opcode > Network::Opcode::MAX_COUNT)
+		{
+#ifdef NC_Debug
+			DebugHandler::PrintError("Network : Received Invalid Opcode ({0}) from server", static_cast<std::underlying_type<Network::Opcode>::type>(header->opcode));
+#endif // NC_Debug
+			_client->Close();
+			break;
+		}
+
+		if (header->size > Network::DEFAULT_BUFFER_SIZE)
+		{
+#ifdef NC_Debug
+			DebugHandler::PrintError("Network : Received Invalid Opcode Size ({0} : {1}) from server", static_cast<std::underlying_type<Network::Opcode>::type>(header->opcode), header->size);
+#endif // NC_Debug
+			_client->Close();
+			break;
+		}
+
+		size_t receivedPayloadSize = activeSize - sizeof(Network::Packet::Header);
+		if (receivedPayloadSize < header->size)
+		{
+			buffer->Normalize();
+			break;
+		}
+
+		InboundPacket inboundPacket;
+		inboundPacket.header = *header;
+		inboundPacket.receiveTimeNS = receiveTimeNS;
+
+		// The game thread is behind, the rest stays in the read buffer until it released enough of the ring
+		if (!_receiveRing.Reserve(header->size, inboundPacket.payloadPosition))
+		{
+			_isReceiveRingFull = true;
+			buffer->Normalize();
+			break;
+		}
+
+		buffer->SkipRead(sizeof(Network::Packet::Header));
+
+		// Payload
+		if (inboundPacket.header.size)
+		{
+			std::memcpy(_receiveRing.GetData(inboundPacket.payloadPosition), buffer->GetReadPointer(), inboundPacket.header.size);
+
+			// Skip Payload
+			buffer->SkipRead(inboundPacket.header.size);
+		}
+
+		_inboundPackets.enqueue(inboundPacket);
+		didRead = true;
+	}
+
+	return didRead;
+}
+
+bool NetworkIOThread::SendPackets()
+{
+	std::shared_ptr<Bytebuffer> buffer;
+	bool didSend = false;
+
+	while (_outboundPackets.try_dequeue(buffer))
+	{
+		_numBytesSent.fetch_add(buffer->writtenData, std::memory_order_relaxed);
+		_numSends.fetch_add(1, std::memory_order_relaxed);
+
+		_client->Send(buffer);
+		didSend = true;
+	}
+
+	return didSend;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "OutboundBatcher.h"
+#include "ReceiveRing.h"
+
+#include <Base/Types.h>
+#include <Base/Container/ConcurrentQueue.h>
+#include <Base/Memory/Bytebuffer.h>
+
+#include <Network/Packet.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Network
+{
+	class Client;
+}
+
+// Owns the socket of a client on a thread of its own. Packets are read and parsed there as soon as they arrive, their payloads are
+// copied into a ring and handed to the game thread through a queue, packets to send go the other way through a second one,
+// so a slow frame never stalls the socket.
+// Only the game thread may call anything but the constructor and destructor, once Start has been called it may no longer touch the client.
+class NetworkIOThread
+{
+public:
+	struct InboundPacket
+	{
+	public:
+		Network::Packet::Header header;
+		u64 payloadPosition = 0; // In the receive ring
+		u64 receiveTimeNS = 0;
+	};
+
+	struct LatencyStats
+	{
+	public:
+		u32 numSamples = 0;
+		f64 averageMS = 0.0;
+		f64 p50MS = 0.0;
+		f64 p95MS = 0.0;
+		f64 p99MS = 0.0;
+		f64 maxMS = 0.0;
+	};
+
+	static constexpr u32 MAX_LATENCY_SAMPLES = 4096;
+
+public:
+	NetworkIOThread(Network::Client* client);
+	~NetworkIOThread();
+
+	void Start();
+	void Stop();
+
+	struct SendStats
+	{
+	public:
+		u32 numSends = 0; // Calls to the socket
+		u32 numPackets = 0; // Buffers passed to Send
+		u64 numBytes = 0;
+	};
+
+	// The buffer must hold complete packets, it is sent in the order it was queued. With network.batchOutbound it is copied into
+	// the current batch and goes out with the next Flush, or earlier once the batch is full
+	void Send(const std::shared_ptr<Bytebuffer>& buffer);
+	void Flush();
+
+	// The connection is closed by the IO thread, packets it already parsed are still dequeued
+	void Close();
+
+	// The payload stays valid until the packet is released, packets have to be released in the order they were dequeued
+	bool TryDequeue(InboundPacket& inboundPacket);
+	u8* GetPayload(const InboundPacket& inboundPacket) { return _receiveRing.GetData(inboundPacket.payloadPosition); }
+	void Release(const InboundPacket& inboundPacket) { _receiveRing.Release(inboundPacket.payloadPosition + inboundPacket.header.size); }
+	bool IsConnected() const { return _isConnected.load(std::memory_order_relaxed); }
+
+	// Records the time from the packet being read to it being dispatched, the last MAX_LATENCY_SAMPLES are kept
+	void AddDispatchLatency(const InboundPacket& inboundPacket);
+	LatencyStats GetLatencyStats() const;
+	void ResetLatencyStats();
+
+	// Sent since the last call
+	SendStats ConsumeSendStats();
+
+	static u64 GetTimeNS();
+
+private:
+	void Run();
+
+	// Both return true if they did anything
+	bool ReadPackets();
+	bool SendPackets();
+
+	void QueueSend(std::shared_ptr<Bytebuffer> buffer);
+
+private:
+	Network::Client* _client;
+
+	std::thread _thread;
+	std::atomic<bool> _isRunning = false;
+	std::atomic<bool> _isConnected = false;
+	std::atomic<bool> _isCloseRequested = false;
+
+	// Woken when there is something to send, otherwise the thread sleeps between reads for a poll interval that grows while nothing arrives
+	std::mutex _wakeMutex;
+	std::condition_variable _wakeCondition;
+	bool _hasPendingSends = false;
+
+	ReceiveRing _receiveRing;
+	bool _isReceiveRingFull = false;
+	moodycamel::ConcurrentQueue<InboundPacket> _inboundPackets;
+	moodycamel::ConcurrentQueue<std::shared_ptr<Bytebuffer>> _outboundPackets;
+
+	OutboundBatcher _outboundBatcher;
+	u32 _numPacketsQueued = 0;
+	std::atomic<u32> _numSends = 0;
+	std::atomic<u64> _numBytesSent = 0;
+
+	std::vector<f32> _latencySamplesMS;
+	u32 _nextLatencySample = 0;
+};
@@ -0,0 +1,129 @@
+#include "NetworkPacketBenchmark.h"
+#include "PacketView.h"
+#include "ReceiveRing.h"
+
+#include <Base/Memory/Bytebuffer.h>
+#include <Base/Util/Timer.h>
+
+#include <Network/Define.h>
+#include <Network/Packet.h>
+#include <Network/PacketHandler.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <cstring>
+#include <vector>
+
+static u64 BenchmarkPacketChecksum = 0;
+
+static bool HandleBenchmarkPacket(Network::SocketID socketID, std::shared_ptr<Network::Packet> netPacket)
+{
+	u32 value = 0;
+	if (!netPacket->payload->GetU32(value))
+		return false;
+
+	BenchmarkPacketChecksum += value;
+	return true;
+}
+
+void NetworkPacketBenchmark::Run(u32 numPackets, u32 payloadSize, NetworkPacketBenchmarkResult& result)
+{
+	ZoneScoped;
+
+	result = NetworkPacketBenchmarkResult();
+
+	if (numPackets == 0)
+		return;
+
+	// Every payload starts with the packet index as a u32
+	if (payloadSize < MIN_PAYLOAD_SIZE || payloadSize > MAX_PAYLOAD_SIZE)
+		return;
+
+	// The handler reads a u32, the same size limits as the real handler for this opcode apply
+	Network::PacketHandler packetHandler;
+	packetHandler.SetMessageHandler(Network::Opcode::SMSG_CONNECTED, Network::OpcodeHandler(Network::ConnectionStatus::AUTH_NONE, MIN_PAYLOAD_SIZE, MAX_PAYLOAD_SIZE, &HandleBenchmarkPacket));
+
+	// Everything the socket would have delivered, back to back
+	size_t packetSize = sizeof(Network::Packet::Header) + payloadSize;
+	std::vector<u8> stream(packetSize * numPackets);
+
+	for (u32 i = 0; i < numPackets; i++)
+	{
+		u8* data = &stream[packetSize * i];
+
+		Network::Packet::Header header = { };
+		header.opcode = Network::Opcode::SMSG_CONNECTED;
+		header.size = static_cast<u16>(payloadSize);
+		std::memcpy(data, &header, sizeof(Network::Packet::Header));
+
+		u8* payload = data + sizeof(Network::Packet::Header);
+		std::memset(payload, 0, payloadSize);
+		std::memcpy(payload, &i, sizeof(u32));
+	}
+
+	f64 allocationScale = 10000.0 / static_cast<f64>(numPackets);
+
+	// Copy, every packet gets a packet and payload buffer of its own
+	{
+		u32 numAllocations = 0;
+		Timer timer;
+
+		for (u32 i = 0; i < numPackets; i++)
+		{
+			const u8* data = &stream[packetSize * i];
+
+			std::shared_ptr<Network::Packet> packet = Network::Packet::Borrow();
+			std::memcpy(&packet->header, data, sizeof(Network::Packet::Header));
+
+			packet->payload = Bytebuffer::Borrow<Network::DEFAULT_BUFFER_SIZE>();
+			packet->payload->size = packet->header.size;
+			packet->payload->writtenData = packet->header.size;
+			std::memcpy(packet->payload->GetDataPointer(), data + sizeof(Network::Packet::Header), packet->header.size);
+			numAllocations += 2;
+
+			packetHandler.CallHandler(Network::SOCKET_ID_INVALID, packet);
+		}
+
+		f64 totalMS = timer.GetLifeTime() * 1000.0;
+
+		result.copyPacketsPerMS = totalMS > 0.0 ? numPackets / totalMS : 0.0;
+		result.copyAllocationsPer10K = numAllocations * allocationScale;
+	}
+
+	// View, payloads are copied into the ring and dispatched from there
+	{
+		ReceiveRing receiveRing;
+		receiveRing.Init(1024 * 1024);
+
+		PacketView packetView;
+		packetView.ConsumeNumAllocations();
+
+		Timer timer;
+
+		for (u32 i = 0; i < numPackets; i++)
+		{
+			const u8* data = &stream[packetSize * i];
+
+			Network::Packet::Header header;
+			std::memcpy(&header, data, sizeof(Network::Packet::Header));
+
+			u64 payloadPosition = 0;
+			if (!receiveRing.Reserve(header.size, payloadPosition))
+				break;
+
+			u8* payload = receiveRing.GetData(payloadPosition);
+			std::memcpy(payload, data + sizeof(Network::Packet::Header), header.size);
+
+			std::shared_ptr<Network::Packet>& packet = packetView.Set(header, payload);
+			packetHandler.CallHandler(Network::SOCKET_ID_INVALID, packet);
+
+			packetView.Reset();
+			receiveRing.Release(payloadPosition + header.size);
+		}
+
+		f64 totalMS = timer.GetLifeTime() * 1000.0;
+
+		result.viewPacketsPerMS = totalMS > 0.0 ? numPackets / totalMS : 0.0;
+		result.viewAllocationsPer10K = packetView.ConsumeNumAllocations() * allocationScale;
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <Base/Types.h>
+
+struct NetworkPacketBenchmarkResult
+{
+public:
+	f64 copyPacketsPerMS = 0.0;
+	f64 viewPacketsPerMS = 0.0;
+
+	// Packets and payload buffers acquired while dispatching, scaled to 10k packets
+	f64 copyAllocationsPer10K = 0.0;
+	f64 viewAllocationsPer10K = 0.0;
+};
+
+// Parses and dispatches numPackets packets with payloadSize byte payloads from memory, once copying every payload into a buffer
+// of its own and once through a ReceiveRing and PacketView like NetworkIOThread does. No socket is involved.
+class NetworkPacketBenchmark
+{
+public:
+	// The benchmark handler reads a u32 and accepts at most 12 bytes, Run does nothing for payload sizes outside of this
+	static constexpr u32 MIN_PAYLOAD_SIZE = 4;
+	static constexpr u32 MAX_PAYLOAD_SIZE = 12;
+
+	static void Run(u32 numPackets, u32 payloadSize, NetworkPacketBenchmarkResult& result);
+};
@@ -0,0 +1,93 @@
+#include "NetworkSendBenchmark.h"
+#include "OutboundBatcher.h"
+
+#include <Base/Util/Timer.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <cstring>
+#include <vector>
+
+struct SendBenchmarkCounter
+{
+public:
+	void Add(size_t numBytes)
+	{
+		u64 numSegments = (numBytes + NetworkSendBenchmark::SEGMENT_SIZE - 1) / NetworkSendBenchmark::SEGMENT_SIZE;
+
+		numSends++;
+		numWireBytes += numBytes + numSegments * NetworkSendBenchmark::SEGMENT_HEADER_SIZE;
+	}
+
+	u64 numSends = 0;
+	u64 numWireBytes = 0;
+};
+
+void NetworkSendBenchmark::Run(u32 numMessages, u32 numFrames, u32 messageSize, NetworkSendBenchmarkResult& result)
+{
+	ZoneScoped;
+
+	result = NetworkSendBenchmarkResult();
+
+	if (numMessages == 0 || numFrames == 0 || messageSize == 0 || messageSize > Network::DEFAULT_BUFFER_SIZE)
+		return;
+
+	std::vector<std::shared_ptr<Bytebuffer>> messages(numMessages);
+	for (u32 i = 0; i < numMessages; i++)
+	{
+		std::shared_ptr<Bytebuffer>& message = messages[i];
+		message = Bytebuffer::Borrow<Network::DEFAULT_BUFFER_SIZE>();
+
+		std::memset(message->GetDataPointer(), static_cast<i32>(i & 0xFF), messageSize);
+		message->writtenData = messageSize;
+	}
+
+	f64 secondsScale = static_cast<f64>(FRAMES_PER_SECOND) / static_cast<f64>(numFrames);
+
+	// Unbatched, every message is a send of its own
+	{
+		SendBenchmarkCounter counter;
+
+		for (u32 frame = 0; frame < numFrames; frame++)
+		{
+			for (const std::shared_ptr<Bytebuffer>& message : messages)
+			{
+				counter.Add(message->writtenData);
+			}
+		}
+
+		result.unbatchedSendsPerSecond = static_cast<f64>(counter.numSends) * secondsScale;
+		result.unbatchedWireBytesPerSecond = static_cast<f64>(counter.numWireBytes) * secondsScale;
+	}
+
+	// Batched, one send per frame unless a batch fills up
+	{
+		SendBenchmarkCounter counter;
+		OutboundBatcher outboundBatcher;
+
+		auto send = [&counter](const std::shared_ptr<Bytebuffer>& buffer)
+		{
+			counter.Add(buffer->writtenData);
+		};
+
+		Timer timer;
+
+		for (u32 frame = 0; frame < numFrames; frame++)
+		{
+			for (const std::shared_ptr<Bytebuffer>& message : messages)
+			{
+				outboundBatcher.Add(message, send);
+			}
+
+			std::shared_ptr<Bytebuffer> batch = outboundBatcher.Flush();
+			if (batch)
+			{
+				send(batch);
+			}
+		}
+
+		result.batchMSPerFrame = timer.GetLifeTime() * 1000.0 / numFrames;
+		result.batchedSendsPerSecond = static_cast<f64>(counter.numSends) * secondsScale;
+		result.batchedWireBytesPerSecond = static_cast<f64>(counter.numWireBytes) * secondsScale;
+	}
+}
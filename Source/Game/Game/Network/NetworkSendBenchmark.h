@@ -0,0 +1,28 @@
+#pragma once
+#include <Base/Types.h>
+
+struct NetworkSendBenchmarkResult
+{
+public:
+	// At 60 frames per second
+	f64 unbatchedSendsPerSecond = 0.0;
+	f64 batchedSendsPerSecond = 0.0;
+
+	// Payload plus an IPv4 and TCP header for every segment, assuming each send is flushed as its own segments
+	f64 unbatchedWireBytesPerSecond = 0.0;
+	f64 batchedWireBytesPerSecond = 0.0;
+
+	f64 batchMSPerFrame = 0.0;
+};
+
+// Produces numMessages messageSize byte messages per frame for numFrames frames and counts what would reach the socket, once sending
+// every message on its own and once through an OutboundBatcher flushed at the end of every frame. No socket is involved.
+class NetworkSendBenchmark
+{
+public:
+	static constexpr u32 FRAMES_PER_SECOND = 60;
+	static constexpr u32 SEGMENT_SIZE = 1460;
+	static constexpr u32 SEGMENT_HEADER_SIZE = 40;
+
+	static void Run(u32 numMessages, u32 numFrames, u32 messageSize, NetworkSendBenchmarkResult& result);
+};
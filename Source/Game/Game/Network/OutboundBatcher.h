@@ -0,0 +1,60 @@
+#pragma once
+#include <Base/Types.h>
+#include <Base/Memory/Bytebuffer.h>
+
+#include <Network/Define.h>
+
+#include <cstring>
+#include <memory>
+
+// Coalesces the packets produced during a frame into one contiguous buffer, so they reach the socket with a single send
+// instead of one send and one TCP segment each. A batch is handed out once it can't fit the next packet or when flushed.
+class OutboundBatcher
+{
+public:
+	static constexpr size_t BATCH_SIZE = Network::DEFAULT_BUFFER_SIZE;
+
+	// send(batch) is called for every buffer that is ready to go out, in the order the packets were added
+	template <typename SendFn>
+	void Add(const std::shared_ptr<Bytebuffer>& buffer, SendFn&& send)
+	{
+		size_t size = buffer->writtenData;
+		if (size == 0)
+			return;
+
+		if (_batch && _batch->writtenData + size > BATCH_SIZE)
+		{
+			send(Flush());
+		}
+
+		// Too large to share a batch with anything, it goes out on its own
+		if (size > BATCH_SIZE)
+		{
+			send(buffer);
+			return;
+		}
+
+		if (!_batch)
+		{
+			_batch = Bytebuffer::Borrow<BATCH_SIZE>();
+			_batch->writtenData = 0;
+		}
+
+		std::memcpy(_batch->GetDataPointer() + _batch->writtenData, buffer->GetDataPointer(), size);
+		_batch->writtenData += size;
+		_numBatched++;
+	}
+
+	// Returns everything added since the last flush, nullptr if nothing was
+	std::shared_ptr<Bytebuffer> Flush()
+	{
+		_numBatched = 0;
+		return std::move(_batch);
+	}
+
+	u32 GetNumBatched() const { return _numBatched; }
+
+private:
+	std::shared_ptr<Bytebuffer> _batch;
+	u32 _numBatched = 0;
+};
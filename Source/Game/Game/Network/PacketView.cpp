@@ -0,0 +1,91 @@
+#include "PacketView.h"
+
+#include <Base/Util/DebugHandler.h>
+
+#include <Network/Define.h>
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+static u8 EmptyPayload[1] = { 0 };
+
+PacketView::PacketView()
+{
+	Allocate();
+}
+
+std::shared_ptr<Network::Packet>& PacketView::Set(const Network::Packet::Header& header, u8* payload)
+{
+	// The buffer doesn't own what it points to, so it can be pointed somewhere else by constructing it again in place
+	Bytebuffer* payloadBuffer = _payload.get();
+	payloadBuffer->~Bytebuffer();
+	new (payloadBuffer) Bytebuffer(header.size > 0 ? payload : EmptyPayload, header.size);
+
+	payloadBuffer->size = header.size;
+	payloadBuffer->writtenData = header.size;
+
+	_packet->header = header;
+	_packet->payload = _payload;
+
+	return _packet;
+}
+
+void PacketView::Reset()
+{
+	// One reference is ours and the payload has one more from the packet
+	if (_packet.use_count() == 1 && _payload.use_count() == 2)
+		return;
+
+#ifdef NC_Debug
+	DebugHandler::PrintWarning("Network : Handler for opcode ({0}) kept its packet past returning, the payload has to be copied to be kept", static_cast<std::underlying_type<Network::Opcode>::type>(_packet->header.opcode));
+#endif // NC_Debug
+
+	// The payload still points into the receive ring which gets released right after this, so the kept packet gets its own copy
+	if (_packet.use_count() > 1)
+	{
+		_packet->payload = Copy(_payload);
+	}
+	else
+	{
+		_packet->payload.reset();
+	}
+
+	// Someone kept the payload buffer itself, we can't hand them a copy so point it at nothing rather than at memory that is about to be reused
+	if (_payload.use_count() > 1)
+	{
+		DebugHandler::PrintError("Network : Handler for opcode ({0}) kept the payload of its packet, use PacketView::Copy to keep it", static_cast<std::underlying_type<Network::Opcode>::type>(_packet->header.opcode));
+
+		Bytebuffer* payloadBuffer = _payload.get();
+		payloadBuffer->~Bytebuffer();
+		new (payloadBuffer) Bytebuffer(EmptyPayload, 0);
+	}
+
+	Allocate();
+}
+
+std::shared_ptr<Bytebuffer> PacketView::Copy(const std::shared_ptr<Bytebuffer>& payload)
+{
+	std::shared_ptr<Bytebuffer> copy = Bytebuffer::Borrow<Network::DEFAULT_BUFFER_SIZE>();
+	copy->size = payload->writtenData;
+	copy->writtenData = payload->writtenData;
+	std::memcpy(copy->GetDataPointer(), payload->GetDataPointer(), payload->writtenData);
+
+	return copy;
+}
+
+u32 PacketView::ConsumeNumAllocations()
+{
+	u32 numAllocations = _numAllocations;
+	_numAllocations = 0;
+
+	return numAllocations;
+}
+
+void PacketView::Allocate()
+{
+	_packet = Network::Packet::Borrow();
+	_payload = std::make_shared<Bytebuffer>(EmptyPayload, 0);
+
+	_numAllocations += 2;
+}
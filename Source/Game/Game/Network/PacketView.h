@@ -0,0 +1,36 @@
+#pragma once
+#include <Base/Types.h>
+#include <Base/Memory/Bytebuffer.h>
+
+#include <Network/Packet.h>
+
+#include <memory>
+
+// Presents a payload that lives in someone else's memory, like the receive ring of NetworkIOThread, as a packet the handlers can take.
+// The same packet and payload buffer are reused for every Set, so the payload is only valid until the handler returns and
+// a handler that needs it for longer has to Copy it
+class PacketView
+{
+public:
+	PacketView();
+
+	std::shared_ptr<Network::Packet>& Set(const Network::Packet::Header& header, u8* payload);
+
+	// Must be called once the handler returned and before the payload memory is released, if it held on to the packet it gets an owning copy of the payload
+	// and is replaced so the next Set can't change it under the handler
+	void Reset();
+
+	static std::shared_ptr<Bytebuffer> Copy(const std::shared_ptr<Bytebuffer>& payload);
+
+	// Packets and payload buffers created since the last call
+	u32 ConsumeNumAllocations();
+
+private:
+	void Allocate();
+
+private:
+	std::shared_ptr<Network::Packet> _packet;
+	std::shared_ptr<Bytebuffer> _payload;
+
+	u32 _numAllocations = 0;
+};
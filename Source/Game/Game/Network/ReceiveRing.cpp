@@ -0,0 +1,32 @@
+#include "ReceiveRing.h"
+
+void ReceiveRing::Init(size_t capacity)
+{
+	_data.resize(capacity);
+
+	_writePosition = 0;
+	_releasePosition = 0;
+}
+
+bool ReceiveRing::Reserve(u32 size, u64& position)
+{
+	u64 capacity = static_cast<u64>(_data.size());
+	if (size > capacity)
+		return false;
+
+	// Payloads are never split, one that doesn't fit before the end starts over at the beginning
+	u64 reservePosition = _writePosition;
+	u64 offset = reservePosition % capacity;
+	if (offset + size > capacity)
+	{
+		reservePosition += capacity - offset;
+	}
+
+	u64 endPosition = reservePosition + size;
+	if (endPosition - _releasePosition.load(std::memory_order_acquire) > capacity)
+		return false;
+
+	_writePosition = endPosition;
+	position = reservePosition;
+	return true;
+}
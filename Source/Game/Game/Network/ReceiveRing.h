@@ -0,0 +1,28 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <atomic>
+#include <vector>
+
+// Single producer, single consumer byte ring. The network thread copies payloads into it, so the game thread can dispatch them in place.
+// Positions only ever grow, space is reserved contiguously and has to be released in the order it was reserved
+class ReceiveRing
+{
+public:
+	void Init(size_t capacity);
+
+	// Producer, fails if the consumer hasn't released enough yet
+	bool Reserve(u32 size, u64& position);
+
+	// Consumer, frees everything up to endPosition
+	void Release(u64 endPosition) { _releasePosition.store(endPosition, std::memory_order_release); }
+
+	u8* GetData(u64 position) { return &_data[position % _data.size()]; }
+	size_t GetCapacity() const { return _data.size(); }
+
+private:
+	std::vector<u8> _data;
+
+	u64 _writePosition = 0;
+	std::atomic<u64> _releasePosition = 0;
+};
@@ -0,0 +1,190 @@
+#include "BodyPool.h"
+
+#include <Base/Util/DebugHandler.h>
+
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/Body.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+
+namespace Jolt
+{
+	void BodyPool::Init(JPH::PhysicsSystem* physicsSystem)
+	{
+		_physicsSystem = physicsSystem;
+	}
+
+	JPH::BodyID BodyPool::Acquire(const JPH::BodyCreationSettings& settings)
+	{
+		JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+
+		bool isStatic = settings.mMotionType == JPH::EMotionType::Static;
+		std::vector<JPH::BodyID>& pendingAdds = isStatic ? _pendingAdds : _pendingActivatedAdds;
+
+		u32 poolKey = GetPoolKey(settings.mMotionType, settings.mObjectLayer);
+
+		auto itr = _poolKeyToFreeBodies.find(poolKey);
+		if (itr != _poolKeyToFreeBodies.end() && itr->second.size() > 0)
+		{
+			JPH::BodyID bodyID = itr->second.back();
+			itr->second.pop_back();
+			_numPooledBodies--;
+
+			// The body is not in the broadphase, so changing it doesn't cause any broadphase updates
+			bodyInterface.SetShape(bodyID, settings.GetShape(), !isStatic, JPH::EActivation::DontActivate);
+			bodyInterface.SetPositionRotationAndVelocity(bodyID, settings.mPosition, settings.mRotation, JPH::Vec3::sZero(), JPH::Vec3::sZero());
+			{
+				JPH::BodyLockWrite lock(_physicsSystem->GetBodyLockInterface(), bodyID);
+				if (lock.Succeeded())
+				{
+					JPH::Body& body = lock.GetBody();
+					body.SetUserData(settings.mUserData);
+					body.SetFriction(settings.mFriction);
+					body.SetRestitution(settings.mRestitution);
+
+					if (JPH::MotionProperties* motionProperties = body.GetMotionPropertiesUnchecked())
+					{
+						motionProperties->SetLinearDamping(settings.mLinearDamping);
+						motionProperties->SetAngularDamping(settings.mAngularDamping);
+						motionProperties->SetGravityFactor(settings.mGravityFactor);
+					}
+				}
+			}
+
+			pendingAdds.push_back(bodyID);
+			_stats.numReused++;
+
+			return bodyID;
+		}
+
+		JPH::Body* body = bodyInterface.CreateBody(settings);
+		if (body == nullptr)
+		{
+			DebugHandler::PrintError("Physics : Failed to create body, we hit the limit of {0} bodies (see physics.maxBodies)", _physicsSystem->GetMaxBodies());
+			return JPH::BodyID();
+		}
+
+		JPH::BodyID bodyID = body->GetID();
+		pendingAdds.push_back(bodyID);
+		_stats.numCreated++;
+
+		return bodyID;
+	}
+
+	void BodyPool::Release(JPH::BodyID bodyID)
+	{
+		if (bodyID.IsInvalid())
+			return;
+
+		JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+		u32 poolKey = GetPoolKey(bodyInterface.GetMotionType(bodyID), bodyInterface.GetObjectLayer(bodyID));
+
+		_stats.numReleased++;
+
+		// The ID stays the same when the body is handed out again, so anything still holding it has to be able to tell it no longer belongs to its entity
+		{
+			JPH::BodyLockWrite lock(_physicsSystem->GetBodyLockInterface(), bodyID);
+			if (lock.Succeeded())
+			{
+				lock.GetBody().SetUserData(ReleasedUserData);
+			}
+		}
+
+		if (!bodyInterface.IsAdded(bodyID))
+		{
+			// Released in the same frame it was acquired, it never made it into the world so it can go straight back into the pool
+			for (std::vector<JPH::BodyID>* pendingAdds : { &_pendingActivatedAdds, &_pendingAdds })
+			{
+				auto itr = std::find(pendingAdds->begin(), pendingAdds->end(), bodyID);
+				if (itr != pendingAdds->end())
+				{
+					*itr = pendingAdds->back();
+					pendingAdds->pop_back();
+					break;
+				}
+			}
+
+			_poolKeyToFreeBodies[poolKey].push_back(bodyID);
+			_numPooledBodies++;
+			return;
+		}
+
+		_pendingRemoves.push_back({ bodyID, poolKey });
+	}
+
+	void BodyPool::Flush()
+	{
+		ZoneScoped;
+
+		if (_pendingRemoves.size() > 0)
+		{
+			_removeScratch.clear();
+			_removeScratch.reserve(_pendingRemoves.size());
+
+			for (const PendingRemove& pendingRemove : _pendingRemoves)
+			{
+				_removeScratch.push_back(pendingRemove.bodyID);
+			}
+
+			_physicsSystem->GetBodyInterface().RemoveBodies(_removeScratch.data(), static_cast<i32>(_removeScratch.size()));
+
+			for (const PendingRemove& pendingRemove : _pendingRemoves)
+			{
+				_poolKeyToFreeBodies[pendingRemove.poolKey].push_back(pendingRemove.bodyID);
+			}
+
+			_numPooledBodies += static_cast<u32>(_pendingRemoves.size());
+			_stats.numRemoved += static_cast<u32>(_pendingRemoves.size());
+			_pendingRemoves.clear();
+		}
+
+		AddBodies(_pendingActivatedAdds, true);
+		AddBodies(_pendingAdds, false);
+	}
+
+	void BodyPool::Clear()
+	{
+		Flush();
+
+		JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+		for (auto& pair : _poolKeyToFreeBodies)
+		{
+			std::vector<JPH::BodyID>& freeBodies = pair.second;
+			if (freeBodies.size() > 0)
+			{
+				bodyInterface.DestroyBodies(freeBodies.data(), static_cast<i32>(freeBodies.size()));
+			}
+		}
+
+		_poolKeyToFreeBodies.clear();
+		_numPooledBodies = 0;
+	}
+
+	BodyPool::Stats BodyPool::ConsumeStats()
+	{
+		Stats stats = _stats;
+		_stats = Stats();
+
+		return stats;
+	}
+
+	void BodyPool::AddBodies(std::vector<JPH::BodyID>& bodyIDs, bool activate)
+	{
+		if (bodyIDs.size() == 0)
+			return;
+
+		JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterface();
+		i32 numBodies = static_cast<i32>(bodyIDs.size());
+
+		// Prepare builds the broadphase tree for the new bodies on the side, Finalize then inserts it in one go
+		JPH::BodyInterface::AddState addState = bodyInterface.AddBodiesPrepare(bodyIDs.data(), numBodies);
+		bodyInterface.AddBodiesFinalize(bodyIDs.data(), numBodies, addState, activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+
+		_stats.numAdded += static_cast<u32>(numBodies);
+		bodyIDs.clear();
+	}
+}
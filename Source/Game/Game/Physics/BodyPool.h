@@ -0,0 +1,85 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/MotionType.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+
+#include <robinhood/robinhood.h>
+
+#include <limits>
+#include <vector>
+
+namespace JPH
+{
+	class BodyCreationSettings;
+	class PhysicsSystem;
+}
+
+namespace Jolt
+{
+	// Recycles bodies by removing them from the world instead of destroying them, and batches
+	// all broadphase insertions and removals of a frame into a single AddBodiesPrepare/Finalize and RemoveBodies
+	class BodyPool
+	{
+	public:
+		struct Stats
+		{
+			u32 numCreated = 0;
+			u32 numReused = 0;
+			u32 numReleased = 0;
+			u32 numAdded = 0;
+			u32 numRemoved = 0;
+		};
+
+	public:
+		// Released bodies get this as their user data until they are acquired again, it doesn't map to any entity
+		static constexpr u64 ReleasedUserData = std::numeric_limits<u32>().max();
+
+	public:
+		void Init(JPH::PhysicsSystem* physicsSystem);
+
+		// Returns a body matching the settings, it is not part of the world until the next Flush
+		JPH::BodyID Acquire(const JPH::BodyCreationSettings& settings);
+
+		// The body gets removed from the world in the next Flush and is then kept around for reuse
+		void Release(JPH::BodyID bodyID);
+
+		// Performs the queued insertions and removals, must be called while the simulation is not stepping
+		void Flush();
+
+		// Destroys all bodies that are currently waiting to be reused
+		void Clear();
+
+		u32 GetNumPooledBodies() const { return _numPooledBodies; }
+		u32 GetNumPendingAdds() const { return static_cast<u32>(_pendingActivatedAdds.size() + _pendingAdds.size()); }
+
+		// Returns the stats since the last call to this function
+		Stats ConsumeStats();
+
+	private:
+		static u32 GetPoolKey(JPH::EMotionType motionType, JPH::ObjectLayer objectLayer) { return (static_cast<u32>(motionType) << 16) | static_cast<u32>(objectLayer); }
+
+		void AddBodies(std::vector<JPH::BodyID>& bodyIDs, bool activate);
+
+	private:
+		struct PendingRemove
+		{
+			JPH::BodyID bodyID;
+			u32 poolKey;
+		};
+
+		JPH::PhysicsSystem* _physicsSystem = nullptr;
+
+		robin_hood::unordered_map<u32, std::vector<JPH::BodyID>> _poolKeyToFreeBodies;
+		u32 _numPooledBodies = 0;
+
+		std::vector<JPH::BodyID> _pendingActivatedAdds;
+		std::vector<JPH::BodyID> _pendingAdds;
+		std::vector<PendingRemove> _pendingRemoves;
+		std::vector<JPH::BodyID> _removeScratch;
+
+		Stats _stats;
+	};
+}
@@ -0,0 +1,169 @@
+#include "ChunkCollisionBenchmark.h"
+#include "SceneQuery.h"
+#include "Game/ECS/Singletons/JoltState.h"
+#include "Game/Rendering/Model/ModelLoader.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <vector>
+
+namespace Jolt
+{
+	static constexpr f32 CHUNK_BENCHMARK_OVERLAP_RADIUS = 2.0f;
+
+	struct ChunkQueryTimes
+	{
+		f64 rayUS = 0.0;
+		f64 overlapUS = 0.0;
+		u32 numRayHits = 0;
+	};
+
+	static void RunChunkQueries(SceneQuery& sceneQuery, const std::vector<RayQuery>& rays, const std::vector<SphereOverlapQuery>& overlaps, ChunkQueryTimes& times)
+	{
+		u32 numQueries = static_cast<u32>(rays.size());
+
+		std::vector<RayHit> hits(numQueries);
+		std::vector<OverlapResult> overlapResults;
+		std::vector<OverlapHit> overlapHits;
+
+		Timer timer;
+		sceneQuery.CastRays(rays.data(), numQueries, hits.data());
+		f64 rayTime = timer.GetLifeTime();
+
+		sceneQuery.OverlapSpheres(overlaps.data(), numQueries, 64, overlapResults, overlapHits);
+		f64 overlapTime = timer.GetLifeTime() - rayTime;
+
+		times.rayUS = rayTime * 1000000.0 / numQueries;
+		times.overlapUS = overlapTime * 1000000.0 / numQueries;
+
+		for (const RayHit& hit : hits)
+		{
+			times.numRayHits += hit.IsHit();
+		}
+	}
+
+	bool RunChunkCollisionBenchmark(ECS::Singletons::JoltState& joltState, ModelLoader& modelLoader, u32 numQueries, ChunkCollisionBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = ChunkCollisionBenchmarkResult();
+
+		if (numQueries == 0)
+			return false;
+
+		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+		const JPH::BodyLockInterfaceNoLock& bodyLockInterface = joltState.physicsSystem.GetBodyLockInterfaceNoLock();
+
+		// The densest chunk is the one the compound is meant for
+		const JPH::Body* chunkBody = nullptr;
+		for (const auto& pair : modelLoader.GetChunkCollisionBodyIDs())
+		{
+			const JPH::Body* body = bodyLockInterface.TryGetBody(JPH::BodyID(pair.second));
+			if (body == nullptr)
+				continue;
+
+			const JPH::StaticCompoundShape* shape = static_cast<const JPH::StaticCompoundShape*>(body->GetShape());
+			u32 numSubShapes = shape->GetNumSubShapes();
+
+			if (chunkBody == nullptr || numSubShapes > result.numSubShapes)
+			{
+				chunkBody = body;
+				result.chunkID = pair.first;
+				result.numSubShapes = numSubShapes;
+			}
+		}
+
+		if (chunkBody == nullptr)
+			return false;
+
+		JPH::AABox bounds = chunkBody->GetWorldSpaceBounds();
+		JPH::Vec3 boundsMin = JPH::Vec3(bounds.mMin);
+		JPH::Vec3 boundsSize = JPH::Vec3(bounds.mMax) - boundsMin;
+
+		// Spread both kinds of queries over a grid covering the chunk
+		u32 gridSize = static_cast<u32>(glm::ceil(glm::sqrt(static_cast<f32>(numQueries))));
+
+		std::vector<RayQuery> rays(numQueries);
+		std::vector<SphereOverlapQuery> overlaps(numQueries);
+
+		for (u32 i = 0; i < numQueries; i++)
+		{
+			f32 u = (static_cast<f32>(i % gridSize) + 0.5f) / gridSize;
+			f32 v = (static_cast<f32>(i / gridSize) + 0.5f) / gridSize;
+
+			f32 x = boundsMin.GetX() + boundsSize.GetX() * u;
+			f32 z = boundsMin.GetZ() + boundsSize.GetZ() * v;
+
+			rays[i].origin = vec3(x, bounds.mMax.GetY() + 1.0f, z);
+			rays[i].direction = vec3(0.0f, -(boundsSize.GetY() + 2.0f), 0.0f);
+
+			overlaps[i].center = vec3(x, boundsMin.GetY() + boundsSize.GetY() * 0.25f, z);
+			overlaps[i].radius = CHUNK_BENCHMARK_OVERLAP_RADIUS;
+		}
+
+		ChunkQueryTimes compoundTimes;
+		RunChunkQueries(joltState.sceneQuery, rays, overlaps, compoundTimes);
+
+		result.compoundRayUS = compoundTimes.rayUS;
+		result.compoundOverlapUS = compoundTimes.overlapUS;
+		result.compoundRayHits = compoundTimes.numRayHits;
+
+		// Put a body per sub shape where the compound was, the broadphase now has to sort through all of them
+		JPH::BodyID chunkBodyID = chunkBody->GetID();
+		JPH::RMat44 comTransform = chunkBody->GetCenterOfMassTransform();
+		const JPH::StaticCompoundShape* compoundShape = static_cast<const JPH::StaticCompoundShape*>(chunkBody->GetShape());
+
+		std::vector<JPH::BodyID> placementBodyIDs;
+		placementBodyIDs.reserve(result.numSubShapes);
+
+		Timer addTimer;
+
+		for (const JPH::CompoundShape::SubShape& subShape : compoundShape->GetSubShapes())
+		{
+			JPH::Quat rotation = comTransform.GetQuaternion() * subShape.GetRotation();
+			JPH::RVec3 position = comTransform * subShape.GetPositionCOM() - rotation * subShape.mShape->GetCenterOfMass();
+
+			JPH::BodyCreationSettings bodySettings(subShape.mShape, position, rotation, JPH::EMotionType::Static, Jolt::Layers::NON_MOVING);
+			bodySettings.mUserData = chunkBody->GetUserData();
+
+			JPH::Body* body = bodyInterface.CreateBody(bodySettings);
+			if (body == nullptr)
+				break;
+
+			placementBodyIDs.push_back(body->GetID());
+		}
+
+		// Inserted in one batch like a loader would, so the broadphase tree is as good as it gets without optimizing the whole world
+		if (placementBodyIDs.size() > 0)
+		{
+			JPH::BodyInterface::AddState addState = bodyInterface.AddBodiesPrepare(placementBodyIDs.data(), static_cast<i32>(placementBodyIDs.size()));
+			bodyInterface.AddBodiesFinalize(placementBodyIDs.data(), static_cast<i32>(placementBodyIDs.size()), addState, JPH::EActivation::DontActivate);
+		}
+
+		result.placementAddMS = addTimer.GetLifeTime() * 1000.0;
+
+		bodyInterface.RemoveBody(chunkBodyID);
+
+		ChunkQueryTimes placementTimes;
+		RunChunkQueries(joltState.sceneQuery, rays, overlaps, placementTimes);
+
+		result.placementRayUS = placementTimes.rayUS;
+		result.placementOverlapUS = placementTimes.overlapUS;
+		result.placementRayHits = placementTimes.numRayHits;
+
+		bodyInterface.AddBody(chunkBodyID, JPH::EActivation::DontActivate);
+
+		if (placementBodyIDs.size() > 0)
+		{
+			bodyInterface.RemoveBodies(placementBodyIDs.data(), static_cast<i32>(placementBodyIDs.size()));
+			bodyInterface.DestroyBodies(placementBodyIDs.data(), static_cast<i32>(placementBodyIDs.size()));
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <Base/Types.h>
+
+class ModelLoader;
+
+namespace ECS::Singletons
+{
+	struct JoltState;
+}
+
+namespace Jolt
+{
+	struct ChunkCollisionBenchmarkResult
+	{
+		u32 chunkID = 0;
+		u32 numSubShapes = 0;
+
+		// One static compound body for the whole chunk, as ModelLoader builds it
+		f64 compoundRayUS = 0.0;
+		f64 compoundOverlapUS = 0.0;
+		u32 compoundRayHits = 0;
+
+		// The same shapes as one static body per placement
+		f64 placementRayUS = 0.0;
+		f64 placementOverlapUS = 0.0;
+		u32 placementRayHits = 0;
+		f64 placementAddMS = 0.0;
+	};
+
+	// Picks the chunk with the most collision sub shapes and casts numQueries downward rays and 2m sphere overlaps spread over its bounds
+	// through the SceneQuery, once against its compound body and once against a temporary static body per placement in its place.
+	// Returns false if no chunk has collision, modelLoader.physics.enabled has to be on while the map loads.
+	bool RunChunkCollisionBenchmark(ECS::Singletons::JoltState& joltState, ModelLoader& modelLoader, u32 numQueries, ChunkCollisionBenchmarkResult& result);
+}
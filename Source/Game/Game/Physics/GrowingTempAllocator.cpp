@@ -0,0 +1,101 @@
+#include "GrowingTempAllocator.h"
+
+#include <Base/Util/DebugHandler.h>
+
+#include <Jolt/Math/Math.h>
+
+namespace Jolt
+{
+	GrowingTempAllocator::GrowingTempAllocator(size_t initialSize, size_t maxSize)
+	{
+		_maxSize = glm::max(maxSize, initialSize);
+		_size = JPH::AlignUp(initialSize, JPH_RVECTOR_ALIGNMENT);
+		_base = static_cast<u8*>(JPH::AlignedAllocate(_size, JPH_RVECTOR_ALIGNMENT));
+	}
+
+	GrowingTempAllocator::~GrowingTempAllocator()
+	{
+		JPH_ASSERT(_top == 0 && _usage == 0);
+		JPH::AlignedFree(_base);
+	}
+
+	void* GrowingTempAllocator::Allocate(JPH::uint inSize)
+	{
+		if (inSize == 0)
+			return nullptr;
+
+		size_t alignedSize = JPH::AlignUp(static_cast<size_t>(inSize), JPH_RVECTOR_ALIGNMENT);
+
+		void* address = nullptr;
+		if (_top + alignedSize <= _size)
+		{
+			address = _base + _top;
+			_top += alignedSize;
+		}
+		else
+		{
+			// The block is full, fall back to the heap for this update and grow the block afterwards
+			address = JPH::AlignedAllocate(alignedSize, JPH_RVECTOR_ALIGNMENT);
+			_numOverflowAllocations++;
+		}
+
+		_usage += alignedSize;
+		_updatePeak = glm::max(_updatePeak, _usage);
+
+		return address;
+	}
+
+	void GrowingTempAllocator::Free(void* inAddress, JPH::uint inSize)
+	{
+		if (inAddress == nullptr)
+		{
+			JPH_ASSERT(inSize == 0);
+			return;
+		}
+
+		size_t alignedSize = JPH::AlignUp(static_cast<size_t>(inSize), JPH_RVECTOR_ALIGNMENT);
+
+		u8* address = static_cast<u8*>(inAddress);
+		if (address >= _base && address < _base + _size)
+		{
+			_top -= alignedSize;
+			if (_base + _top != address)
+				JPH_CRASH; // Freeing in the wrong order
+		}
+		else
+		{
+			JPH::AlignedFree(inAddress);
+		}
+
+		_usage -= alignedSize;
+	}
+
+	void GrowingTempAllocator::EndUpdate()
+	{
+		JPH_ASSERT(_top == 0 && _usage == 0);
+
+		_lastUpdatePeak = _updatePeak;
+		_lastNumOverflowAllocations = _numOverflowAllocations;
+		_highWaterMark = glm::max(_highWaterMark, _updatePeak);
+
+		if (_updatePeak > _size && _size < _maxSize)
+		{
+			size_t newSize = 1;
+			while (newSize < _updatePeak)
+			{
+				newSize <<= 1;
+			}
+
+			newSize = JPH::AlignUp(glm::min(newSize, _maxSize), JPH_RVECTOR_ALIGNMENT);
+
+			DebugHandler::Print("Physics : Growing temp allocator from {0} KB to {1} KB", _size / 1024, newSize / 1024);
+
+			JPH::AlignedFree(_base);
+			_base = static_cast<u8*>(JPH::AlignedAllocate(newSize, JPH_RVECTOR_ALIGNMENT));
+			_size = newSize;
+		}
+
+		_updatePeak = 0;
+		_numOverflowAllocations = 0;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/TempAllocator.h>
+
+namespace Jolt
+{
+	// Stack allocator for Jolt's per update scratch memory that starts small instead of reserving the worst case up front.
+	// Allocations that don't fit in the block fall back to the heap, and the block is grown to the peak usage between updates.
+	class GrowingTempAllocator final : public JPH::TempAllocator
+	{
+	public:
+		JPH_OVERRIDE_NEW_DELETE
+
+		GrowingTempAllocator(size_t initialSize, size_t maxSize);
+		virtual ~GrowingTempAllocator() override;
+
+		virtual void* Allocate(JPH::uint inSize) override;
+		virtual void Free(void* inAddress, JPH::uint inSize) override;
+
+		// Must be called while nothing is allocated, grows the block if the last update needed more than it could hold
+		void EndUpdate();
+
+		size_t GetCapacity() const { return _size; }
+		size_t GetMaxCapacity() const { return _maxSize; }
+
+		// These describe the last update that finished with EndUpdate
+		size_t GetUpdatePeak() const { return _lastUpdatePeak; }
+		u32 GetNumOverflowAllocations() const { return _lastNumOverflowAllocations; }
+		size_t GetHighWaterMark() const { return _highWaterMark; }
+
+	private:
+		u8* _base = nullptr;
+		size_t _size = 0;
+		size_t _maxSize = 0;
+		size_t _top = 0;
+
+		size_t _usage = 0;
+		size_t _updatePeak = 0;
+		size_t _lastUpdatePeak = 0;
+		size_t _highWaterMark = 0;
+		u32 _numOverflowAllocations = 0;
+		u32 _lastNumOverflowAllocations = 0;
+	};
+}
@@ -0,0 +1,63 @@
+#include "RaycastBenchmark.h"
+#include "SceneQuery.h"
+#include "Game/ECS/Singletons/JoltState.h"
+
+#include <Base/Util/Timer.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <vector>
+
+namespace Jolt
+{
+	void RunRaycastBenchmark(ECS::Singletons::JoltState& joltState, const vec3& origin, u32 numRays, RaycastBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = RaycastBenchmarkResult();
+
+		if (numRays == 0)
+			return;
+
+		// Spread the rays over a square grid around the origin, all pointing straight down
+		constexpr f32 spacing = 0.5f;
+		constexpr f32 rayLength = 500.0f;
+
+		u32 gridSize = static_cast<u32>(glm::ceil(glm::sqrt(static_cast<f32>(numRays))));
+		f32 halfGridExtent = static_cast<f32>(gridSize) * spacing * 0.5f;
+
+		std::vector<RayQuery> rays(numRays);
+		for (u32 i = 0; i < numRays; i++)
+		{
+			f32 x = static_cast<f32>(i % gridSize) * spacing - halfGridExtent;
+			f32 z = static_cast<f32>(i / gridSize) * spacing - halfGridExtent;
+
+			rays[i].origin = origin + vec3(x, rayLength * 0.5f, z);
+			rays[i].direction = vec3(0.0f, -rayLength, 0.0f);
+		}
+
+		std::vector<RayHit> hits(numRays);
+		SceneQuery& sceneQuery = joltState.sceneQuery;
+
+		Timer timer;
+
+		for (u32 i = 0; i < numRays; i++)
+		{
+			sceneQuery.CastRay(rays[i], hits[i]);
+		}
+
+		f64 serialTime = timer.GetLifeTime();
+
+		sceneQuery.CastRays(rays.data(), numRays, hits.data());
+
+		f64 batchedTime = timer.GetLifeTime() - serialTime;
+
+		for (const RayHit& hit : hits)
+		{
+			result.numHits += hit.IsHit();
+		}
+
+		result.serialRaysPerSecond = serialTime > 0.0 ? static_cast<f64>(numRays) / serialTime : 0.0;
+		result.batchedRaysPerSecond = batchedTime > 0.0 ? static_cast<f64>(numRays) / batchedTime : 0.0;
+	}
+}
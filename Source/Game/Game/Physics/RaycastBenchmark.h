@@ -0,0 +1,21 @@
+#pragma once
+#include <Base/Types.h>
+
+namespace ECS::Singletons
+{
+	struct JoltState;
+}
+
+namespace Jolt
+{
+	struct RaycastBenchmarkResult
+	{
+		f64 serialRaysPerSecond = 0.0;
+		f64 batchedRaysPerSecond = 0.0;
+		u32 numHits = 0;
+	};
+
+	// Casts numRays rays downwards from around the origin position, once one at a time on the calling thread and once as a
+	// single batch through the SceneQuery. Must not run while the simulation is stepping.
+	void RunRaycastBenchmark(ECS::Singletons::JoltState& joltState, const vec3& origin, u32 numRays, RaycastBenchmarkResult& result);
+}
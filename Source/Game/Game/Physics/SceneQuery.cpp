@@ -0,0 +1,193 @@
+#include "SceneQuery.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+
+#include <enkiTS/TaskScheduler.h>
+#include <tracy/Tracy.hpp>
+
+namespace Jolt
+{
+	// Writes the unique bodies hit by a query straight into its slot of the flat hit buffer
+	class OverlapCollector : public JPH::CollideShapeCollector
+	{
+	public:
+		OverlapCollector(OverlapHit* hits, u32 maxHits, const JPH::BodyInterface& bodyInterface) : _hits(hits), _maxHits(maxHits), _bodyInterface(bodyInterface) { }
+
+		virtual void AddHit(const JPH::CollideShapeResult& inResult) override
+		{
+			u32 bodyID = inResult.mBodyID2.GetIndexAndSequenceNumber();
+
+			// Compound shapes report a hit per sub shape, we only care about the body
+			for (u32 i = 0; i < _numHits; i++)
+			{
+				if (_hits[i].bodyID == bodyID)
+					return;
+			}
+
+			OverlapHit& hit = _hits[_numHits++];
+			hit.bodyID = bodyID;
+			hit.userData = _bodyInterface.GetUserData(inResult.mBodyID2);
+
+			if (_numHits == _maxHits)
+			{
+				ForceEarlyOut();
+			}
+		}
+
+		u32 GetNumHits() const { return _numHits; }
+
+	private:
+		OverlapHit* _hits;
+		u32 _maxHits;
+		u32 _numHits = 0;
+
+		const JPH::BodyInterface& _bodyInterface;
+	};
+
+	void SceneQuery::Init(JPH::PhysicsSystem* physicsSystem)
+	{
+		_physicsSystem = physicsSystem;
+	}
+
+	void SceneQuery::CastRays(const RayQuery* rays, u32 numRays, RayHit* hits)
+	{
+		ZoneScoped;
+
+		if (numRays == 0)
+			return;
+
+		Timer timer;
+
+		const JPH::NarrowPhaseQuery& narrowPhaseQuery = _physicsSystem->GetNarrowPhaseQueryNoLock();
+		const JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterfaceNoLock();
+
+		enki::TaskScheduler* taskScheduler = ServiceLocator::GetTaskScheduler();
+
+		enki::TaskSet castTask(numRays, [&](enki::TaskSetPartition range, u32 threadNum)
+		{
+			for (u32 i = range.start; i < range.end; i++)
+			{
+				const RayQuery& ray = rays[i];
+				RayHit& hit = hits[i];
+
+				JPH::RRayCast rayCast(JPH::RVec3(ray.origin.x, ray.origin.y, ray.origin.z), JPH::Vec3(ray.direction.x, ray.direction.y, ray.direction.z));
+				JPH::RayCastResult result;
+
+				hit = RayHit();
+				if (narrowPhaseQuery.CastRay(rayCast, result))
+				{
+					hit.position = ray.origin + ray.direction * result.mFraction;
+					hit.fraction = result.mFraction;
+					hit.bodyID = result.mBodyID.GetIndexAndSequenceNumber();
+					hit.userData = bodyInterface.GetUserData(result.mBodyID);
+				}
+			}
+		});
+		castTask.m_MinRange = 64;
+
+		taskScheduler->AddTaskSetToPipe(&castTask);
+		taskScheduler->WaitforTask(&castTask);
+
+		AddStats(numRays, 0, timer.GetLifeTime() * 1000.0f);
+	}
+
+	bool SceneQuery::CastRay(const RayQuery& ray, RayHit& hit)
+	{
+		// A single ray isn't worth waking up the workers for
+		const JPH::NarrowPhaseQuery& narrowPhaseQuery = _physicsSystem->GetNarrowPhaseQueryNoLock();
+
+		JPH::RRayCast rayCast(JPH::RVec3(ray.origin.x, ray.origin.y, ray.origin.z), JPH::Vec3(ray.direction.x, ray.direction.y, ray.direction.z));
+		JPH::RayCastResult result;
+
+		hit = RayHit();
+		AddStats(1, 0, 0.0f);
+
+		if (!narrowPhaseQuery.CastRay(rayCast, result))
+			return false;
+
+		hit.position = ray.origin + ray.direction * result.mFraction;
+		hit.fraction = result.mFraction;
+		hit.bodyID = result.mBodyID.GetIndexAndSequenceNumber();
+		hit.userData = _physicsSystem->GetBodyInterfaceNoLock().GetUserData(result.mBodyID);
+
+		return true;
+	}
+
+	void SceneQuery::OverlapSpheres(const SphereOverlapQuery* queries, u32 numQueries, u32 maxHitsPerQuery, std::vector<OverlapResult>& results, std::vector<OverlapHit>& hits)
+	{
+		ZoneScoped;
+
+		results.resize(numQueries);
+		hits.resize(static_cast<size_t>(numQueries) * maxHitsPerQuery);
+
+		if (numQueries == 0 || maxHitsPerQuery == 0)
+			return;
+
+		Timer timer;
+
+		const JPH::NarrowPhaseQuery& narrowPhaseQuery = _physicsSystem->GetNarrowPhaseQueryNoLock();
+		const JPH::BodyInterface& bodyInterface = _physicsSystem->GetBodyInterfaceNoLock();
+
+		enki::TaskScheduler* taskScheduler = ServiceLocator::GetTaskScheduler();
+
+		// Every query owns a fixed slot in the hit buffer, so the workers never have to merge anything
+		enki::TaskSet overlapTask(numQueries, [&](enki::TaskSetPartition range, u32 threadNum)
+		{
+			JPH::CollideShapeSettings collideSettings;
+
+			for (u32 i = range.start; i < range.end; i++)
+			{
+				const SphereOverlapQuery& query = queries[i];
+
+				OverlapResult& result = results[i];
+				result.offset = i * maxHitsPerQuery;
+				result.count = 0;
+
+				if (query.radius <= 0.0f)
+					continue;
+
+				JPH::SphereShape sphereShape(query.radius);
+				sphereShape.SetEmbedded();
+
+				JPH::RMat44 transform = JPH::RMat44::sTranslation(JPH::RVec3(query.center.x, query.center.y, query.center.z));
+
+				OverlapCollector collector(&hits[result.offset], maxHitsPerQuery, bodyInterface);
+				narrowPhaseQuery.CollideShape(&sphereShape, JPH::Vec3::sReplicate(1.0f), transform, collideSettings, JPH::RVec3::sZero(), collector);
+
+				result.count = collector.GetNumHits();
+			}
+		});
+		overlapTask.m_MinRange = 16;
+
+		taskScheduler->AddTaskSetToPipe(&overlapTask);
+		taskScheduler->WaitforTask(&overlapTask);
+
+		AddStats(0, numQueries, timer.GetLifeTime() * 1000.0f);
+	}
+
+	SceneQuery::Stats SceneQuery::ConsumeStats()
+	{
+		Stats stats;
+		stats.numRays = _numRays.exchange(0);
+		stats.numOverlaps = _numOverlaps.exchange(0);
+		stats.timeMS = static_cast<f32>(_timeUS.exchange(0)) / 1000.0f;
+
+		return stats;
+	}
+
+	void SceneQuery::AddStats(u32 numRays, u32 numOverlaps, f32 timeMS)
+	{
+		_numRays += numRays;
+		_numOverlaps += numOverlaps;
+		_timeUS += static_cast<u64>(timeMS * 1000.0f);
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace JPH
+{
+	class PhysicsSystem;
+}
+
+namespace Jolt
+{
+	struct RayQuery
+	{
+	public:
+		vec3 origin = vec3(0.0f, 0.0f, 0.0f);
+		vec3 direction = vec3(0.0f, 0.0f, 0.0f); // The length of the direction is the distance of the ray
+	};
+
+	struct RayHit
+	{
+	public:
+		static constexpr u32 InvalidBodyID = std::numeric_limits<u32>().max();
+
+		bool IsHit() const { return bodyID != InvalidBodyID; }
+
+		vec3 position = vec3(0.0f, 0.0f, 0.0f);
+		f32 fraction = 1.0f;
+		u32 bodyID = InvalidBodyID;
+		u64 userData = 0;
+	};
+
+	struct SphereOverlapQuery
+	{
+	public:
+		vec3 center = vec3(0.0f, 0.0f, 0.0f);
+		f32 radius = 0.0f;
+	};
+
+	// The bodies overlapping a query are stored at [offset, offset + count) of the flat hit buffer
+	struct OverlapResult
+	{
+	public:
+		u32 offset = 0;
+		u32 count = 0;
+	};
+
+	struct OverlapHit
+	{
+	public:
+		u32 bodyID;
+		u64 userData;
+	};
+
+	// Runs batches of scene queries in parallel on the task scheduler against the world without taking body locks,
+	// so it must only be used while the simulation is not stepping and no bodies are being added or removed
+	class SceneQuery
+	{
+	public:
+		struct Stats
+		{
+			u32 numRays = 0;
+			u32 numOverlaps = 0;
+			f32 timeMS = 0.0f;
+		};
+
+	public:
+		void Init(JPH::PhysicsSystem* physicsSystem);
+
+		// Writes the closest hit of every ray into hits, which must have room for numRays results
+		void CastRays(const RayQuery* rays, u32 numRays, RayHit* hits);
+		bool CastRay(const RayQuery& ray, RayHit& hit);
+
+		// Collects up to maxHitsPerQuery bodies overlapping each sphere, results gets one entry per query
+		void OverlapSpheres(const SphereOverlapQuery* queries, u32 numQueries, u32 maxHitsPerQuery, std::vector<OverlapResult>& results, std::vector<OverlapHit>& hits);
+
+		// Returns the stats since the last call to this function
+		Stats ConsumeStats();
+
+	private:
+		void AddStats(u32 numRays, u32 numOverlaps, f32 timeMS);
+
+	private:
+		JPH::PhysicsSystem* _physicsSystem = nullptr;
+
+		// Queries can come from several script states at once
+		std::atomic<u32> _numRays = 0;
+		std::atomic<u32> _numOverlaps = 0;
+		std::atomic<u64> _timeUS = 0;
+	};
+}
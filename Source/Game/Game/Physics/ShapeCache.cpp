@@ -0,0 +1,92 @@
+#include "ShapeCache.h"
+
+#include <Base/Util/DebugHandler.h>
+
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+
+namespace Jolt
+{
+	JPH::ShapeRefC ShapeCache::GetBox(const vec3& halfExtents)
+	{
+		u64 key = 0;
+		if (!GetBoxKey(halfExtents, key))
+			return CreateBox(halfExtents);
+
+		std::scoped_lock lock(_mutex);
+
+		auto itr = _keyToShape.find(key);
+		if (itr != _keyToShape.end())
+		{
+			_numHits++;
+			return itr->second;
+		}
+
+		JPH::ShapeRefC shape = CreateBox(halfExtents);
+		if (shape == nullptr)
+			return nullptr;
+
+		_numMisses++;
+		_keyToShape[key] = shape;
+
+		return shape;
+	}
+
+	void ShapeCache::Clear()
+	{
+		std::scoped_lock lock(_mutex);
+
+		// Bodies keep their own reference, so this only drops the shapes nobody else is using
+		_keyToShape.clear();
+		_numHits = 0;
+		_numMisses = 0;
+	}
+
+	u32 ShapeCache::GetNumShapes()
+	{
+		std::scoped_lock lock(_mutex);
+		return static_cast<u32>(_keyToShape.size());
+	}
+
+	u32 ShapeCache::GetNumHits()
+	{
+		std::scoped_lock lock(_mutex);
+		return _numHits;
+	}
+
+	u32 ShapeCache::GetNumMisses()
+	{
+		std::scoped_lock lock(_mutex);
+		return _numMisses;
+	}
+
+	bool ShapeCache::GetBoxKey(const vec3& halfExtents, u64& key)
+	{
+		// Quantize to millimeters, 20 bits per axis covers half extents up to a kilometer, clamping anything larger would hand out the wrong box
+		constexpr f32 maxHalfExtent = 1000.0f;
+		constexpr u64 axisMask = (1ull << 20) - 1;
+
+		if (glm::any(glm::lessThan(halfExtents, vec3(0.0f))) || glm::any(glm::greaterThan(halfExtents, vec3(maxHalfExtent))))
+			return false;
+
+		u64 x = static_cast<u64>(halfExtents.x * 1000.0f + 0.5f) & axisMask;
+		u64 y = static_cast<u64>(halfExtents.y * 1000.0f + 0.5f) & axisMask;
+		u64 z = static_cast<u64>(halfExtents.z * 1000.0f + 0.5f) & axisMask;
+
+		key = (static_cast<u64>(ShapeType::Box) << 60) | (x << 40) | (y << 20) | z;
+		return true;
+	}
+
+	JPH::ShapeRefC ShapeCache::CreateBox(const vec3& halfExtents)
+	{
+		JPH::BoxShapeSettings shapeSettings(JPH::Vec3(halfExtents.x, halfExtents.y, halfExtents.z));
+
+		JPH::ShapeSettings::ShapeResult shapeResult = shapeSettings.Create();
+		if (shapeResult.HasError())
+		{
+			DebugHandler::PrintError("Physics : Failed to create box shape ({0}, {1}, {2}) : {3}", halfExtents.x, halfExtents.y, halfExtents.z, shapeResult.GetError().c_str());
+			return nullptr;
+		}
+
+		return shapeResult.Get();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include <robinhood/robinhood.h>
+
+#include <mutex>
+
+namespace Jolt
+{
+	// Hands out shared, refcounted shapes keyed by their parameters so bodies with the same dimensions only cook their shape once.
+	// Dimensions are quantized to millimeters, boxes with a half extent above a kilometer aren't cached.
+	class ShapeCache
+	{
+	public:
+		JPH::ShapeRefC GetBox(const vec3& halfExtents);
+
+		void Clear();
+
+		u32 GetNumShapes();
+		u32 GetNumHits();
+		u32 GetNumMisses();
+
+	private:
+		enum class ShapeType : u8
+		{
+			Box
+		};
+
+		// Returns false for boxes the key can't represent exactly enough, those are created without going through the cache
+		static bool GetBoxKey(const vec3& halfExtents, u64& key);
+		static JPH::ShapeRefC CreateBox(const vec3& halfExtents);
+
+	private:
+		std::mutex _mutex;
+		robin_hood::unordered_map<u64, JPH::ShapeRefC> _keyToShape;
+
+		u32 _numHits = 0;
+		u32 _numMisses = 0;
+	};
+}
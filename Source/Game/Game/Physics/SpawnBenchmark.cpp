@@ -0,0 +1,127 @@
+#include "SpawnBenchmark.h"
+#include "BodyPool.h"
+#include "ShapeCache.h"
+#include "Game/ECS/Singletons/JoltState.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+
+#include <tracy/Tracy.hpp>
+
+#include <vector>
+
+namespace Jolt
+{
+	static vec3 GetBenchmarkHalfExtents(u32 index)
+	{
+		// A handful of different sizes, like a few projectile or debris types would give us
+		f32 size = 0.25f + static_cast<f32>(index % 4) * 0.25f;
+		return vec3(size, size, size);
+	}
+
+	static JPH::RVec3 GetBenchmarkPosition(u32 index)
+	{
+		// Far away from the world and spaced out so the bodies don't touch anything
+		return JPH::RVec3(static_cast<f32>(index % 128) * 4.0f, 10000.0f, static_cast<f32>(index / 128) * 4.0f);
+	}
+
+	void RunSpawnBenchmark(ECS::Singletons::JoltState& joltState, u32 numBodies, u32 numRounds, SpawnBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = SpawnBenchmarkResult();
+
+		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+		std::vector<JPH::BodyID> bodyIDs;
+		bodyIDs.reserve(numBodies);
+
+		Timer timer;
+
+		// Naive, cook a shape, create and add a body per spawn and remove and destroy it per despawn
+		for (u32 round = 0; round < numRounds; round++)
+		{
+			f64 startTime = timer.GetLifeTime();
+
+			for (u32 i = 0; i < numBodies; i++)
+			{
+				vec3 halfExtents = GetBenchmarkHalfExtents(i);
+				JPH::BoxShapeSettings shapeSettings(JPH::Vec3(halfExtents.x, halfExtents.y, halfExtents.z));
+				JPH::ShapeRefC shape = shapeSettings.Create().Get();
+
+				JPH::BodyCreationSettings bodySettings(shape, GetBenchmarkPosition(i), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Jolt::Layers::MOVING);
+
+				JPH::Body* body = bodyInterface.CreateBody(bodySettings);
+				if (body == nullptr)
+					break;
+
+				bodyInterface.AddBody(body->GetID(), JPH::EActivation::Activate);
+				bodyIDs.push_back(body->GetID());
+			}
+
+			f64 spawnedTime = timer.GetLifeTime();
+
+			for (JPH::BodyID bodyID : bodyIDs)
+			{
+				bodyInterface.RemoveBody(bodyID);
+				bodyInterface.DestroyBody(bodyID);
+			}
+			bodyIDs.clear();
+
+			f64 despawnedTime = timer.GetLifeTime();
+
+			result.naiveSpawnMS += (spawnedTime - startTime) * 1000.0;
+			result.naiveDespawnMS += (despawnedTime - spawnedTime) * 1000.0;
+		}
+
+		// Pooled, shared shapes and recycled bodies with one batched broadphase insertion and removal per round
+		ShapeCache shapeCache;
+		BodyPool bodyPool;
+		bodyPool.Init(&joltState.physicsSystem);
+
+		for (u32 round = 0; round < numRounds; round++)
+		{
+			f64 startTime = timer.GetLifeTime();
+
+			for (u32 i = 0; i < numBodies; i++)
+			{
+				JPH::ShapeRefC shape = shapeCache.GetBox(GetBenchmarkHalfExtents(i));
+
+				JPH::BodyCreationSettings bodySettings(shape, GetBenchmarkPosition(i), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Jolt::Layers::MOVING);
+
+				JPH::BodyID bodyID = bodyPool.Acquire(bodySettings);
+				if (bodyID.IsInvalid())
+					break;
+
+				bodyIDs.push_back(bodyID);
+			}
+			bodyPool.Flush();
+
+			f64 spawnedTime = timer.GetLifeTime();
+
+			for (JPH::BodyID bodyID : bodyIDs)
+			{
+				bodyPool.Release(bodyID);
+			}
+			bodyPool.Flush();
+			bodyIDs.clear();
+
+			f64 despawnedTime = timer.GetLifeTime();
+
+			result.pooledSpawnMS += (spawnedTime - startTime) * 1000.0;
+			result.pooledDespawnMS += (despawnedTime - spawnedTime) * 1000.0;
+		}
+
+		result.numCachedShapes = shapeCache.GetNumShapes();
+		bodyPool.Clear();
+
+		if (numRounds > 0)
+		{
+			result.naiveSpawnMS /= numRounds;
+			result.naiveDespawnMS /= numRounds;
+			result.pooledSpawnMS /= numRounds;
+			result.pooledDespawnMS /= numRounds;
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <Base/Types.h>
+
+namespace ECS::Singletons
+{
+	struct JoltState;
+}
+
+namespace Jolt
+{
+	struct SpawnBenchmarkResult
+	{
+		f64 naiveSpawnMS = 0.0;
+		f64 naiveDespawnMS = 0.0;
+		f64 pooledSpawnMS = 0.0;
+		f64 pooledDespawnMS = 0.0;
+		u32 numCachedShapes = 0;
+	};
+
+	// Spawns and despawns numBodies dynamic boxes numRounds times, once by cooking a shape and creating a body per spawn
+	// and once through the ShapeCache and BodyPool, so the two can be compared. Must not run while the simulation is stepping.
+	void RunSpawnBenchmark(ECS::Singletons::JoltState& joltState, u32 numBodies, u32 numRounds, SpawnBenchmarkResult& result);
+}
@@ -0,0 +1,93 @@
+#include "SyncBenchmark.h"
+#include "Game/ECS/Components/Rigidbody.h"
+#include "Game/ECS/Components/Transform.h"
+#include "Game/ECS/Singletons/JoltState.h"
+#include "Game/ECS/Systems/UpdatePhysics.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+
+#include <entt/entt.hpp>
+#include <tracy/Tracy.hpp>
+
+namespace Jolt
+{
+	static constexpr u32 SYNC_BENCHMARK_MIN_BODIES = 512;
+
+	static JPH::RVec3 GetSyncBenchmarkPosition(u32 index)
+	{
+		// Far away from the world and spaced out so the bodies don't touch anything
+		return JPH::RVec3(static_cast<f32>(index % 128) * 4.0f, 20000.0f, static_cast<f32>(index / 128) * 4.0f);
+	}
+
+	void RunSyncBenchmark(ECS::Singletons::JoltState& joltState, u32 maxBodies, u32 numFrames, std::vector<SyncBenchmarkStep>& steps)
+	{
+		ZoneScoped;
+
+		steps.clear();
+
+		if (maxBodies == 0 || numFrames == 0)
+			return;
+
+		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+		JPH::ShapeRefC shape = joltState.shapeCache.GetBox(vec3(0.5f, 0.5f, 0.5f));
+		if (shape == nullptr)
+			return;
+
+		for (u32 numBodies = glm::min(SYNC_BENCHMARK_MIN_BODIES, maxBodies); ; numBodies = glm::min(numBodies * 2, maxBodies))
+		{
+			entt::registry registry;
+			std::vector<JPH::BodyID> bodyIDs;
+			bodyIDs.reserve(numBodies);
+
+			for (u32 i = 0; i < numBodies; i++)
+			{
+				entt::entity entity = registry.create();
+
+				JPH::BodyCreationSettings bodySettings(shape, GetSyncBenchmarkPosition(i), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Jolt::Layers::MOVING);
+				bodySettings.mUserData = static_cast<JPH::uint64>(entt::to_integral(entity));
+
+				JPH::Body* body = bodyInterface.CreateBody(bodySettings);
+				if (body == nullptr)
+					break;
+
+				bodyInterface.AddBody(body->GetID(), JPH::EActivation::Activate);
+				bodyIDs.push_back(body->GetID());
+
+				registry.emplace<ECS::Components::Transform>(entity);
+
+				ECS::Components::Rigidbody& rigidbody = registry.emplace<ECS::Components::Rigidbody>(entity);
+				rigidbody.bodyID = body->GetID().GetIndexAndSequenceNumber();
+			}
+
+			SyncBenchmarkStep& step = steps.emplace_back();
+			step.numBodies = static_cast<u32>(bodyIDs.size());
+
+			f64 totalMS = 0.0;
+			for (u32 frame = 0; frame < numFrames; frame++)
+			{
+				// CalculateTransformMatrices clears these every frame, so every sync starts without them like in the game
+				registry.clear<ECS::Components::DirtyTransform>();
+
+				Timer timer;
+				ECS::Systems::UpdatePhysics::SyncToECS(registry, joltState, 0.5f);
+				totalMS += timer.GetLifeTime() * 1000.0;
+			}
+
+			step.numActiveBodies = static_cast<u32>(joltState.activeBodyIDs.size());
+			step.syncMSPerFrame = totalMS / numFrames;
+
+			for (JPH::BodyID bodyID : bodyIDs)
+			{
+				bodyInterface.RemoveBody(bodyID);
+				bodyInterface.DestroyBody(bodyID);
+			}
+
+			// We hit the body limit of the world, larger counts would measure the same
+			if (bodyIDs.size() < numBodies || numBodies == maxBodies)
+				break;
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <vector>
+
+namespace ECS::Singletons
+{
+	struct JoltState;
+}
+
+namespace Jolt
+{
+	struct SyncBenchmarkStep
+	{
+		u32 numBodies = 0;
+		u32 numActiveBodies = 0; // Includes the bodies of the game world that were awake
+		f64 syncMSPerFrame = 0.0;
+	};
+
+	// Adds 512 active dynamic boxes with an entity each, doubling until maxBodies, and runs the physics to ECS sync numFrames times for every
+	// count without stepping the simulation. The entities live in a registry of their own. Must not run while the simulation is stepping.
+	void RunSyncBenchmark(ECS::Singletons::JoltState& joltState, u32 maxBodies, u32 numFrames, std::vector<SyncBenchmarkStep>& steps);
+}
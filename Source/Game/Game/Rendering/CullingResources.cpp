@@ -143,21 +143,7 @@ void CullingResourcesBase::SyncToGPU()
             }
 
             // (Re)create Culled DrawCall Bitmask buffer
-            if (_enableTwoStepCulling)
-            {
-                Renderer::BufferDesc desc;
-                desc.size = RenderUtils::CalcCullingBitmaskSize(_drawCalls.Size());
-                desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
-
-                for (u32 i = 0; i < _culledDrawCallsBitMaskBuffer.Num; i++)
-                {
-                    desc.name = _bufferNamePrefix + "CulledDrawCallsBitMaskBuffer" + std::to_string(i);
-                    _culledDrawCallsBitMaskBuffer.Get(i) = _renderer->CreateAndFillBuffer(_culledDrawCallsBitMaskBuffer.Get(i), desc, [](void* mappedMemory, size_t size)
-                    {
-                        memset(mappedMemory, 0, size);
-                    });
-                }
-            }
+            ResetCulledDrawCallsBitMask();
 
             // CulledDrawCallBuffer, one for each view
             {
@@ -188,6 +174,25 @@ void CullingResourcesBase::SyncToGPU()
     }
 }
 
+void CullingResourcesBase::ResetCulledDrawCallsBitMask()
+{
+    if (!_enableTwoStepCulling)
+        return;
+
+    Renderer::BufferDesc desc;
+    desc.size = RenderUtils::CalcCullingBitmaskSize(_drawCalls.Size());
+    desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
+
+    for (u32 i = 0; i < _culledDrawCallsBitMaskBuffer.Num; i++)
+    {
+        desc.name = _bufferNamePrefix + "CulledDrawCallsBitMaskBuffer" + std::to_string(i);
+        _culledDrawCallsBitMaskBuffer.Get(i) = _renderer->CreateAndFillBuffer(_culledDrawCallsBitMaskBuffer.Get(i), desc, [](void* mappedMemory, size_t size)
+        {
+            memset(mappedMemory, 0, size);
+        });
+    }
+}
+
 void CullingResourcesBase::Clear()
 {
     _drawCalls.Clear();
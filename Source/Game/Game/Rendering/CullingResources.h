@@ -27,6 +27,9 @@ public:
     virtual void Grow(u32 growthSize);
     virtual void FitBuffersAfterLoad();
 
+    // Clears last frame's visibility, needed whenever the drawcalls are reordered since the bitmask is indexed by drawcall
+    void ResetCulledDrawCallsBitMask();
+
     Renderer::GPUVector<Renderer::IndexedIndirectDraw>& GetDrawCalls() { return _drawCalls; }
     std::atomic<u32>& GetDrawCallsIndex() { return _drawCallsIndex; }
 
@@ -2,10 +2,13 @@
 #include "ModelRenderer.h"
 #include "Game/Animation/AnimationSystem.h"
 #include "Game/Application/EnttRegistries.h"
+#include "Game/ECS/Singletons/EngineStats.h"
 #include "Game/ECS/Singletons/JoltState.h"
 #include "Game/ECS/Components/Transform.h"
 #include "Game/ECS/Components/Name.h"
 #include "Game/ECS/Components/Model.h"
+#include "Game/Editor/ActionStack.h"
+#include "Game/Editor/EditorHandler.h"
 #include "Game/Rendering/GameRenderer.h"
 #include "Game/Rendering/Debug/DebugRenderer.h"
 #include "Game/Util/ServiceLocator.h"
@@ -13,12 +16,21 @@
 #include <Base/Memory/FileReader.h>
 #include <Base/Util/StringUtils.h>
 #include <Base/CVarSystem/CVarSystem.h>
+#include <Base/Util/Timer.h>
 
 #include <FileFormat/Novus/Map/Map.h>
 #include <FileFormat/Novus/Map/MapChunk.h>
 
 #include <entt/entt.hpp>
+#include <tracy/Tracy.hpp>
 
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/ConvexHullShape.h>
+#include <Jolt/Physics/Collision/Shape/ScaledShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <execution>
@@ -31,6 +43,10 @@ static const fs::path dataPath = fs::path("Data/");
 static const fs::path complexModelPath = dataPath / "ComplexModel/";
 
 AutoCVar_Int CVAR_ModelLoaderNumThreads("modelLoader.numThreads", "number of threads used for model loading, 0 = number of hardware threads", 0, CVarFlags::None);
+AutoCVar_Int CVAR_ModelLoaderPhysicsEnabled("modelLoader.physics.enabled", "enable building a static collision body per terrain chunk from the model placements in it", 1, CVarFlags::EditCheckbox);
+AutoCVar_Float CVAR_ModelLoaderPhysicsHullTolerance("modelLoader.physics.hullTolerance", "how far in meters a vertex may lie outside the simplified collision hull of its model", 0.1f);
+AutoCVar_Float CVAR_ModelLoaderPhysicsMinExtent("modelLoader.physics.minExtent", "placements whose largest world half extent is below this get no collision", 0.5f);
+AutoCVar_Int CVAR_ModelLoaderSortInstances("modelLoader.sortInstances", "sort instances by the morton code of their position after loading to improve culling locality", 1, CVarFlags::EditCheckbox);
 
 ModelLoader::ModelLoader(ModelRenderer* modelRenderer)
 	: _modelRenderer(modelRenderer)
@@ -112,6 +128,8 @@ void ModelLoader::Init()
 
 			discoveredModel.name = cModelPath;
 			discoveredModel.nameHash = StringUtils::fnv1a_32(cModelPath.c_str(), cModelPath.length());
+			discoveredModel.internedName = Util::StringInterner::Intern(cModelPath);
+			discoveredModel.internedFileName = Util::StringInterner::Intern(StringUtils::GetFileNameFromPath(cModelPath));
 
 			discoveredModels.enqueue(discoveredModel);
 		}
@@ -129,6 +147,7 @@ void ModelLoader::Init()
 	}
 
 	DebugHandler::Print("Found {0} models", _nameHashToDiscoveredModel.size());
+	DebugHandler::Print("ModelLoader : Interned {0} model names ({1} KB)", Util::StringInterner::GetNumStrings(), Util::StringInterner::GetMemoryUsage() / 1024);
 }
 
 void ModelLoader::Clear()
@@ -156,6 +175,14 @@ void ModelLoader::Clear()
 	_instanceIDToEntityID.clear();
 	_modelIDToNameHash.clear();
 
+	ClearChunkCollision();
+
+	_chunkIDToStaticPlacements.clear();
+	_instanceIDToStaticPlacement.clear();
+	_numStaticPlacements = 0;
+	_numPromotedPlacements = 0;
+	_isSortPending = false;
+
 	_modelRenderer->Clear();
 	ServiceLocator::GetAnimationSystem()->Clear();
 }
@@ -165,9 +192,25 @@ void ModelLoader::Update(f32 deltaTime)
 	// Count how many unique non-loaded request we have
 	u32 numDequeued = static_cast<u32>(_requests.try_dequeue_bulk(&_workingRequests[0], MAX_LOADS_PER_FRAME));
 	if (numDequeued == 0)
+	{
+		// Sorting re-uploads every instance and throws away the culling history, so it waits until the whole load streamed in
+		if (_isSortPending && _requests.size_approx() == 0)
+		{
+			_isSortPending = false;
+
+			if (CVAR_ModelLoaderSortInstances.Get())
+			{
+				SortInstances();
+			}
+
+			ReportNameMemory();
+		}
+
 		return;
+	}
 
 	ModelRenderer::ReserveInfo reserveInfo;
+	u32 numDynamicInstances = 0;
 
 	for (u32 i = 0; i < numDequeued; i++)
 	{
@@ -186,6 +229,7 @@ void ModelLoader::Update(f32 deltaTime)
 		// Only increment Instance Count & Drawcall Count if the model have vertices
 		{
 			reserveInfo.numInstances += 1 * isSupported;
+			numDynamicInstances += (request.chunkID == DYNAMIC_CHUNK_ID) * isSupported;
 			reserveInfo.numOpaqueDrawcalls += discoveredModel.modelHeader.numOpaqueRenderBatches * isSupported;
 			reserveInfo.numTransparentDrawcalls += discoveredModel.modelHeader.numTransparentRenderBatches * isSupported;
 			reserveInfo.numBones += discoveredModel.modelHeader.numBones * isSupported;
@@ -210,25 +254,30 @@ void ModelLoader::Update(f32 deltaTime)
 	_modelRenderer->Reserve(reserveInfo);
 	animationSystem->Reserve(reserveInfo.numModels, reserveInfo.numInstances, reserveInfo.numBones);
 
-	// Create entt entities
+	// Create entt entities, static placements don't get one
 	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
 	_createdEntities.clear();
-	_createdEntities.resize(reserveInfo.numInstances);
-	registry->create(_createdEntities.begin(), _createdEntities.end());
+	_createdEntities.resize(numDynamicInstances);
 
-	registry->insert<ECS::Components::DirtyTransform>(_createdEntities.begin(), _createdEntities.end());
-	registry->insert<ECS::Components::Transform>(_createdEntities.begin(), _createdEntities.end());
-	registry->insert<ECS::Components::Name>(_createdEntities.begin(), _createdEntities.end());
-	registry->insert<ECS::Components::Model>(_createdEntities.begin(), _createdEntities.end());
-	registry->insert<ECS::Components::AABB>(_createdEntities.begin(), _createdEntities.end());
-	registry->insert<ECS::Components::WorldAABB>(_createdEntities.begin(), _createdEntities.end());
+	if (numDynamicInstances > 0)
+	{
+		registry->create(_createdEntities.begin(), _createdEntities.end());
+
+		registry->insert<ECS::Components::DirtyTransform>(_createdEntities.begin(), _createdEntities.end());
+		registry->insert<ECS::Components::Transform>(_createdEntities.begin(), _createdEntities.end());
+		registry->insert<ECS::Components::Name>(_createdEntities.begin(), _createdEntities.end());
+		registry->insert<ECS::Components::Model>(_createdEntities.begin(), _createdEntities.end());
+		registry->insert<ECS::Components::AABB>(_createdEntities.begin(), _createdEntities.end());
+		registry->insert<ECS::Components::WorldAABB>(_createdEntities.begin(), _createdEntities.end());
+	}
 
-	std::atomic<u32> numCreatedInstances;
-	enki::TaskSet loadModelsTask(reserveInfo.numInstances, [&](enki::TaskSetPartition range, u32 threadNum)
+	std::atomic<u32> numCreatedInstances = 0;
+	enki::TaskSet loadModelsTask(numDequeued, [&](enki::TaskSetPartition range, u32 threadNum)
 	{
 		for (u32 i = range.start; i < range.end; i++)
 		{
 			LoadRequestInternal& request = _workingRequests[i];
+			_workingStaticResults[i] = StaticInstanceResult();
 
 			u32 placementHash = request.placement.nameHash;
 			if (!_nameHashToDiscoveredModel.contains(placementHash))
@@ -259,8 +308,15 @@ void ModelLoader::Update(f32 deltaTime)
 					continue;
 			}
 
-			u32 index = numCreatedInstances.fetch_add(1);
-			AddInstance(_createdEntities[index], request);
+			if (request.chunkID == DYNAMIC_CHUNK_ID)
+			{
+				u32 index = numCreatedInstances.fetch_add(1);
+				AddInstance(_createdEntities[index], request);
+			}
+			else
+			{
+				AddStaticInstance(request, _workingStaticResults[i]);
+			}
 		}
 	});
 
@@ -271,9 +327,50 @@ void ModelLoader::Update(f32 deltaTime)
 	// Destroy the entities we didn't use
 	registry->destroy(_createdEntities.begin() + numCreatedInstances.load(), _createdEntities.end());
 
+	// Append the static placements serially, this keeps the chunk tables free of locks
+	u32 numAddedStaticPlacements = 0;
+	_dirtyCollisionChunkIDs.clear();
+
+	for (u32 i = 0; i < numDequeued; i++)
+	{
+		const LoadRequestInternal& request = _workingRequests[i];
+		const StaticInstanceResult& result = _workingStaticResults[i];
+
+		if (request.chunkID == DYNAMIC_CHUNK_ID || result.instanceID == std::numeric_limits<u32>().max())
+			continue;
+
+		AddStaticPlacement(request, result);
+		numAddedStaticPlacements++;
+
+		if (_dirtyCollisionChunkIDs.size() == 0 || _dirtyCollisionChunkIDs.back() != request.chunkID)
+		{
+			_dirtyCollisionChunkIDs.push_back(request.chunkID);
+		}
+	}
+
+	if (numAddedStaticPlacements > 0)
+	{
+		DebugHandler::Print("ModelLoader : Added {0} static placements ({1} total, {2} entities in registry)", numAddedStaticPlacements, _numStaticPlacements, registry->alive());
+	}
+
+	// Chunks are usually loaded in one go, so this builds each chunk body once
+	if (CVAR_ModelLoaderPhysicsEnabled.Get())
+	{
+		std::sort(_dirtyCollisionChunkIDs.begin(), _dirtyCollisionChunkIDs.end());
+		_dirtyCollisionChunkIDs.erase(std::unique(_dirtyCollisionChunkIDs.begin(), _dirtyCollisionChunkIDs.end()), _dirtyCollisionChunkIDs.end());
+
+		for (u32 chunkID : _dirtyCollisionChunkIDs)
+		{
+			BuildChunkCollision(chunkID);
+		}
+	}
+
 	// Fit the buffers to the data we loaded
 	_modelRenderer->FitBuffersAfterLoad();
 	animationSystem->FitToBuffersAfterLoad();
+
+	// Only streamed in chunks are worth a resort, dynamic spawns move around anyway and would otherwise throw away the culling history every time one is spawned
+	_isSortPending |= numAddedStaticPlacements > 0;
 }
 
 void ModelLoader::LoadPlacement(const Terrain::Placement& placement)
@@ -284,6 +381,15 @@ void ModelLoader::LoadPlacement(const Terrain::Placement& placement)
 	_requests.enqueue(loadRequest);
 }
 
+void ModelLoader::LoadStaticPlacement(u32 chunkID, const Terrain::Placement& placement)
+{
+	LoadRequestInternal loadRequest;
+	loadRequest.placement = placement;
+	loadRequest.chunkID = chunkID;
+
+	_requests.enqueue(loadRequest);
+}
+
 bool ModelLoader::GetModelIDFromInstanceID(u32 instanceID, u32& modelID)
 {
 	if (!_instanceIDToModelID.contains(instanceID))
@@ -302,6 +408,53 @@ bool ModelLoader::GetEntityIDFromInstanceID(u32 instanceID, entt::entity& entity
 	return true;
 }
 
+bool ModelLoader::GetOrPromoteEntityFromInstanceID(u32 instanceID, entt::entity& entityID)
+{
+	if (GetEntityIDFromInstanceID(instanceID, entityID))
+		return true;
+
+	auto itr = _instanceIDToStaticPlacement.find(instanceID);
+	if (itr == _instanceIDToStaticPlacement.end())
+		return false;
+
+	StaticPlacementRef placementRef = itr->second;
+	StaticPlacementTable& table = _chunkIDToStaticPlacements[placementRef.chunkID];
+	u32 index = placementRef.index;
+
+	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+	entityID = registry->create();
+
+	ECS::Components::Transform& transform = registry->emplace<ECS::Components::Transform>(entityID);
+	transform.position = table.positions[index];
+	transform.rotation = table.rotations[index];
+	transform.scale = vec3(table.scales[index]);
+	transform.matrix = _modelRenderer->GetInstanceMatrix(instanceID);
+
+	u32 modelID = table.modelIDs[index];
+	DiscoveredModel& discoveredModel = GetDiscoveredModelFromModelID(modelID);
+
+	ECS::Components::Name& name = registry->emplace<ECS::Components::Name>(entityID);
+	name.name = discoveredModel.internedFileName;
+	name.fullName = discoveredModel.internedName;
+	name.nameHash = discoveredModel.nameHash;
+
+	ECS::Components::Model& model = registry->emplace<ECS::Components::Model>(entityID);
+	model.modelID = modelID;
+	model.instanceID = instanceID;
+
+	registry->emplace<ECS::Components::AABB>(entityID, _modelIDToAABB[modelID]);
+
+	ECS::Components::WorldAABB& worldAABB = registry->emplace<ECS::Components::WorldAABB>(entityID);
+	worldAABB.min = table.worldAABBMins[index];
+	worldAABB.max = table.worldAABBMaxs[index];
+
+	table.promotedEntities[index] = entityID;
+	_instanceIDToEntityID[instanceID] = entityID;
+	_numPromotedPlacements++;
+
+	return true;
+}
+
 ModelLoader::DiscoveredModel& ModelLoader::GetDiscoveredModelFromModelID(u32 modelID)
 {
 	if (!_modelIDToNameHash.contains(modelID))
@@ -365,9 +518,52 @@ bool ModelLoader::LoadRequest(const LoadRequestInternal& request)
 	Animation::AnimationSystem* animationSystem = ServiceLocator::GetAnimationSystem();
 	animationSystem->AddSkeleton(modelID, model);
 
+	// The vertices are only around while loading, so the collision is cooked now even if no chunk ends up using it
+	if (CVAR_ModelLoaderPhysicsEnabled.Get())
+	{
+		JPH::ShapeRefC collisionShape = CookCollisionHull(model);
+
+		std::scoped_lock lock(_modelIDToCollisionShapeMutex);
+		_modelIDToCollisionShape[modelID] = collisionShape;
+	}
+
 	return true;
 }
 
+JPH::ShapeRefC ModelLoader::CookCollisionHull(const Model::ComplexModel& model)
+{
+	ZoneScoped;
+
+	// Building the hull is superlinear in the number of points, a spread out subset gives the same hull within the tolerance
+	constexpr u32 maxHullInputPoints = 2048;
+
+	u32 numVertices = static_cast<u32>(model.vertices.size());
+	u32 stride = glm::max((numVertices + maxHullInputPoints - 1) / maxHullInputPoints, 1u);
+
+	JPH::Array<JPH::Vec3> points;
+	points.reserve(numVertices / stride + 1);
+
+	for (u32 i = 0; i < numVertices; i += stride)
+	{
+		const Model::ComplexModel::Vertex& vertex = model.vertices[i];
+		points.push_back(JPH::Vec3(f32(vertex.position.x), f32(vertex.position.y), f32(vertex.position.z)));
+	}
+
+	if (points.size() < 4)
+		return nullptr;
+
+	// The tolerance is what simplifies the hull, Jolt drops every point that is within it of the hull of the others
+	JPH::ConvexHullShapeSettings hullSettings(points);
+	hullSettings.mHullTolerance = glm::max(CVAR_ModelLoaderPhysicsHullTolerance.GetFloat(), 0.001f);
+
+	// Flat models like decals have no volume and fail to build a hull, they get the box of their bounds instead
+	JPH::ShapeSettings::ShapeResult shapeResult = hullSettings.Create();
+	if (shapeResult.HasError())
+		return nullptr;
+
+	return shapeResult.Get();
+}
+
 void ModelLoader::AddInstance(entt::entity entityID, const LoadRequestInternal& request)
 {
 	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
@@ -389,12 +585,12 @@ void ModelLoader::AddInstance(entt::entity entityID, const LoadRequestInternal&
 
 	ECS::Components::Name& name = registry->get<ECS::Components::Name>(entityID);
 	DiscoveredModel& discoveredModel = _nameHashToDiscoveredModel[request.placement.nameHash];
-	name.name = StringUtils::GetFileNameFromPath(discoveredModel.name);
-	name.fullName = discoveredModel.name;
+	name.name = discoveredModel.internedFileName;
+	name.fullName = discoveredModel.internedName;
 	name.nameHash = discoveredModel.nameHash;
 
 	u32 modelID = _nameHashToModelID[request.placement.nameHash];
-	u32 instanceID = _modelRenderer->AddInstance(modelID, request.placement);
+	u32 instanceID = AddRenderInstance(modelID, request.placement);
 
 	ECS::Components::Model& model = registry->get<ECS::Components::Model>(entityID);
 	model.modelID = modelID;
@@ -407,12 +603,320 @@ void ModelLoader::AddInstance(entt::entity entityID, const LoadRequestInternal&
 	aabb.extents = modelAABB.extents;
 
 	std::scoped_lock lock(_instanceIDToModelIDMutex);
-	_instanceIDToModelID[instanceID] = modelID;
 	_instanceIDToEntityID[instanceID] = entityID;
+}
+
+void ModelLoader::AddStaticInstance(const LoadRequestInternal& request, StaticInstanceResult& result)
+{
+	u32 modelID = _nameHashToModelID[request.placement.nameHash];
+
+	result.modelID = modelID;
+	result.instanceID = AddRenderInstance(modelID, request.placement);
+}
+
+u32 ModelLoader::AddRenderInstance(u32 modelID, const Terrain::Placement& placement)
+{
+	u32 instanceID = _modelRenderer->AddInstance(modelID, placement);
+
+	{
+		std::scoped_lock lock(_instanceIDToModelIDMutex);
+		_instanceIDToModelID[instanceID] = modelID;
+	}
 
 	Animation::AnimationSystem* animationSystem = ServiceLocator::GetAnimationSystem();
 	if (animationSystem->AddInstance(modelID, instanceID))
 	{
 		animationSystem->PlayAnimation(instanceID, 0);
 	}
-}
\ No newline at end of file
+
+	return instanceID;
+}
+
+void ModelLoader::AddStaticPlacement(const LoadRequestInternal& request, const StaticInstanceResult& result)
+{
+	const Terrain::Placement& placement = request.placement;
+	const ECS::Components::AABB& modelAABB = _modelIDToAABB[result.modelID];
+	mat4x4 matrix = _modelRenderer->GetInstanceMatrix(result.instanceID);
+
+	// Calculate the world AABB once, static placements never need it recalculated
+	vec3 min = modelAABB.centerPos - modelAABB.extents;
+	vec3 max = modelAABB.centerPos + modelAABB.extents;
+
+	vec3 worldMin = vec3(std::numeric_limits<f32>().max());
+	vec3 worldMax = vec3(std::numeric_limits<f32>().lowest());
+
+	for (u32 i = 0; i < 8; i++)
+	{
+		vec3 corner = vec3((i & 4) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 1) ? max.z : min.z);
+		vec3 worldCorner = matrix * vec4(corner, 1.0f);
+
+		worldMin = glm::min(worldMin, worldCorner);
+		worldMax = glm::max(worldMax, worldCorner);
+	}
+
+	StaticPlacementTable& table = _chunkIDToStaticPlacements[request.chunkID];
+	u32 index = table.Size();
+
+	table.instanceIDs.push_back(result.instanceID);
+	table.modelIDs.push_back(result.modelID);
+	table.positions.push_back(placement.position);
+	table.rotations.push_back(placement.rotation);
+	table.scales.push_back(static_cast<f32>(placement.scale) / 1024.0f);
+	table.worldAABBMins.push_back(worldMin);
+	table.worldAABBMaxs.push_back(worldMax);
+	table.promotedEntities.push_back(entt::null);
+
+	_instanceIDToStaticPlacement[result.instanceID] = { request.chunkID, index };
+	_numStaticPlacements++;
+}
+
+void ModelLoader::BuildChunkCollision(u32 chunkID)
+{
+	ZoneScoped;
+
+	auto tableItr = _chunkIDToStaticPlacements.find(chunkID);
+	if (tableItr == _chunkIDToStaticPlacements.end())
+		return;
+
+	Timer timer;
+
+	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+	auto& joltState = registry->ctx().at<ECS::Singletons::JoltState>();
+	JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+
+	const StaticPlacementTable& table = tableItr->second;
+	f32 minExtent = CVAR_ModelLoaderPhysicsMinExtent.GetFloat();
+
+	// Every placement becomes a sub shape of a single static compound, so the broadphase sees one body per chunk
+	JPH::StaticCompoundShapeSettings compoundSettings;
+	u32 numSubShapes = 0;
+
+	vec3 chunkMin = vec3(std::numeric_limits<f32>().max());
+	vec3 chunkMax = vec3(std::numeric_limits<f32>().lowest());
+
+	for (u32 i = 0; i < table.Size(); i++)
+	{
+		vec3 worldHalfExtents = (table.worldAABBMaxs[i] - table.worldAABBMins[i]) * 0.5f;
+		if (glm::max(worldHalfExtents.x, glm::max(worldHalfExtents.y, worldHalfExtents.z)) < minExtent)
+			continue;
+
+		chunkMin = glm::min(chunkMin, table.worldAABBMins[i]);
+		chunkMax = glm::max(chunkMax, table.worldAABBMaxs[i]);
+	}
+
+	if (chunkMin.x > chunkMax.x)
+		return;
+
+	// Keep the sub shape positions relative to the middle of the chunk to not lose precision
+	vec3 chunkCenter = (chunkMin + chunkMax) * 0.5f;
+
+	for (u32 i = 0; i < table.Size(); i++)
+	{
+		vec3 worldHalfExtents = (table.worldAABBMaxs[i] - table.worldAABBMins[i]) * 0.5f;
+		if (glm::max(worldHalfExtents.x, glm::max(worldHalfExtents.y, worldHalfExtents.z)) < minExtent)
+			continue;
+
+		u32 modelID = table.modelIDs[i];
+
+		// The model files don't carry a separate collision mesh, each model gets a convex hull of its vertices simplified to
+		// modelLoader.physics.hullTolerance, cooked once when it was loaded and shared by every placement of it
+		JPH::ShapeRefC modelShape;
+		bool isHull = false;
+
+		auto shapeItr = _modelIDToCollisionShape.find(modelID);
+		if (shapeItr != _modelIDToCollisionShape.end() && shapeItr->second != nullptr)
+		{
+			modelShape = shapeItr->second;
+			isHull = true;
+		}
+		else
+		{
+			const ECS::Components::AABB& modelAABB = _modelIDToAABB[modelID];
+			vec3 halfExtents = glm::max(modelAABB.extents, vec3(0.05f));
+
+			modelShape = joltState.shapeCache.GetBox(halfExtents);
+		}
+
+		if (modelShape == nullptr)
+			continue;
+
+		const ECS::Components::AABB& modelAABB = _modelIDToAABB[modelID];
+		mat4x4 matrix = _modelRenderer->GetInstanceMatrix(table.instanceIDs[i]);
+
+		f32 scale = glm::length(vec3(matrix[0]));
+		quat rotation = glm::normalize(glm::quat_cast(mat3x3(matrix) / scale));
+
+		// Hulls are in model space, the fallback box is centered on the bounds
+		vec3 localOrigin = isHull ? vec3(0.0f, 0.0f, 0.0f) : modelAABB.centerPos;
+		vec3 position = vec3(matrix * vec4(localOrigin, 1.0f)) - chunkCenter;
+
+		JPH::ShapeRefC subShape = modelShape;
+		if (glm::abs(scale - 1.0f) > 0.001f)
+		{
+			subShape = new JPH::ScaledShape(modelShape, JPH::Vec3::sReplicate(scale));
+		}
+
+		compoundSettings.AddShape(JPH::Vec3(position.x, position.y, position.z), JPH::Quat(rotation.x, rotation.y, rotation.z, rotation.w), subShape);
+		numSubShapes++;
+	}
+
+	JPH::ShapeSettings::ShapeResult shapeResult = compoundSettings.Create();
+	if (shapeResult.HasError())
+	{
+		DebugHandler::PrintError("ModelLoader : Failed to build collision for chunk {0} : {1}", chunkID, shapeResult.GetError().c_str());
+		return;
+	}
+
+	// Replace the body the chunk had, if any
+	auto bodyItr = _chunkIDToCollisionBodyID.find(chunkID);
+	if (bodyItr != _chunkIDToCollisionBodyID.end())
+	{
+		JPH::BodyID bodyID = JPH::BodyID(bodyItr->second);
+		bodyInterface.RemoveBody(bodyID);
+		bodyInterface.DestroyBody(bodyID);
+
+		_numCollisionSubShapes -= _chunkIDToNumCollisionSubShapes[chunkID];
+		_chunkIDToCollisionBodyID.erase(bodyItr);
+	}
+
+	JPH::BodyCreationSettings bodySettings(shapeResult.Get(), JPH::RVec3(chunkCenter.x, chunkCenter.y, chunkCenter.z), JPH::Quat::sIdentity(), JPH::EMotionType::Static, Jolt::Layers::NON_MOVING);
+	bodySettings.mUserData = JPH::uint64(entt::to_integral(entt::entity(entt::null)));
+
+	JPH::Body* body = bodyInterface.CreateBody(bodySettings);
+	if (body == nullptr)
+	{
+		DebugHandler::PrintError("ModelLoader : Failed to create collision body for chunk {0}, we hit the limit of {1} bodies (see physics.maxBodies)", chunkID, joltState.physicsSystem.GetMaxBodies());
+		return;
+	}
+
+	JPH::BodyID bodyID = body->GetID();
+	bodyInterface.AddBody(bodyID, JPH::EActivation::DontActivate);
+
+	_chunkIDToCollisionBodyID[chunkID] = bodyID.GetIndexAndSequenceNumber();
+	_chunkIDToNumCollisionSubShapes[chunkID] = numSubShapes;
+	_numCollisionSubShapes += numSubShapes;
+
+	f32 timeSpentMS = timer.GetLifeTime() * 1000.0f;
+	DebugHandler::Print("ModelLoader : Built collision for chunk {0} from {1} of {2} placements in {3:.2f}ms ({4} chunk bodies, {5} sub shapes total)", chunkID, numSubShapes, table.Size(), timeSpentMS, _chunkIDToCollisionBodyID.size(), _numCollisionSubShapes);
+
+	auto& engineStats = registry->ctx().at<ECS::Singletons::EngineStats>();
+	engineStats.AddNamedStat("Chunk Collision Build MS", timeSpentMS);
+	engineStats.AddNamedStat("Chunk Collision Bodies", static_cast<f32>(_chunkIDToCollisionBodyID.size()));
+	engineStats.AddNamedStat("Chunk Collision Sub Shapes", static_cast<f32>(_numCollisionSubShapes));
+}
+
+void ModelLoader::ClearChunkCollision()
+{
+	if (_chunkIDToCollisionBodyID.size() > 0)
+	{
+		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+		auto& joltState = registry->ctx().at<ECS::Singletons::JoltState>();
+		JPH::BodyInterface& bodyInterface = joltState.physicsSystem.GetBodyInterface();
+
+		for (auto& pair : _chunkIDToCollisionBodyID)
+		{
+			JPH::BodyID bodyID = JPH::BodyID(pair.second);
+
+			bodyInterface.RemoveBody(bodyID);
+			bodyInterface.DestroyBody(bodyID);
+		}
+	}
+
+	_modelIDToCollisionShape.clear();
+	_chunkIDToCollisionBodyID.clear();
+	_chunkIDToNumCollisionSubShapes.clear();
+	_numCollisionSubShapes = 0;
+}
+
+void ModelLoader::ReportNameMemory()
+{
+	ZoneScoped;
+
+	entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+	auto& nameStorage = registry->storage<ECS::Components::Name>();
+
+	// What the same names took while every component owned a copy of both strings, short strings fit in the std::string itself
+	const size_t smallStringCapacity = std::string().capacity();
+	auto getOwnedBytes = [smallStringCapacity](Util::InternedString handle) -> size_t
+	{
+		size_t size = Util::StringInterner::Resolve(handle).size();
+		return sizeof(std::string) + (size > smallStringCapacity ? size + 1 : 0);
+	};
+
+	size_t ownedBytes = 0;
+	for (const ECS::Components::Name& name : nameStorage)
+	{
+		ownedBytes += getOwnedBytes(name.name) + getOwnedBytes(name.fullName) + sizeof(u32);
+	}
+
+	size_t internedBytes = nameStorage.size() * sizeof(ECS::Components::Name) + Util::StringInterner::GetMemoryUsage();
+
+	DebugHandler::Print("ModelLoader : {0} Name components use {1} KB including the interned strings, {2} KB with a copy of the strings each", nameStorage.size(), internedBytes / 1024, ownedBytes / 1024);
+}
+
+void ModelLoader::SortInstances()
+{
+	ZoneScoped;
+
+	Timer timer;
+	f32 meanDistanceBefore = _modelRenderer->CalculateMeanNeighborDistance();
+
+	std::vector<u32> oldToNewInstanceID;
+	if (!_modelRenderer->SortInstancesByMortonCode(oldToNewInstanceID))
+		return;
+
+	// Remap everything that refers to an InstanceID
+	{
+		robin_hood::unordered_map<u32, u32> instanceIDToModelID;
+		instanceIDToModelID.reserve(_instanceIDToModelID.size());
+		for (auto& [instanceID, modelID] : _instanceIDToModelID)
+		{
+			instanceIDToModelID[oldToNewInstanceID[instanceID]] = modelID;
+		}
+		_instanceIDToModelID.swap(instanceIDToModelID);
+
+		robin_hood::unordered_map<u32, StaticPlacementRef> instanceIDToStaticPlacement;
+		instanceIDToStaticPlacement.reserve(_instanceIDToStaticPlacement.size());
+		for (auto& [instanceID, placementRef] : _instanceIDToStaticPlacement)
+		{
+			instanceIDToStaticPlacement[oldToNewInstanceID[instanceID]] = placementRef;
+		}
+		_instanceIDToStaticPlacement.swap(instanceIDToStaticPlacement);
+
+		for (auto& [chunkID, table] : _chunkIDToStaticPlacements)
+		{
+			for (u32& instanceID : table.instanceIDs)
+			{
+				instanceID = oldToNewInstanceID[instanceID];
+			}
+		}
+
+		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+
+		robin_hood::unordered_map<u32, entt::entity> instanceIDToEntityID;
+		instanceIDToEntityID.reserve(_instanceIDToEntityID.size());
+		for (auto& [instanceID, entityID] : _instanceIDToEntityID)
+		{
+			u32 newInstanceID = oldToNewInstanceID[instanceID];
+			instanceIDToEntityID[newInstanceID] = entityID;
+
+			if (ECS::Components::Model* model = registry->try_get<ECS::Components::Model>(entityID))
+			{
+				model->instanceID = newInstanceID;
+			}
+		}
+		_instanceIDToEntityID.swap(instanceIDToEntityID);
+
+		ServiceLocator::GetAnimationSystem()->RemapInstanceIDs(oldToNewInstanceID);
+
+		if (Editor::EditorHandler* editorHandler = ServiceLocator::GetEditorHandler())
+		{
+			editorHandler->GetActionStackEditor()->RemapInstanceIDs(oldToNewInstanceID);
+		}
+	}
+
+	f32 meanDistanceAfter = _modelRenderer->CalculateMeanNeighborDistance();
+	f32 timeSpentMS = timer.GetLifeTime() * 1000.0f;
+
+	DebugHandler::Print("ModelLoader : Sorted {0} instances in {1:.2f}ms, mean distance between neighboring instances went from {2:.2f} to {3:.2f}", oldToNewInstanceID.size(), timeSpentMS, meanDistanceBefore, meanDistanceAfter);
+}
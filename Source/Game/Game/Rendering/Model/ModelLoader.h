@@ -1,5 +1,6 @@
 #pragma once
 #include <Game/ECS/Components/AABB.h>
+#include <Game/Util/StringInterner.h>
 
 #include <Base/Types.h>
 #include <Base/Container/ConcurrentQueue.h>
@@ -13,6 +14,11 @@
 #include <robinhood/robinhood.h>
 #include <type_safe/strong_typedef.hpp>
 
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include <limits>
+
 class ModelRenderer;
 class ModelLoader
 {
@@ -30,13 +36,47 @@ public:
 	{
 		std::string name;
 		u32 nameHash;
+		Util::InternedString internedName;
+		Util::InternedString internedFileName;
 		Model::ComplexModel::ModelHeader modelHeader;
 	};
 
+	// Placements that come from map chunks never move, so they are kept out of the registry
+	// and stored in an immutable SoA table per chunk. They get promoted to an entity on demand.
+	struct StaticPlacementTable
+	{
+	public:
+		std::vector<u32> instanceIDs;
+		std::vector<u32> modelIDs;
+		std::vector<vec3> positions;
+		std::vector<quat> rotations;
+		std::vector<f32> scales;
+		std::vector<vec3> worldAABBMins;
+		std::vector<vec3> worldAABBMaxs;
+		std::vector<entt::entity> promotedEntities;
+
+		u32 Size() const { return static_cast<u32>(instanceIDs.size()); }
+	};
+
 private:
+	static constexpr u32 DYNAMIC_CHUNK_ID = std::numeric_limits<u32>().max();
+
 	struct LoadRequestInternal
 	{
 		Terrain::Placement placement;
+		u32 chunkID = DYNAMIC_CHUNK_ID;
+	};
+
+	struct StaticInstanceResult
+	{
+		u32 instanceID = std::numeric_limits<u32>().max();
+		u32 modelID = std::numeric_limits<u32>().max();
+	};
+
+	struct StaticPlacementRef
+	{
+		u32 chunkID;
+		u32 index;
 	};
 
 public:
@@ -47,15 +87,32 @@ public:
 	void Update(f32 deltaTime);
 
 	void LoadPlacement(const Terrain::Placement& placement);
+	void LoadStaticPlacement(u32 chunkID, const Terrain::Placement& placement);
 
 	bool GetModelIDFromInstanceID(u32 instanceID, u32& modelID);
 	bool GetEntityIDFromInstanceID(u32 instanceID, entt::entity& entityID);
+	bool GetOrPromoteEntityFromInstanceID(u32 instanceID, entt::entity& entityID);
+
+	const robin_hood::unordered_map<u32, StaticPlacementTable>& GetStaticPlacementTables() { return _chunkIDToStaticPlacements; }
+	u32 GetNumStaticPlacements() { return _numStaticPlacements; }
+	u32 GetNumPromotedPlacements() { return _numPromotedPlacements; }
+	u32 GetNumCollisionChunks() { return static_cast<u32>(_chunkIDToCollisionBodyID.size()); }
+	const robin_hood::unordered_map<u32, u32>& GetChunkCollisionBodyIDs() { return _chunkIDToCollisionBodyID; }
+	u32 GetNumCollisionSubShapes() { return _numCollisionSubShapes; }
 
 	DiscoveredModel& GetDiscoveredModelFromModelID(u32 modelID);
 
 private:
 	bool LoadRequest(const LoadRequestInternal& request);
 	void AddInstance(entt::entity entityID, const LoadRequestInternal& request);
+	void AddStaticInstance(const LoadRequestInternal& request, StaticInstanceResult& result);
+	u32 AddRenderInstance(u32 modelID, const Terrain::Placement& placement);
+	void AddStaticPlacement(const LoadRequestInternal& request, const StaticInstanceResult& result);
+	static JPH::ShapeRefC CookCollisionHull(const Model::ComplexModel& model);
+	void BuildChunkCollision(u32 chunkID);
+	void ClearChunkCollision();
+	void SortInstances();
+	void ReportNameMemory();
 
 private:
 	enki::TaskScheduler _scheduler;
@@ -77,4 +134,18 @@ private:
 	robin_hood::unordered_map<u32, ECS::Components::AABB> _modelIDToAABB;
 
 	std::vector<entt::entity> _createdEntities;
+	StaticInstanceResult _workingStaticResults[MAX_LOADS_PER_FRAME];
+
+	robin_hood::unordered_map<u32, StaticPlacementTable> _chunkIDToStaticPlacements;
+	robin_hood::unordered_map<u32, StaticPlacementRef> _instanceIDToStaticPlacement;
+	u32 _numStaticPlacements = 0;
+	bool _isSortPending = false;
+	u32 _numPromotedPlacements = 0;
+
+	std::mutex _modelIDToCollisionShapeMutex;
+	robin_hood::unordered_map<u32, JPH::ShapeRefC> _modelIDToCollisionShape;
+	robin_hood::unordered_map<u32, u32> _chunkIDToCollisionBodyID;
+	robin_hood::unordered_map<u32, u32> _chunkIDToNumCollisionSubShapes;
+	std::vector<u32> _dirtyCollisionChunkIDs;
+	u32 _numCollisionSubShapes = 0;
 };
\ No newline at end of file
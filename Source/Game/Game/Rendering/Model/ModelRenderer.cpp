@@ -7,11 +7,13 @@
 #include <Game/Rendering/Debug/DebugRenderer.h>
 #include <Game/Util/ServiceLocator.h>
 #include <Game/Application/EnttRegistries.h>
+#include <Game/ECS/Singletons/EngineStats.h>
 #include <Game/ECS/Singletons/TextureSingleton.h>
 #include <Game/ECS/Components/Transform.h>
 #include <Game/ECS/Components/Model.h>
 
 #include <Base/CVarSystem/CVarSystem.h>
+#include <Base/Util/Timer.h>
 
 #include <FileFormat/Novus/Map/MapChunk.h>
 
@@ -23,6 +25,7 @@
 
 #include <imgui/imgui.h>
 #include <entt/entt.hpp>
+#include <enkiTS/TaskScheduler.h>
 #include <glm/gtx/euler_angles.hpp>
 
 AutoCVar_Int CVAR_ModelRendererEnabled("modelRenderer.enabled", "enable modelrendering", 1, CVarFlags::EditCheckbox);
@@ -59,16 +62,8 @@ void ModelRenderer::Update(f32 deltaTime)
 
     entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
 
-    registry->view<ECS::Components::Transform, ECS::Components::Model, ECS::Components::DirtyTransform>().each([&](entt::entity entity, ECS::Components::Transform& transform, ECS::Components::Model& model, ECS::Components::DirtyTransform& dirtyTransform)
-    {
-        u32 instanceID = model.instanceID;
-
-        std::vector<mat4x4>& instanceMatrices = _instanceMatrices.Get();
-        mat4x4& matrix = instanceMatrices[instanceID];
-
-        matrix = transform.matrix;
-        _instanceMatrices.SetDirtyElement(instanceID);
-    });
+    CollectDirtyInstanceTransforms(*registry);
+    SyncDirtyInstanceTransforms();
 
     const bool cullingEnabled = CVAR_ModelCullingEnabled.Get();
     _opaqueCullingResources.Update(deltaTime, cullingEnabled);
@@ -95,9 +90,11 @@ void ModelRenderer::Clear()
     _indicesIndex.store(0);
 
     _instanceDatas.Clear();
-    _instanceMatrices.Clear();
+    _instanceTransforms.Clear();
     _instanceIndex.store(0);
 
+    _dirtyInstanceIDs.clear();
+
     _textureUnits.Clear();
     _textureUnitIndex.store(0);
 
@@ -161,7 +158,7 @@ void ModelRenderer::AddOccluderPass(Renderer::RenderGraph* renderGraph, RenderRe
             builder.Read(_indices.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_textureUnits.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_instanceDatas.GetBuffer(), BufferUsage::GRAPHICS);
-            builder.Read(_instanceMatrices.GetBuffer(), BufferUsage::GRAPHICS);
+            builder.Read(_instanceTransforms.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_boneMatrices.GetBuffer(), BufferUsage::GRAPHICS | BufferUsage::COMPUTE);
             builder.Read(_opaqueCullingResources.GetDrawCallDatas().GetBuffer(), BufferUsage::GRAPHICS);
 
@@ -260,7 +257,7 @@ void ModelRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderRes
             data.prevCulledDrawCallsBitMask = builder.Read(_opaqueCullingResources.GetCulledDrawCallsBitMaskBuffer(!frameIndex), BufferUsage::COMPUTE);
             builder.Read(resources.cameras.GetBuffer(), BufferUsage::COMPUTE);
             builder.Read(_cullingDatas.GetBuffer(), BufferUsage::COMPUTE);
-            builder.Read(_instanceMatrices.GetBuffer(), BufferUsage::COMPUTE);
+            builder.Read(_instanceTransforms.GetBuffer(), BufferUsage::COMPUTE);
             builder.Read(_opaqueCullingResources.GetDrawCalls().GetBuffer(), BufferUsage::COMPUTE);
             builder.Read(_opaqueCullingResources.GetDrawCallDatas().GetBuffer(), BufferUsage::COMPUTE);
 
@@ -357,7 +354,7 @@ void ModelRenderer::AddGeometryPass(Renderer::RenderGraph* renderGraph, RenderRe
             builder.Read(_indices.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_textureUnits.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_instanceDatas.GetBuffer(), BufferUsage::GRAPHICS);
-            builder.Read(_instanceMatrices.GetBuffer(), BufferUsage::GRAPHICS);
+            builder.Read(_instanceTransforms.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_boneMatrices.GetBuffer(), BufferUsage::GRAPHICS | BufferUsage::COMPUTE);
             builder.Read(_opaqueCullingResources.GetDrawCalls().GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_opaqueCullingResources.GetDrawCallDatas().GetBuffer(), BufferUsage::GRAPHICS);
@@ -451,7 +448,7 @@ void ModelRenderer::AddTransparencyCullingPass(Renderer::RenderGraph* renderGrap
 
             builder.Read(resources.cameras.GetBuffer(), BufferUsage::COMPUTE);
             builder.Read(_cullingDatas.GetBuffer(), BufferUsage::COMPUTE);
-            builder.Read(_instanceMatrices.GetBuffer(), BufferUsage::COMPUTE);
+            builder.Read(_instanceTransforms.GetBuffer(), BufferUsage::COMPUTE);
             builder.Read(_transparentCullingResources.GetDrawCalls().GetBuffer(), BufferUsage::COMPUTE);
             builder.Read(_transparentCullingResources.GetDrawCallDatas().GetBuffer(), BufferUsage::COMPUTE);
 
@@ -547,7 +544,7 @@ void ModelRenderer::AddTransparencyGeometryPass(Renderer::RenderGraph* renderGra
             builder.Read(_indices.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_textureUnits.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_instanceDatas.GetBuffer(), BufferUsage::GRAPHICS);
-            builder.Read(_instanceMatrices.GetBuffer(), BufferUsage::GRAPHICS);
+            builder.Read(_instanceTransforms.GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_boneMatrices.GetBuffer(), BufferUsage::GRAPHICS | BufferUsage::COMPUTE);
             builder.Read(_transparentCullingResources.GetDrawCalls().GetBuffer(), BufferUsage::GRAPHICS);
             builder.Read(_transparentCullingResources.GetDrawCallDatas().GetBuffer(), BufferUsage::GRAPHICS);
@@ -612,7 +609,7 @@ void ModelRenderer::RegisterMaterialPassBufferUsage(Renderer::RenderGraphBuilder
     builder.Read(_indices.GetBuffer(), BufferUsage::COMPUTE);
     builder.Read(_textureUnits.GetBuffer(), BufferUsage::COMPUTE);
     builder.Read(_instanceDatas.GetBuffer(), BufferUsage::COMPUTE);
-    builder.Read(_instanceMatrices.GetBuffer(), BufferUsage::COMPUTE);
+    builder.Read(_instanceTransforms.GetBuffer(), BufferUsage::COMPUTE);
     builder.Read(_boneMatrices.GetBuffer(), BufferUsage::COMPUTE);
     builder.Write(_animatedVertices.GetBuffer(), BufferUsage::COMPUTE);
 }
@@ -629,6 +626,12 @@ u32 ModelRenderer::GetInstanceIDFromDrawCallID(u32 drawCallID, bool isOpaque)
     return drawCallDatas.Get()[drawCallID].instanceID;
 }
 
+void ModelRenderer::SetInstanceMatrix(u32 instanceID, const mat4x4& matrix)
+{
+    _instanceTransforms.Get()[instanceID] = PackedInstanceTransform::Pack(matrix);
+    _dirtyInstanceIDs.push_back(instanceID);
+}
+
 void ModelRenderer::Reserve(const ReserveInfo& reserveInfo)
 {
     _modelIDToNumInstances.resize(_modelIDToNumInstances.size() + reserveInfo.numModels);
@@ -640,7 +643,7 @@ void ModelRenderer::Reserve(const ReserveInfo& reserveInfo)
     _indices.Grow(reserveInfo.numIndices);
 
     _instanceDatas.Grow(reserveInfo.numInstances);
-    _instanceMatrices.Grow(reserveInfo.numInstances);
+    _instanceTransforms.Grow(reserveInfo.numInstances);
 
     _textureUnits.Grow(reserveInfo.numTextureUnits);
 
@@ -670,7 +673,7 @@ void ModelRenderer::FitBuffersAfterLoad()
 
     u32 numInstancesUsed = _instanceIndex.load();
     _instanceDatas.Resize(numInstancesUsed);
-    _instanceMatrices.Resize(numInstancesUsed);
+    _instanceTransforms.Resize(numInstancesUsed);
 
     u32 numTextureUnitsUsed = _textureUnitIndex.load();
     _textureUnits.Resize(numTextureUnitsUsed);
@@ -875,15 +878,15 @@ u32 ModelRenderer::AddInstance(u32 modelID, const Terrain::Placement& placement)
 
     // Add Instance matrix
     {
-        mat4x4& instanceMatrix = _instanceMatrices.Get()[instanceID];
-
         vec3 pos = vec3(placement.position.x, placement.position.y, placement.position.z);
 
         vec3 scale = vec3(placement.scale) / 1024.0f;
 
         mat4x4 rotationMatrix = glm::toMat4(placement.rotation);
         mat4x4 scaleMatrix = glm::scale(mat4x4(1.0f), scale);
-        instanceMatrix = glm::translate(mat4x4(1.0f), pos) * rotationMatrix * scaleMatrix;
+        mat4x4 instanceMatrix = glm::translate(mat4x4(1.0f), pos) * rotationMatrix * scaleMatrix;
+
+        _instanceTransforms.Get()[instanceID] = PackedInstanceTransform::Pack(instanceMatrix);
     }
 
     // Set up Opaque DrawCalls and DrawCallDatas
@@ -977,6 +980,195 @@ u32 ModelRenderer::AddInstance(u32 modelID, const Terrain::Placement& placement)
     return instanceID;
 }
 
+static u64 SpreadMortonBits(u64 value)
+{
+    // Spreads the lower 21 bits so there are two zero bits between each of them
+    value &= 0x1FFFFF;
+    value = (value | (value << 32)) & 0x1F00000000FFFF;
+    value = (value | (value << 16)) & 0x1F0000FF0000FF;
+    value = (value | (value << 8)) & 0x100F00F00F00F00F;
+    value = (value | (value << 4)) & 0x10C30C30C30C30C3;
+    value = (value | (value << 2)) & 0x1249249249249249;
+    return value;
+}
+
+template <typename DrawCallDataType>
+static void SortDrawCallsByInstance(CullingResources<DrawCallDataType>& cullingResources, std::vector<ModelRenderer::ModelManifest>& manifests, u32 ModelRenderer::ModelManifest::* offsetMember, u32 ModelRenderer::ModelManifest::* countMember, const std::vector<u32>& oldToNewInstanceID)
+{
+    struct DrawCallBlock
+    {
+        u32 start;
+        u32 count;
+        u32 sortKey;
+    };
+
+    std::vector<Renderer::IndexedIndirectDraw>& drawCalls = cullingResources.GetDrawCalls().Get();
+    std::vector<DrawCallDataType>& drawCallDatas = cullingResources.GetDrawCallDatas().Get();
+    u32 numDrawCalls = cullingResources.GetDrawCallsIndex().load();
+
+    // Each instance owns one contiguous block of drawcalls, the size of the block comes from its model
+    std::vector<DrawCallBlock> blocks;
+    for (u32 i = 0; i < numDrawCalls;)
+    {
+        const DrawCallDataType& drawCallData = drawCallDatas[i];
+        u32 count = manifests[drawCallData.modelID].*countMember;
+
+        // A drawcall whose model has none of this kind shouldn't exist, but if it does it moves on its own instead of ending the scan and leaving the rest unsorted
+        if (count == 0)
+            count = 1;
+
+        DrawCallBlock& block = blocks.emplace_back();
+        block.start = i;
+        block.count = count;
+        block.sortKey = (drawCallData.instanceID < oldToNewInstanceID.size()) ? oldToNewInstanceID[drawCallData.instanceID] : std::numeric_limits<u32>().max();
+
+        i += count;
+    }
+
+    std::stable_sort(blocks.begin(), blocks.end(), [](const DrawCallBlock& a, const DrawCallBlock& b)
+    {
+        return a.sortKey < b.sortKey;
+    });
+
+    std::vector<Renderer::IndexedIndirectDraw> sortedDrawCalls(drawCalls.begin(), drawCalls.end());
+    std::vector<DrawCallDataType> sortedDrawCallDatas(drawCallDatas.begin(), drawCallDatas.end());
+    std::vector<std::pair<u32, u32>> manifestOffsetUpdates;
+
+    u32 newStart = 0;
+    for (const DrawCallBlock& block : blocks)
+    {
+        u32 modelID = drawCallDatas[block.start].modelID;
+        if (manifests[modelID].*offsetMember == block.start)
+        {
+            manifestOffsetUpdates.push_back({ modelID, newStart });
+        }
+
+        for (u32 i = 0; i < block.count; i++)
+        {
+            u32 newIndex = newStart + i;
+
+            sortedDrawCalls[newIndex] = drawCalls[block.start + i];
+            sortedDrawCalls[newIndex].firstInstance = newIndex;
+
+            sortedDrawCallDatas[newIndex] = drawCallDatas[block.start + i];
+            if (block.sortKey != std::numeric_limits<u32>().max())
+            {
+                sortedDrawCallDatas[newIndex].instanceID = block.sortKey;
+            }
+        }
+
+        newStart += block.count;
+    }
+
+    for (const auto& [modelID, offset] : manifestOffsetUpdates)
+    {
+        manifests[modelID].*offsetMember = offset;
+    }
+
+    drawCalls.swap(sortedDrawCalls);
+    drawCallDatas.swap(sortedDrawCallDatas);
+
+    cullingResources.GetDrawCalls().SetDirtyElements(0, newStart);
+    cullingResources.GetDrawCallDatas().SetDirtyElements(0, newStart);
+    cullingResources.ResetCulledDrawCallsBitMask();
+}
+
+bool ModelRenderer::SortInstancesByMortonCode(std::vector<u32>& oldToNewInstanceID)
+{
+    ZoneScoped;
+
+    u32 numInstances = _instanceIndex.load();
+    if (numInstances < 2)
+        return false;
+
+    std::vector<PackedInstanceTransform>& instanceTransforms = _instanceTransforms.Get();
+    std::vector<InstanceData>& instanceDatas = _instanceDatas.Get();
+
+    // Quantize the positions within the bounds of all instances
+    vec3 boundsMin = vec3(std::numeric_limits<f32>().max());
+    vec3 boundsMax = vec3(std::numeric_limits<f32>().lowest());
+
+    for (u32 i = 0; i < numInstances; i++)
+    {
+        const PackedInstanceTransform& transform = instanceTransforms[i];
+        vec3 position = vec3(transform.rows[0].w, transform.rows[1].w, transform.rows[2].w);
+
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+
+    vec3 boundsSize = glm::max(boundsMax - boundsMin, vec3(1.0f));
+    constexpr f32 maxQuantizedValue = static_cast<f32>(0x1FFFFF);
+
+    std::vector<std::pair<u64, u32>> mortonCodes(numInstances);
+    for (u32 i = 0; i < numInstances; i++)
+    {
+        const PackedInstanceTransform& transform = instanceTransforms[i];
+        vec3 position = vec3(transform.rows[0].w, transform.rows[1].w, transform.rows[2].w);
+        vec3 normalized = (position - boundsMin) / boundsSize;
+
+        u64 x = static_cast<u64>(normalized.x * maxQuantizedValue);
+        u64 y = static_cast<u64>(normalized.y * maxQuantizedValue);
+        u64 z = static_cast<u64>(normalized.z * maxQuantizedValue);
+
+        mortonCodes[i].first = SpreadMortonBits(x) | (SpreadMortonBits(y) << 1) | (SpreadMortonBits(z) << 2);
+        mortonCodes[i].second = i;
+    }
+
+    std::sort(mortonCodes.begin(), mortonCodes.end());
+
+    oldToNewInstanceID.resize(numInstances);
+
+    std::vector<PackedInstanceTransform> sortedTransforms(instanceTransforms.begin(), instanceTransforms.end());
+    std::vector<InstanceData> sortedInstanceDatas(instanceDatas.begin(), instanceDatas.end());
+
+    for (u32 newID = 0; newID < numInstances; newID++)
+    {
+        u32 oldID = mortonCodes[newID].second;
+        oldToNewInstanceID[oldID] = newID;
+
+        sortedTransforms[newID] = instanceTransforms[oldID];
+        sortedInstanceDatas[newID] = instanceDatas[oldID];
+    }
+
+    instanceTransforms.swap(sortedTransforms);
+    instanceDatas.swap(sortedInstanceDatas);
+
+    _instanceTransforms.SetDirtyElements(0, numInstances);
+    _instanceDatas.SetDirtyElements(0, numInstances);
+
+    for (u32& instanceID : _dirtyInstanceIDs)
+    {
+        instanceID = oldToNewInstanceID[instanceID];
+    }
+
+    SortDrawCallsByInstance(_opaqueCullingResources, _modelManifests, &ModelManifest::opaqueDrawCallOffset, &ModelManifest::numOpaqueDrawCalls, oldToNewInstanceID);
+    SortDrawCallsByInstance(_transparentCullingResources, _modelManifests, &ModelManifest::transparentDrawCallOffset, &ModelManifest::numTransparentDrawCalls, oldToNewInstanceID);
+
+    return true;
+}
+
+f32 ModelRenderer::CalculateMeanNeighborDistance()
+{
+    u32 numInstances = _instanceIndex.load();
+    if (numInstances < 2)
+        return 0.0f;
+
+    const std::vector<PackedInstanceTransform>& instanceTransforms = _instanceTransforms.Get();
+
+    f64 totalDistance = 0.0;
+    vec3 prevPosition = vec3(instanceTransforms[0].rows[0].w, instanceTransforms[0].rows[1].w, instanceTransforms[0].rows[2].w);
+
+    for (u32 i = 1; i < numInstances; i++)
+    {
+        vec3 position = vec3(instanceTransforms[i].rows[0].w, instanceTransforms[i].rows[1].w, instanceTransforms[i].rows[2].w);
+        totalDistance += glm::distance(prevPosition, position);
+        prevPosition = position;
+    }
+
+    return static_cast<f32>(totalDistance / (numInstances - 1));
+}
+
 bool ModelRenderer::AddAnimationInstance(u32 instanceID)
 {
     std::vector<InstanceData>& instanceDatas = _instanceDatas.Get();
@@ -1093,6 +1285,114 @@ void ModelRenderer::CreatePermanentResources()
     _transparentCullingResources.Init(initParams);
 }
 
+void ModelRenderer::CollectDirtyInstanceTransforms(entt::registry& registry)
+{
+    ZoneScoped;
+
+    Timer timer;
+
+    // DirtyTransform is the smallest pool in the view, so we drive the collection from it directly since its storage can be split into ranges
+    auto& dirtyTransformStorage = registry.storage<ECS::Components::DirtyTransform>();
+    auto& transformStorage = registry.storage<ECS::Components::Transform>();
+    auto& modelStorage = registry.storage<ECS::Components::Model>();
+
+    u32 numDirtyEntities = static_cast<u32>(dirtyTransformStorage.size());
+    if (numDirtyEntities == 0)
+        return;
+
+    enki::TaskScheduler* taskScheduler = ServiceLocator::GetTaskScheduler();
+    u32 numThreads = taskScheduler->GetNumTaskThreads();
+
+    _perThreadDirtyInstanceIDs.resize(numThreads);
+    for (std::vector<u32>& dirtyInstanceIDs : _perThreadDirtyInstanceIDs)
+    {
+        dirtyInstanceIDs.clear();
+    }
+
+    std::vector<PackedInstanceTransform>& instanceTransforms = _instanceTransforms.Get();
+    const entt::entity* dirtyEntities = dirtyTransformStorage.data();
+
+    enki::TaskSet collectTask(numDirtyEntities, [&](enki::TaskSetPartition range, u32 threadNum)
+    {
+        std::vector<u32>& dirtyInstanceIDs = _perThreadDirtyInstanceIDs[threadNum];
+
+        for (u32 i = range.start; i < range.end; i++)
+        {
+            entt::entity entity = dirtyEntities[i];
+            if (!modelStorage.contains(entity) || !transformStorage.contains(entity))
+                continue;
+
+            const ECS::Components::Model& model = modelStorage.get(entity);
+            const ECS::Components::Transform& transform = transformStorage.get(entity);
+
+            // Each instance belongs to exactly one entity so no two threads will write the same element
+            instanceTransforms[model.instanceID] = PackedInstanceTransform::Pack(transform.matrix);
+            dirtyInstanceIDs.push_back(model.instanceID);
+        }
+    });
+    collectTask.m_MinRange = 256;
+
+    taskScheduler->AddTaskSetToPipe(&collectTask);
+    taskScheduler->WaitforTask(&collectTask);
+
+    // Merge the per thread lists, SyncDirtyInstanceTransforms sorts and coalesces them
+    for (const std::vector<u32>& dirtyInstanceIDs : _perThreadDirtyInstanceIDs)
+    {
+        _dirtyInstanceIDs.insert(_dirtyInstanceIDs.end(), dirtyInstanceIDs.begin(), dirtyInstanceIDs.end());
+    }
+
+    f32 timeSpentMS = timer.GetLifeTime() * 1000.0f;
+
+    ECS::Singletons::EngineStats& engineStats = registry.ctx().at<ECS::Singletons::EngineStats>();
+    engineStats.AddNamedStat("Instance Collect MS Per 10k", (timeSpentMS * 10000.0f) / static_cast<f32>(numDirtyEntities));
+}
+
+void ModelRenderer::SyncDirtyInstanceTransforms()
+{
+    ZoneScoped;
+
+    _instanceUploadStats = InstanceUploadStats();
+
+    if (_dirtyInstanceIDs.size() > 0)
+    {
+        // Sort and coalesce the dirty instances into contiguous ranges so we upload as few regions as possible
+        std::sort(_dirtyInstanceIDs.begin(), _dirtyInstanceIDs.end());
+        _dirtyInstanceIDs.erase(std::unique(_dirtyInstanceIDs.begin(), _dirtyInstanceIDs.end()), _dirtyInstanceIDs.end());
+
+        u32 numDirtyInstances = static_cast<u32>(_dirtyInstanceIDs.size());
+        u32 rangeStart = _dirtyInstanceIDs[0];
+        u32 rangeCount = 1;
+
+        for (u32 i = 1; i <= numDirtyInstances; i++)
+        {
+            if (i < numDirtyInstances && _dirtyInstanceIDs[i] == rangeStart + rangeCount)
+            {
+                rangeCount++;
+                continue;
+            }
+
+            _instanceTransforms.SetDirtyElements(rangeStart, rangeCount);
+            _instanceUploadStats.numUploadRegions++;
+
+            if (i < numDirtyInstances)
+            {
+                rangeStart = _dirtyInstanceIDs[i];
+                rangeCount = 1;
+            }
+        }
+
+        _instanceUploadStats.numDirtyInstances = numDirtyInstances;
+        _instanceUploadStats.numUploadBytes = numDirtyInstances * sizeof(PackedInstanceTransform);
+        _dirtyInstanceIDs.clear();
+    }
+
+    entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+    ECS::Singletons::EngineStats& engineStats = registry->ctx().at<ECS::Singletons::EngineStats>();
+
+    engineStats.AddNamedStat("Instance Upload KB", static_cast<f32>(_instanceUploadStats.numUploadBytes) / 1024.0f);
+    engineStats.AddNamedStat("Instance Upload Regions", static_cast<f32>(_instanceUploadStats.numUploadRegions));
+}
+
 void ModelRenderer::SyncToGPU()
 {
     CulledRenderer::SyncToGPU();
@@ -1172,19 +1472,19 @@ void ModelRenderer::SyncToGPU()
         }
     }
 
-    // Sync InstanceMatrices buffer to GPU
+    // Sync InstanceTransforms buffer to GPU
     {
-        _instanceMatrices.SetDebugName("ModelInstanceMatrices");
-        _instanceMatrices.SetUsage(Renderer::BufferUsage::STORAGE_BUFFER);
-        if (_instanceMatrices.SyncToGPU(_renderer))
+        _instanceTransforms.SetDebugName("ModelInstanceTransforms");
+        _instanceTransforms.SetUsage(Renderer::BufferUsage::STORAGE_BUFFER);
+        if (_instanceTransforms.SyncToGPU(_renderer))
         {
-            _opaqueCullingResources.GetCullingDescriptorSet().Bind("_instanceMatrices"_h, _instanceMatrices.GetBuffer());
-            _transparentCullingResources.GetCullingDescriptorSet().Bind("_instanceMatrices"_h, _instanceMatrices.GetBuffer());
-            //_animationPrepassDescriptorSet.Bind("_modelInstanceMatrices"_h, _instanceMatrices.GetBuffer());
+            _opaqueCullingResources.GetCullingDescriptorSet().Bind("_instanceTransforms"_h, _instanceTransforms.GetBuffer());
+            _transparentCullingResources.GetCullingDescriptorSet().Bind("_instanceTransforms"_h, _instanceTransforms.GetBuffer());
+            //_animationPrepassDescriptorSet.Bind("_modelInstanceTransforms"_h, _instanceTransforms.GetBuffer());
 
-            _opaqueCullingResources.GetGeometryPassDescriptorSet().Bind("_modelInstanceMatrices"_h, _instanceMatrices.GetBuffer());
-            _transparentCullingResources.GetGeometryPassDescriptorSet().Bind("_modelInstanceMatrices"_h, _instanceMatrices.GetBuffer());
-            _materialPassDescriptorSet.Bind("_modelInstanceMatrices"_h, _instanceMatrices.GetBuffer());
+            _opaqueCullingResources.GetGeometryPassDescriptorSet().Bind("_modelInstanceTransforms"_h, _instanceTransforms.GetBuffer());
+            _transparentCullingResources.GetGeometryPassDescriptorSet().Bind("_modelInstanceTransforms"_h, _instanceTransforms.GetBuffer());
+            _materialPassDescriptorSet.Bind("_modelInstanceTransforms"_h, _instanceTransforms.GetBuffer());
         }
     }
 
@@ -1357,3 +1657,21 @@ void ModelRenderer::DrawTransparent(const RenderResources& resources, u8 frameIn
 
     commandList.EndPipeline(pipeline);
 }
+
+ModelRenderer::PackedInstanceTransform ModelRenderer::PackedInstanceTransform::Pack(const mat4x4& matrix)
+{
+    mat4x4 transposed = glm::transpose(matrix);
+
+    PackedInstanceTransform packed;
+    packed.rows[0] = transposed[0];
+    packed.rows[1] = transposed[1];
+    packed.rows[2] = transposed[2];
+
+    return packed;
+}
+
+mat4x4 ModelRenderer::PackedInstanceTransform::Unpack() const
+{
+    mat4x4 transposed = mat4x4(rows[0], rows[1], rows[2], vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    return glm::transpose(transposed);
+}
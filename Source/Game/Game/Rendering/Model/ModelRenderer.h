@@ -13,6 +13,8 @@
 #include <Renderer/GPUBuffer.h>
 #include <Renderer/GPUVector.h>
 
+#include <entt/fwd.hpp>
+
 class DebugRenderer;
 struct RenderResources;
 
@@ -118,6 +120,24 @@ public:
 		u32 packed1;
 	};
 
+	struct PackedInstanceTransform
+	{
+	public:
+		// The first three rows of the affine instance matrix, the last row is always (0, 0, 0, 1)
+		vec4 rows[3];
+
+		static PackedInstanceTransform Pack(const mat4x4& matrix);
+		mat4x4 Unpack() const;
+	}; // 48 bytes
+
+	struct InstanceUploadStats
+	{
+	public:
+		u32 numDirtyInstances = 0;
+		u32 numUploadRegions = 0;
+		u32 numUploadBytes = 0;
+	};
+
 public:
 	ModelRenderer(Renderer::Renderer* renderer, DebugRenderer* debugRenderer);
 	~ModelRenderer();
@@ -130,6 +150,9 @@ public:
 	u32 LoadModel(const std::string& name, Model::ComplexModel& model);
 	u32 AddInstance(u32 modelID, const Terrain::Placement& placement);
 
+	bool SortInstancesByMortonCode(std::vector<u32>& oldToNewInstanceID);
+	f32 CalculateMeanNeighborDistance();
+
 	bool AddAnimationInstance(u32 instanceID);
 	bool SetBoneMatricesAsDirty(u32 instanceID, u32 localBoneIndex, u32 count, mat4x4* boneMatrixArray);
 
@@ -143,7 +166,9 @@ public:
 	Renderer::DescriptorSet& GetMaterialPassDescriptorSet() { return _materialPassDescriptorSet; }
 	void RegisterMaterialPassBufferUsage(Renderer::RenderGraphBuilder& builder);
 
-	Renderer::GPUVector<mat4x4>& GetInstanceMatrices() { return _instanceMatrices; }
+	mat4x4 GetInstanceMatrix(u32 instanceID) { return _instanceTransforms.Get()[instanceID].Unpack(); }
+	void SetInstanceMatrix(u32 instanceID, const mat4x4& matrix);
+	const InstanceUploadStats& GetInstanceUploadStats() { return _instanceUploadStats; }
 	std::vector<ModelManifest> GetModelManifests() { return _modelManifests; }
 	u32 GetInstanceIDFromDrawCallID(u32 drawCallID, bool isOpaque);
 
@@ -164,6 +189,8 @@ private:
 	void CreatePermanentResources();
 
 	void SyncToGPU();
+	void CollectDirtyInstanceTransforms(entt::registry& registry);
+	void SyncDirtyInstanceTransforms();
 
 	void Draw(const RenderResources& resources, u8 frameIndex, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList, const DrawParams& params);
 	void DrawTransparent(const RenderResources& resources, u8 frameIndex, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList, const DrawParams& params);
@@ -192,9 +219,13 @@ private:
 	std::atomic<u32> _indicesIndex = 0;
 
 	Renderer::GPUVector<InstanceData> _instanceDatas;
-	Renderer::GPUVector<mat4x4> _instanceMatrices;
+	Renderer::GPUVector<PackedInstanceTransform> _instanceTransforms;
 	std::atomic<u32> _instanceIndex = 0;
 
+	std::vector<u32> _dirtyInstanceIDs;
+	std::vector<std::vector<u32>> _perThreadDirtyInstanceIDs;
+	InstanceUploadStats _instanceUploadStats;
+
 	Renderer::GPUVector<TextureUnit> _textureUnits;
 	std::atomic<u32> _textureUnitIndex = 0;
 
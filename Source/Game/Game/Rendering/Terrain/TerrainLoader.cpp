@@ -44,6 +44,8 @@ void TerrainLoader::Update(f32 deltaTime)
 
 	while (_requests.try_dequeue(loadRequest))
 	{
+		bool result = false;
+
 		if (loadRequest.loadType == LoadType::Partial)
 		{
 			// TODO : Disabled as this needs fixing
@@ -51,12 +53,17 @@ void TerrainLoader::Update(f32 deltaTime)
 		}
 		else if (loadRequest.loadType == LoadType::Full)
 		{
-			LoadFullMapRequest(loadRequest);
+			result = LoadFullMapRequest(loadRequest);
 		}
 		else
 		{
 			DebugHandler::PrintFatal("TerrainLoader : Encountered LoadRequest with invalid LoadType");
 		}
+
+		if (loadRequest.onComplete)
+		{
+			loadRequest.onComplete(result);
+		}
 	}
 }
 
@@ -67,6 +74,7 @@ void TerrainLoader::AddInstance(const LoadDesc& loadDesc)
 	loadRequest.mapName = loadDesc.mapName;
 	loadRequest.chunkGridStartPos = loadDesc.chunkGridStartPos;
 	loadRequest.chunkGridEndPos = loadDesc.chunkGridEndPos;
+	loadRequest.onComplete = loadDesc.onComplete;
 
 	_requests.enqueue(loadRequest);
 }
@@ -151,7 +159,7 @@ void TerrainLoader::LoadPartialMapRequest(const LoadRequestInternal& request)
 
 				for (Terrain::Placement& placement : chunk->complexModelPlacements)
 				{
-					_modelLoader->LoadPlacement(placement);
+					_modelLoader->LoadStaticPlacement(chunkX + (chunkY * Terrain::CHUNK_NUM_PER_MAP_STRIDE), placement);
 				}
 			}
 		}
@@ -220,7 +228,7 @@ vec2 GetGlobalVertexPosition(u32 chunkID, u32 cellID, u32 vertexID)
 	return vec2(-finalPos.y, -finalPos.x);
 }
 
-void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
+bool TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 {
 	assert(request.loadType == LoadType::Full);
 	assert(request.mapName.size() > 0);
@@ -228,14 +236,14 @@ void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 	const std::string& mapName = request.mapName;
 	if (mapName == _currentMapInternalName)
 	{
-		return;
+		return true;
 	}
 
 	fs::path absoluteMapPath = fs::absolute("Data/Map/" + mapName);
 	if (!fs::is_directory(absoluteMapPath))
 	{
 		DebugHandler::PrintError("TerrainLoader : Failed to find '{0}' folder", absoluteMapPath.string());
-		return;
+		return false;
 	}
 
 	std::vector<fs::path> paths;
@@ -374,13 +382,23 @@ void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 					// Create the settings for the body itself. Note that here you can also set other properties like the restitution / friction.
 					JPH::BodyCreationSettings bodySettings(shape, JPH::RVec3(0.0f, 0.0f, 0.0f), JPH::Quat::sIdentity(), JPH::EMotionType::Static, Jolt::Layers::NON_MOVING);
 
+					// Terrain belongs to no entity, scene queries report hits on it as entt::null
+					bodySettings.mUserData = JPH::uint64(entt::to_integral(entt::entity(entt::null)));
+
 					// Create the actual rigid body
-					JPH::Body* body = bodyInterface.CreateBody(bodySettings); // Note that if we run out of bodies this can return nullptr
-					body->SetFriction(0.8f);
+					JPH::Body* body = bodyInterface.CreateBody(bodySettings);
+					if (body == nullptr)
+					{
+						DebugHandler::PrintError("TerrainLoader : Failed to create collision body for chunk {0}, we hit the limit of {1} bodies (see physics.maxBodies)", chunkID, joltState.physicsSystem.GetMaxBodies());
+					}
+					else
+					{
+						body->SetFriction(0.8f);
 
-					JPH::BodyID bodyID = body->GetID();
-					bodyInterface.AddBody(bodyID, JPH::EActivation::DontActivate);
-					_chunkIDToBodyID[chunkID] = bodyID.GetIndexAndSequenceNumber();
+						JPH::BodyID bodyID = body->GetID();
+						bodyInterface.AddBody(bodyID, JPH::EActivation::DontActivate);
+						_chunkIDToBodyID[chunkID] = bodyID.GetIndexAndSequenceNumber();
+					}
 				}
 
 				// Load into Terrain Renderer
@@ -400,7 +418,7 @@ void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 							size_t offset = mapObjectOffset + (j * sizeof(Terrain::Placement));
 							Terrain::Placement* placement = reinterpret_cast<Terrain::Placement*>(&chunkBuffer->GetDataPointer()[offset]);
 					
-							_modelLoader->LoadPlacement(*placement);
+							_modelLoader->LoadStaticPlacement(chunkID, *placement);
 						}
 					}
 					
@@ -413,7 +431,7 @@ void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 							size_t offset = cModelOffset + (j * sizeof(Terrain::Placement));
 							Terrain::Placement* placement = reinterpret_cast<Terrain::Placement*>(&chunkBuffer->GetDataPointer()[offset]);
 					
-							_modelLoader->LoadPlacement(*placement);
+							_modelLoader->LoadStaticPlacement(chunkID, *placement);
 						}
 					}
 				}
@@ -430,7 +448,7 @@ void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 	if (numChunksToLoad == 0)
 	{
 		DebugHandler::PrintError("TerrainLoader : Failed to prepare chunks for map '{0}'", request.mapName);
-		return;
+		return false;
 	}
 
 	_currentMapInternalName = mapName;
@@ -446,6 +464,8 @@ void TerrainLoader::LoadFullMapRequest(const LoadRequestInternal& request)
 	}
 
 	DebugHandler::Print("TerrainLoader : Finished Chunk Loading");
+
+	return true;
 }
 
 void TerrainLoader::PrepareForChunks(LoadType loadType, u32 numChunks)
@@ -7,6 +7,8 @@
 #include <robinhood/robinhood.h>
 #include <type_safe/strong_typedef.hpp>
 
+#include <functional>
+
 class ModelLoader;
 
 class TerrainRenderer;
@@ -25,6 +27,9 @@ public:
 		std::string mapName = "";
 		uvec2 chunkGridStartPos = uvec2(0, 0);
 		uvec2 chunkGridEndPos = uvec2(0, 0);
+		// Called on the thread running Update once the request has been handled, with whether the map was loaded. At that point the terrain
+		// chunks are loaded and their placements are queued with ModelLoader, the models themselves stream in over the following frames
+		std::function<void(bool)> onComplete = nullptr;
 	};
 
 private:
@@ -34,6 +39,7 @@ private:
 		std::string mapName = "";
 		uvec2 chunkGridStartPos = uvec2(0, 0);
 		uvec2 chunkGridEndPos = uvec2(0, 0);
+		std::function<void(bool)> onComplete = nullptr;
 	};
 
 public:
@@ -46,7 +52,7 @@ public:
 
 private:
 	void LoadPartialMapRequest(const LoadRequestInternal& request);
-	void LoadFullMapRequest(const LoadRequestInternal& request);
+	bool LoadFullMapRequest(const LoadRequestInternal& request);
 
 	void PrepareForChunks(LoadType loadType, u32 numChunks);
 
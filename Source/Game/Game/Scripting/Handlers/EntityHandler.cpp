@@ -0,0 +1,391 @@
+#include "EntityHandler.h"
+#include "Game/Application/EnttRegistries.h"
+#include "Game/ECS/Components/Model.h"
+#include "Game/ECS/Components/Name.h"
+#include "Game/ECS/Components/Transform.h"
+#include "Game/ECS/Singletons/ScriptTransformWrites.h"
+#include "Game/Rendering/GameRenderer.h"
+#include "Game/Rendering/Model/ModelLoader.h"
+#include "Game/Scripting/LuaBinding.h"
+#include "Game/Scripting/LuaManager.h"
+#include "Game/Util/ServiceLocator.h"
+#include "Game/Util/StringInterner.h"
+
+#include <entt/entt.hpp>
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+#include <string_view>
+#include <type_traits>
+
+namespace Scripting
+{
+	static constexpr u8 ENTITY_QUERY_TRANSFORM = 1 << 0;
+	static constexpr u8 ENTITY_QUERY_MODEL = 1 << 1;
+	static constexpr u8 ENTITY_QUERY_NAME = 1 << 2;
+
+	// Anything other than the game registry is passed as the first upvalue, which is how LuaEntityBenchmark runs on its own entities
+	static entt::registry* GetEntityRegistry(lua_State* state)
+	{
+		void* registry = lua_tolightuserdata(state, lua_upvalueindex(1));
+		if (registry != nullptr)
+			return static_cast<entt::registry*>(registry);
+
+		return ServiceLocator::GetEnttRegistries()->gameRegistry;
+	}
+
+	template <typename T>
+	static T* PushEntityBuffer(lua_State* state, const char* name, u32 numEntities, u32 numValues)
+	{
+		void* data = lua_newbuffer(state, sizeof(T) * numEntities * numValues);
+		lua_setfield(state, -2, name);
+
+		return static_cast<T*>(data);
+	}
+
+	// The buffer stays referenced by the query table, so the pointer is valid for as long as that is on the stack
+	template <typename T>
+	static const T* GetEntityBuffer(lua_State* state, i32 index, const char* name, u32 numEntities, u32 numValues)
+	{
+		lua_getfield(state, index, name);
+
+		size_t size = 0;
+		void* data = lua_tobuffer(state, -1, &size);
+		lua_pop(state, 1);
+
+		if (data == nullptr || size < sizeof(T) * numEntities * numValues)
+			return nullptr;
+
+		return static_cast<const T*>(data);
+	}
+
+	template <typename... QueryTypes>
+	static void PushEntityQuery(lua_State* state, const entt::registry& registry)
+	{
+		ZoneScoped;
+
+		constexpr bool hasTransform = (std::is_same_v<QueryTypes, ECS::Components::Transform> || ...);
+		constexpr bool hasModel = (std::is_same_v<QueryTypes, ECS::Components::Model> || ...);
+		constexpr bool hasName = (std::is_same_v<QueryTypes, ECS::Components::Name> || ...);
+
+		// Queries run from several states at once, a const view only reads the storages UpdateScripts::Init created up front
+		auto view = registry.view<const QueryTypes...>();
+
+		// Views over several components only know an upper bound, so the buffers are sized for that and count says how much of them is used
+		u32 numEntities = 0;
+		if constexpr (sizeof...(QueryTypes) == 1)
+		{
+			numEntities = static_cast<u32>(view.size());
+		}
+		else
+		{
+			numEntities = static_cast<u32>(view.size_hint());
+		}
+
+		lua_createtable(state, 0, 9);
+
+		u32* entities = PushEntityBuffer<u32>(state, "entity", numEntities, 1);
+
+		f32* positions = nullptr;
+		f32* rotations = nullptr;
+		f32* scales = nullptr;
+		if constexpr (hasTransform)
+		{
+			positions = PushEntityBuffer<f32>(state, "position", numEntities, 3);
+			rotations = PushEntityBuffer<f32>(state, "rotation", numEntities, 4);
+			scales = PushEntityBuffer<f32>(state, "scale", numEntities, 3);
+		}
+
+		u32* modelIDs = nullptr;
+		u32* instanceIDs = nullptr;
+		if constexpr (hasModel)
+		{
+			modelIDs = PushEntityBuffer<u32>(state, "modelID", numEntities, 1);
+			instanceIDs = PushEntityBuffer<u32>(state, "instanceID", numEntities, 1);
+		}
+
+		u32* names = nullptr;
+		u32* fullNames = nullptr;
+		if constexpr (hasName)
+		{
+			names = PushEntityBuffer<u32>(state, "name", numEntities, 1);
+			fullNames = PushEntityBuffer<u32>(state, "fullName", numEntities, 1);
+		}
+
+		u32 index = 0;
+		for (entt::entity entity : view)
+		{
+			entities[index] = entt::to_integral(entity);
+
+			if constexpr (hasTransform)
+			{
+				const ECS::Components::Transform& transform = view.template get<ECS::Components::Transform>(entity);
+
+				f32* position = &positions[index * 3];
+				position[0] = transform.position.x;
+				position[1] = transform.position.y;
+				position[2] = transform.position.z;
+
+				f32* rotation = &rotations[index * 4];
+				rotation[0] = transform.rotation.x;
+				rotation[1] = transform.rotation.y;
+				rotation[2] = transform.rotation.z;
+				rotation[3] = transform.rotation.w;
+
+				f32* scale = &scales[index * 3];
+				scale[0] = transform.scale.x;
+				scale[1] = transform.scale.y;
+				scale[2] = transform.scale.z;
+			}
+
+			if constexpr (hasModel)
+			{
+				const ECS::Components::Model& model = view.template get<ECS::Components::Model>(entity);
+
+				modelIDs[index] = model.modelID;
+				instanceIDs[index] = model.instanceID;
+			}
+
+			if constexpr (hasName)
+			{
+				const ECS::Components::Name& name = view.template get<ECS::Components::Name>(entity);
+
+				names[index] = name.name.id;
+				fullNames[index] = name.fullName.id;
+			}
+
+			index++;
+		}
+
+		lua_pushnumber(state, static_cast<f64>(index));
+		lua_setfield(state, -2, "count");
+	}
+
+	void EntityHandler::Register()
+	{
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+
+		LuaTable entitiesTable =
+		{
+			{
+				{ "Query", Query },
+				{ "Commit", Commit },
+				{ "Promote", Promote },
+				{ "ResolveName", ResolveName }
+			}
+		};
+
+		luaManager->SetGlobal("Entities", entitiesTable, true);
+	}
+
+	void EntityHandler::ApplyWrites(entt::registry& registry)
+	{
+		ZoneScoped;
+
+		auto* transformWrites = registry.ctx().find<ECS::Singletons::ScriptTransformWrites>();
+		if (transformWrites == nullptr)
+			return;
+
+		std::scoped_lock lock(transformWrites->mutex);
+
+		// ModelLoader only promotes into the game registry
+		if (!transformWrites->promotions.empty() && &registry == ServiceLocator::GetEnttRegistries()->gameRegistry)
+		{
+			ModelLoader* modelLoader = ServiceLocator::GetGameRenderer()->GetModelLoader();
+
+			for (u32 instanceID : transformWrites->promotions)
+			{
+				entt::entity entityID;
+				modelLoader->GetOrPromoteEntityFromInstanceID(instanceID, entityID);
+			}
+		}
+		transformWrites->promotions.clear();
+
+		if (transformWrites->writes.empty())
+			return;
+
+		auto& transformStorage = registry.storage<ECS::Components::Transform>();
+		auto& dirtyTransformStorage = registry.storage<ECS::Components::DirtyTransform>();
+
+		for (const ECS::Singletons::ScriptTransformWrites::Write& write : transformWrites->writes)
+		{
+			// The entity could have been destroyed since it was queried, its id would have a new version if it was reused
+			if (!transformStorage.contains(write.entity))
+				continue;
+
+			ECS::Components::Transform& transform = transformStorage.get(write.entity);
+
+			// Most scripts write back the whole query, only the transforms they actually touched need their matrices rebuilt
+			if (transform.position == write.position && transform.rotation == write.rotation && transform.scale == write.scale)
+				continue;
+
+			transform.position = write.position;
+			transform.rotation = write.rotation;
+			transform.scale = write.scale;
+			transform.isDirty = true;
+
+			if (!dirtyTransformStorage.contains(write.entity))
+			{
+				dirtyTransformStorage.emplace(write.entity);
+			}
+		}
+
+		transformWrites->writes.clear();
+	}
+
+	// Entities.Query(component, ...) -> { count, entity, position, rotation, scale, modelID, instanceID, name, fullName }
+	// Every field but count is a buffer with one element per entity, entity, modelID, instanceID, name and fullName hold a u32,
+	// position and scale 3 f32 (x, y, z) and rotation 4 f32 (x, y, z, w), so position i starts at byte i * 12.
+	// Names are interned string handles, Entities.ResolveName turns them into strings
+	i32 EntityHandler::Query(lua_State* state)
+	{
+		u8 components = 0;
+
+		i32 numArgs = lua_gettop(state);
+		for (i32 i = 1; i <= numArgs; i++)
+		{
+			std::string_view name = LuaType<std::string_view>::Get(state, i);
+
+			if (name == "Transform")
+			{
+				components |= ENTITY_QUERY_TRANSFORM;
+			}
+			else if (name == "Model")
+			{
+				components |= ENTITY_QUERY_MODEL;
+			}
+			else if (name == "Name")
+			{
+				components |= ENTITY_QUERY_NAME;
+			}
+			else
+			{
+				luaL_error(state, "Entities.Query : '%.*s' is not a component that can be queried", static_cast<i32>(name.size()), name.data());
+			}
+		}
+
+		entt::registry* registry = GetEntityRegistry(state);
+
+		switch (components)
+		{
+			case ENTITY_QUERY_TRANSFORM:
+				PushEntityQuery<ECS::Components::Transform>(state, *registry);
+				break;
+
+			case ENTITY_QUERY_MODEL:
+				PushEntityQuery<ECS::Components::Model>(state, *registry);
+				break;
+
+			case ENTITY_QUERY_TRANSFORM | ENTITY_QUERY_MODEL:
+				PushEntityQuery<ECS::Components::Transform, ECS::Components::Model>(state, *registry);
+				break;
+
+			case ENTITY_QUERY_NAME:
+				PushEntityQuery<ECS::Components::Name>(state, *registry);
+				break;
+
+			case ENTITY_QUERY_TRANSFORM | ENTITY_QUERY_NAME:
+				PushEntityQuery<ECS::Components::Transform, ECS::Components::Name>(state, *registry);
+				break;
+
+			case ENTITY_QUERY_MODEL | ENTITY_QUERY_NAME:
+				PushEntityQuery<ECS::Components::Model, ECS::Components::Name>(state, *registry);
+				break;
+
+			case ENTITY_QUERY_TRANSFORM | ENTITY_QUERY_MODEL | ENTITY_QUERY_NAME:
+				PushEntityQuery<ECS::Components::Transform, ECS::Components::Model, ECS::Components::Name>(state, *registry);
+				break;
+
+			default:
+				luaL_error(state, "Entities.Query : Expected at least one component");
+		}
+
+		return 1;
+	}
+
+	// Entities.Commit(query)
+	// Queues the position, rotation and scale buffers of a query with Transform to be written back after the script update
+	i32 EntityHandler::Commit(lua_State* state)
+	{
+		ZoneScoped;
+
+		luaL_checktype(state, 1, LUA_TTABLE);
+
+		lua_getfield(state, 1, "count");
+		u32 numEntities = lua_tounsignedx(state, -1, nullptr);
+		lua_pop(state, 1);
+
+		const u32* entities = GetEntityBuffer<u32>(state, 1, "entity", numEntities, 1);
+		const f32* positions = GetEntityBuffer<f32>(state, 1, "position", numEntities, 3);
+		const f32* rotations = GetEntityBuffer<f32>(state, 1, "rotation", numEntities, 4);
+		const f32* scales = GetEntityBuffer<f32>(state, 1, "scale", numEntities, 3);
+
+		if (entities == nullptr || positions == nullptr || rotations == nullptr || scales == nullptr)
+		{
+			luaL_error(state, "Entities.Commit : Expected the result of a query with Transform");
+		}
+
+		entt::registry* registry = GetEntityRegistry(state);
+
+		auto* transformWrites = registry->ctx().find<ECS::Singletons::ScriptTransformWrites>();
+		if (transformWrites == nullptr)
+		{
+			luaL_error(state, "Entities.Commit : The registry doesn't accept writes from scripts");
+		}
+
+		std::scoped_lock lock(transformWrites->mutex);
+
+		for (u32 i = 0; i < numEntities; i++)
+		{
+			ECS::Singletons::ScriptTransformWrites::Write& write = transformWrites->writes.emplace_back();
+			write.entity = static_cast<entt::entity>(entities[i]);
+
+			const f32* position = &positions[i * 3];
+			write.position = vec3(position[0], position[1], position[2]);
+
+			const f32* rotation = &rotations[i * 4];
+			write.rotation.x = rotation[0];
+			write.rotation.y = rotation[1];
+			write.rotation.z = rotation[2];
+			write.rotation.w = rotation[3];
+
+			const f32* scale = &scales[i * 3];
+			write.scale = vec3(scale[0], scale[1], scale[2]);
+		}
+
+		return 0;
+	}
+
+	// Entities.Promote(instanceID)
+	// Queues a static map placement to be turned into an entity after the script update, from then on it shows up in queries like any other model
+	i32 EntityHandler::Promote(lua_State* state)
+	{
+		u32 instanceID = static_cast<u32>(luaL_checkunsigned(state, 1));
+
+		entt::registry* registry = GetEntityRegistry(state);
+
+		auto* transformWrites = registry->ctx().find<ECS::Singletons::ScriptTransformWrites>();
+		if (transformWrites == nullptr)
+		{
+			luaL_error(state, "Entities.Promote : The registry doesn't accept writes from scripts");
+		}
+
+		std::scoped_lock lock(transformWrites->mutex);
+		transformWrites->promotions.push_back(instanceID);
+
+		return 0;
+	}
+
+	// Entities.ResolveName(name) -> string
+	// Returns the string behind a name handle from a query, or an empty string if the handle isn't valid
+	i32 EntityHandler::ResolveName(lua_State* state)
+	{
+		Util::InternedString handle;
+		handle.id = static_cast<u32>(luaL_checkunsigned(state, 1));
+
+		const std::string& name = Util::StringInterner::Resolve(handle);
+		lua_pushlstring(state, name.c_str(), name.size());
+
+		return 1;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "LuaHandlerBase.h"
+#include "Game/Scripting/LuaDefines.h"
+
+#include <Base/Types.h>
+
+#include <entt/fwd.hpp>
+
+namespace Scripting
+{
+	class LuaEntityBenchmark;
+
+	// Bulk access to entity components. Entities.Query copies the components of every entity matching the query into Luau buffers,
+	// one array per field, and Entities.Commit queues the transforms of a query to be written back. Queries only read the registry,
+	// so they can run from every script system at once, the writes are applied after the script update.
+	// Static map placements only show up in queries once Entities.Promote turned them into an entity, which also happens after the script update.
+	class EntityHandler : public LuaHandlerBase
+	{
+	public:
+		// Applies every queued write and flags the transforms that changed as dirty, no script may be running
+		static void ApplyWrites(entt::registry& registry);
+
+	private:
+		friend LuaEntityBenchmark;
+
+		void Register();
+		void Clear() { }
+
+	private: // Registered Functions
+		static i32 Query(lua_State* state);
+		static i32 Commit(lua_State* state);
+		static i32 Promote(lua_State* state);
+		static i32 ResolveName(lua_State* state);
+	};
+}
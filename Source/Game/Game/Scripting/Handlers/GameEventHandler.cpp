@@ -5,6 +5,8 @@
 #include "Game/Scripting/Systems/LuaSystemBase.h"
 #include "Game/Util/ServiceLocator.h"
 
+#include <Base/Util/StringUtils.h>
+
 #include <lualib.h>
 
 namespace Scripting
@@ -47,17 +49,14 @@ namespace Scripting
 			return;
 		}
 
+		// Dispatching isn't reentrant, so the start of one is a safe point to pick up callbacks registered since the last
+		FlushEvents(state);
+
 		_eventToFuncHandlerList[eventID](state, eventID, data);
 	}
-	void GameEventHandler::RegisterEventCallback(lua_State* state, u32 eventID, i32 funcHandle)
+	void GameEventHandler::RegisterEventCallback(lua_State* state, u32 eventID, i32 funcHandle, u32 scriptHash)
 	{
-		LuaManager* luaManager = ServiceLocator::GetLuaManager();
-
-		u32 id = eventID;
-		u64 key = reinterpret_cast<u64>(state);
-
-		std::vector<i32>& funcRefList = _eventToLuaStateFuncRefList[id][key];
-		funcRefList.push_back(funcHandle);
+		AddEventCallback(state, eventID, { funcHandle, scriptHash });
 	}
 	
 	i32 GameEventHandler::RegisterGameEvent(lua_State* state)
@@ -79,10 +78,18 @@ namespace Scripting
 
 		i32 funcHandle = ctx.GetRef(2);
 
+		// The chunk name of the calling function tells us which script the callback belongs to
+		u32 scriptHash = 0;
+		lua_Debug debugInfo;
+		if (lua_getinfo(state, 1, "s", &debugInfo) && debugInfo.source != nullptr)
+		{
+			scriptHash = StringUtils::fnv1a_32(debugInfo.source, strlen(debugInfo.source));
+		}
+
 		LuaManager* luaManager = ServiceLocator::GetLuaManager();
 		auto gameEventHandler = luaManager->GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
 
-		gameEventHandler->RegisterEventCallback(state, eventID, funcHandle);
+		gameEventHandler->RegisterEventCallback(state, eventID, funcHandle, scriptHash);
 
 		return 0;
 	}
@@ -92,20 +99,30 @@ namespace Scripting
 		LuaManager* luaManager = ServiceLocator::GetLuaManager();
 		auto eventData = reinterpret_cast<LuaGameEventLoadedData*>(data);
 
-		u32 id = eventID;
-		u64 key = reinterpret_cast<u64>(state);
+		LuaEventTable* eventTable = GetEventTable(state);
+		if (eventTable == nullptr)
+			return 0;
 
+		u32 id = eventID;
 		LuaStateCtx ctx(state);
 
-		std::vector<i32>& funcRefList = _eventToLuaStateFuncRefList[id][key];
-		for (i32 funcHandle : funcRefList)
+		const std::vector<LuaEventCallback>& callbacks = eventTable->eventToCallbacks[id];
+		for (const LuaEventCallback& callback : callbacks)
 		{
-			ctx.PushLFunction(funcHandle, false);
+			ctx.PushLFunction(callback.funcRef, false);
 			ctx.PushNumber(id);
 			ctx.PushString(eventData->motd.c_str());
 			ctx.PCall();
 		}
 
+		eventTable->taskScheduler->ResumeEventTasks(id, [id, eventData](lua_State* thread)
+		{
+			LuaStateCtx threadCtx(thread);
+			threadCtx.PushNumber(id, false);
+			threadCtx.PushString(eventData->motd.c_str(), false);
+			return 2;
+		});
+
 		return 0;
 	}
 
@@ -114,20 +131,30 @@ namespace Scripting
 		LuaManager* luaManager = ServiceLocator::GetLuaManager();
 		auto eventData = reinterpret_cast<LuaGameEventUpdatedData*>(data);
 
-		u32 id = eventID;
-		u64 key = reinterpret_cast<u64>(state);
+		LuaEventTable* eventTable = GetEventTable(state);
+		if (eventTable == nullptr)
+			return 0;
 
+		u32 id = eventID;
 		LuaStateCtx ctx(state);
 
-		std::vector<i32>& funcRefList = _eventToLuaStateFuncRefList[id][key];
-		for (i32 funcHandle : funcRefList)
+		const std::vector<LuaEventCallback>& callbacks = eventTable->eventToCallbacks[id];
+		for (const LuaEventCallback& callback : callbacks)
 		{
-			ctx.PushLFunction(funcHandle, false);
+			ctx.PushLFunction(callback.funcRef, false);
 			ctx.PushNumber(id);
 			ctx.PushNumber(eventData->deltaTime);
 			ctx.PCall();
 		}
 
+		eventTable->taskScheduler->ResumeEventTasks(id, [id, eventData](lua_State* thread)
+		{
+			LuaStateCtx threadCtx(thread);
+			threadCtx.PushNumber(id, false);
+			threadCtx.PushNumber(eventData->deltaTime, false);
+			return 2;
+		});
+
 		return 0;
 	}
 
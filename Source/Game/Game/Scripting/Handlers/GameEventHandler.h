@@ -14,7 +14,7 @@ namespace Scripting
 	public:
 		void SetEventHandler(u32 eventID, EventHandlerFn fn);
 		void CallEvent(lua_State* state, u32 eventID, LuaEventData* data);
-		void RegisterEventCallback(lua_State* state, u32 eventID, i32 funcHandle);
+		void RegisterEventCallback(lua_State* state, u32 eventID, i32 funcHandle, u32 scriptHash);
 
 	private:
 		void Register();
@@ -1,9 +1,9 @@
 #include "GlobalHandler.h"
 #include "Game/ECS/Util/MapDBUtil.h"
 #include "Game/ECS/Singletons/MapDB.h"
-#include "Game/Scripting/LuaStateCtx.h"
 
 #include "Game/Scripting/LuaManager.h"
+#include "Game/Scripting/LuaTaskScheduler.h"
 #include "Game/Scripting/Systems/LuaSystemBase.h"
 #include "Game/Util/ServiceLocator.h"
 #include "Game/Rendering/GameRenderer.h"
@@ -15,21 +15,15 @@
 
 namespace Scripting
 {
-	struct Panel
-	{
-	public:
-		vec3 position;
-		vec3 extents;
-	};
-
 	void GlobalHandler::Register()
 	{
 		LuaManager* luaManager = ServiceLocator::GetLuaManager();
 
-		luaManager->SetGlobal("AddCursor", AddCursor, true);
-		luaManager->SetGlobal("SetCursor", SetCursor, true);
-		luaManager->SetGlobal("GetCurrentMap", GetCurrentMap, true);
-		luaManager->SetGlobal("LoadMap", LoadMap, true);
+		luaManager->SetGlobal("AddCursor", LuaBind<AddCursor>, true);
+		luaManager->SetGlobal("SetCursor", LuaBind<SetCursor>, true);
+		luaManager->SetGlobal("GetCurrentMap", LuaBind<GetCurrentMap>, true);
+		luaManager->SetGlobal("LoadMap", LuaBind<LoadMap>, true);
+		luaManager->SetGlobal("LoadMapAsync", LuaBind<LoadMapAsync>, true);
 
 		LuaTable engineTable =
 		{
@@ -44,17 +38,18 @@ namespace Scripting
 		LuaTable panelTable =
 		{
 			{
-				{ "new", PanelCreate },
-				{ "GetPosition", PanelGetPosition },
-				{ "GetSize", PanelGetExtents }
+				{ "new", LuaBind<PanelCreate> },
+				{ "GetPosition", LuaBind<PanelGetPosition> },
+				{ "GetSize", LuaBind<PanelGetExtents> }
 			}
 		};
 
 		LuaTable panelMetaTable =
 		{
 			{
-				{ "__tostring", PanelToString },
-				{ "__index", PanelIndex }
+				{ "__tostring", LuaBind<PanelToString> },
+				{ "__index", LuaIndex<Panel> },
+				{ "__newindex", LuaNewIndex<Panel> }
 			},
 
 			true
@@ -64,73 +59,39 @@ namespace Scripting
 		luaManager->SetGlobal("PanelMetaTable", panelMetaTable, true);
 	}
 
-	i32 GlobalHandler::AddCursor(lua_State* state)
+	bool GlobalHandler::AddCursor(const char* cursorName, const char* cursorPath)
 	{
-		LuaStateCtx ctx(state);
-
-		const char* cursorName = ctx.GetString(nullptr, 1);
-		const char* cursorPath = ctx.GetString(nullptr, 2);
-
 		if (cursorName == nullptr || cursorPath == nullptr)
-		{
-			ctx.PushBool(false);
-			return 1;
-		}
+			return false;
 
 		u32 hash = StringUtils::fnv1a_32(cursorName, strlen(cursorName));
 		std::string path = cursorPath;
 
 		GameRenderer* gameRenderer = ServiceLocator::GetGameRenderer();
-		bool result = gameRenderer->AddCursor(hash, path);
-
-		ctx.PushBool(result);
-		return 1;
+		return gameRenderer->AddCursor(hash, path);
 	}
-	i32 GlobalHandler::SetCursor(lua_State* state)
+	bool GlobalHandler::SetCursor(const char* cursorName)
 	{
-		LuaStateCtx ctx(state);
-
-		const char* cursorName = ctx.GetString();
 		if (cursorName == nullptr)
-		{
-			ctx.PushBool(false);
-			return 1;
-		}
+			return false;
 
 		u32 hash = StringUtils::fnv1a_32(cursorName, strlen(cursorName));
 
 		GameRenderer* gameRenderer = ServiceLocator::GetGameRenderer();
-		bool result = gameRenderer->SetCursor(hash);
-
-		ctx.PushBool(result);
-		return 1;
+		return gameRenderer->SetCursor(hash);
 	}
-	i32 GlobalHandler::GetCurrentMap(lua_State* state)
+	const std::string& GlobalHandler::GetCurrentMap()
 	{
-		LuaStateCtx ctx(state);
-
-		const std::string& currentMapInternalName = ServiceLocator::GetGameRenderer()->GetTerrainLoader()->GetCurrentMapInternalName();
-
-		ctx.PushString(currentMapInternalName.c_str());
-		return 1;
+		return ServiceLocator::GetGameRenderer()->GetTerrainLoader()->GetCurrentMapInternalName();
 	}
-	i32 GlobalHandler::LoadMap(lua_State* state)
+	static bool QueueMapLoad(const char* mapName, std::function<void(bool)>&& onComplete)
 	{
-		LuaStateCtx ctx(state);
-
-		const char* mapName = ctx.GetString();
 		if (mapName == nullptr)
-		{
-			ctx.PushBool(false);
-			return 1;
-		}
+			return false;
 
 		DB::Client::Definitions::Map* map = ECS::Util::MapDB::GetMapFromName(mapName);
 		if (map == nullptr)
-		{
-			ctx.PushBool(false);
-			return 1;
-		}
+			return false;
 
 		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
 		entt::registry::context& registryContext = registry->ctx();
@@ -141,86 +102,60 @@ namespace Scripting
 		TerrainLoader::LoadDesc loadDesc;
 		loadDesc.loadType = TerrainLoader::LoadType::Full;
 		loadDesc.mapName = interalName;
+		loadDesc.onComplete = std::move(onComplete);
 
 		TerrainLoader* terrainLoader = ServiceLocator::GetGameRenderer()->GetTerrainLoader();
 		terrainLoader->AddInstance(loadDesc);
 
-		ctx.PushBool(true);
-		return 1;
+		return true;
+	}
+	bool GlobalHandler::LoadMap(const char* mapName)
+	{
+		return QueueMapLoad(mapName, nullptr);
 	}
-	i32 GlobalHandler::PanelCreate(lua_State* state)
+	// Returns an operation for Task.Await, or nil if the map doesn't exist. Awaiting it returns whether the map loaded, once it completes
+	// the terrain is loaded and the placements are queued, the models keep streaming in over the following frames
+	std::optional<u32> GlobalHandler::LoadMapAsync(const char* mapName)
 	{
-		LuaStateCtx ctx(state);
+		u32 operationID = LuaTaskScheduler::BeginOperation();
 
-		Panel* panel = ctx.PushUserData<Panel>([](void* x) {
-			// Very sad panel is gone now :(
+		bool result = QueueMapLoad(mapName, [operationID](bool success)
+		{
+			LuaTaskScheduler::CompleteOperation(operationID, success);
 		});
 
-		panel->position = vec3(25.0f, 50.0f, 0);
-		panel->extents = vec3(1.5f, 1.5f, 0);
-
-		luaL_getmetatable(state, "PanelMetaTable");
-		lua_setmetatable(state, -2);
+		if (!result)
+		{
+			LuaTaskScheduler::CompleteOperation(operationID, false);
+			return std::nullopt;
+		}
 
-		return 1;
+		return operationID;
 	}
-	i32 GlobalHandler::PanelGetPosition(lua_State* state)
+	Panel GlobalHandler::PanelCreate()
 	{
-		LuaStateCtx ctx(state);
-
-		Panel* panel = ctx.GetUserData<Panel>();
-		ctx.PushNumber(panel->position.x);
-		ctx.PushNumber(panel->position.y);
+		Panel panel;
+		panel.position = vec3(25.0f, 50.0f, 0);
+		panel.extents = vec3(1.5f, 1.5f, 0);
 
-		return 2;
+		return panel;
 	}
-	i32 GlobalHandler::PanelGetExtents(lua_State* state)
+	std::tuple<f32, f32> GlobalHandler::PanelGetPosition(const Panel* panel)
 	{
-		LuaStateCtx ctx(state);
+		if (panel == nullptr)
+			return { 0.0f, 0.0f };
 
-		Panel* panel = ctx.GetUserData<Panel>();
-		ctx.PushNumber(panel->extents.x);
-		ctx.PushNumber(panel->extents.y);
-
-		return 2;
+		return { panel->position.x, panel->position.y };
 	}
-	i32 GlobalHandler::PanelToString(lua_State* state)
+	std::tuple<f32, f32> GlobalHandler::PanelGetExtents(const Panel* panel)
 	{
-		LuaStateCtx ctx(state);
+		if (panel == nullptr)
+			return { 0.0f, 0.0f };
 
-		ctx.PushString("Here is a panel :o");
-		return 1;
+		return { panel->extents.x, panel->extents.y };
 	}
-	i32 GlobalHandler::PanelIndex(lua_State* state)
+	const char* GlobalHandler::PanelToString(const Panel* panel)
 	{
-		LuaStateCtx ctx(state);
-
-		Panel* panel = ctx.GetUserData<Panel>(nullptr, 1);
-		const char* key = ctx.GetString(nullptr, 2);
-		u32 keyHash = StringUtils::fnv1a_32(key, strlen(key));
-
-		switch (keyHash)
-		{
-			case "position"_h:
-			{
-				ctx.PushVector(panel->position);
-				break;
-			}
-			case "extents"_h:
-			{
-				ctx.PushVector(panel->extents);
-				break;
-			}
-
-			default:
-			{
-				ctx.GetGlobal("Panel");
-				ctx.PushString(key);
-				ctx.GetRaw(-2);
-			}
-		}
-
-		return 1;
+		return "Here is a panel :o";
 	}
-
 }
@@ -1,11 +1,35 @@
 #pragma once
 #include "LuaHandlerBase.h"
+#include "Game/Scripting/LuaBinding.h"
 #include "Game/Scripting/LuaDefines.h"
 
 #include <Base/Types.h>
+#include <Base/Util/Reflection.h>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <tuple>
 
 namespace Scripting
 {
+	struct Panel
+	{
+	public:
+		vec3 position;
+		vec3 extents;
+	};
+
+	template <>
+	struct LuaUserData<Panel>
+	{
+	public:
+		static constexpr bool IsBound = true;
+		static constexpr LuaUserDataType Tag = LuaUserDataType::Panel;
+		static constexpr const char* MetaTableName = "PanelMetaTable";
+		static constexpr const char* MethodTableName = "Panel";
+	};
+
 	class GlobalHandler : public LuaHandlerBase
 	{
 	private:
@@ -13,15 +37,20 @@ namespace Scripting
 		void Clear() { }
 
 	private: // Registered Functions
-		static i32 AddCursor(lua_State* state);
-		static i32 SetCursor(lua_State* state);
-		static i32 GetCurrentMap(lua_State* state);
-		static i32 LoadMap(lua_State* state);
-
-		static i32 PanelCreate(lua_State* state);
-		static i32 PanelGetPosition(lua_State* state);
-		static i32 PanelGetExtents(lua_State* state);
-		static i32 PanelToString(lua_State* state);
-		static i32 PanelIndex(lua_State* state);
+		static bool AddCursor(const char* cursorName, const char* cursorPath);
+		static bool SetCursor(const char* cursorName);
+		static const std::string& GetCurrentMap();
+		static bool LoadMap(const char* mapName);
+		static std::optional<u32> LoadMapAsync(const char* mapName);
+
+		static Panel PanelCreate();
+		static std::tuple<f32, f32> PanelGetPosition(const Panel* panel);
+		static std::tuple<f32, f32> PanelGetExtents(const Panel* panel);
+		static const char* PanelToString(const Panel* panel);
 	};
-}
\ No newline at end of file
+}
+
+REFL_TYPE(Scripting::Panel)
+	REFL_FIELD(position)
+	REFL_FIELD(extents)
+REFL_END
\ No newline at end of file
@@ -1,18 +1,39 @@
 #pragma once
 #include "LuaHandlerBase.h"
+#include "Game/Scripting/LuaTaskScheduler.h"
 
 #include <Base/Types.h>
 
-#include <robinhood/robinhood.h>
+#include <lua.h>
+#include <lualib.h>
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 
-struct lua_State;
-
 namespace Scripting
 {
 	struct LuaEventData;
 
+	struct LuaEventCallback
+	{
+	public:
+		i32 funcRef;
+		u32 scriptHash; // Hash of the chunk name of the script that registered the callback, used to drop it when that script is reloaded
+	};
+
+	// Callbacks a single state registered, indexed by event id. Only the thread running the state ever touches it, so dispatching
+	// needs no locks. Callbacks registered while the state runs are kept in pendingCallbacks until the next safe point.
+	struct LuaEventTable
+	{
+	public:
+		std::vector<std::vector<LuaEventCallback>> eventToCallbacks;
+		std::vector<std::pair<u32, LuaEventCallback>> pendingCallbacks;
+
+		LuaTaskScheduler* taskScheduler = nullptr; // Tasks of the state, including the ones waiting on these events
+	};
+
+	// The event table of a state is stored as its thread data, so there must only be one event handler per state
 	class LuaEventHandlerBase : public LuaHandlerBase
 	{
 	public:
@@ -20,20 +41,18 @@ namespace Scripting
 
 		LuaEventHandlerBase(u32 numEvents) : LuaHandlerBase(), _numEvents(numEvents)
 		{
-			_eventToLuaStateFuncRefList.resize(numEvents);
 			_eventToFuncHandlerList.resize(numEvents);
+			_states.reserve(32);
 
 			Clear();
 		}
 
 		void Clear()
 		{
-			for (u32 i = 0; i < _eventToLuaStateFuncRefList.size(); i++)
+			// Every state in here is alive, they are removed through ClearEvents before being closed
+			for (lua_State* state : _states)
 			{
-				robin_hood::unordered_map<u64, std::vector<i32>>& luaStateToFuncRefList = _eventToLuaStateFuncRefList[i];
-
-				luaStateToFuncRefList.clear();
-				luaStateToFuncRefList.reserve(32);
+				ReleaseCallbacks(state, *GetEventTable(state));
 			}
 
 			for (u32 i = 0; i < _eventToFuncHandlerList.size(); i++)
@@ -42,39 +61,146 @@ namespace Scripting
 			}
 		}
 
-		virtual void RegisterEventCallback(lua_State* state, u32 eventID, i32 funcHandle) = 0;
+		virtual void RegisterEventCallback(lua_State* state, u32 eventID, i32 funcHandle, u32 scriptHash) = 0;
 		virtual void SetEventHandler(u32 eventID, EventHandlerFn fn) = 0;
 		virtual void CallEvent(lua_State* state, u32 eventID, LuaEventData* data) = 0;
 
+		// SetupEvents and ClearEvents must only be called while the state isn't running
 		void SetupEvents(lua_State* state)
 		{
-			u64 key = reinterpret_cast<u64>(state);
+			LuaEventTable* eventTable = GetEventTable(state);
+			if (eventTable != nullptr)
+			{
+				ReleaseCallbacks(state, *eventTable);
+				return;
+			}
+
+			eventTable = new LuaEventTable();
+			eventTable->eventToCallbacks.resize(_numEvents);
+			eventTable->pendingCallbacks.reserve(16);
+			eventTable->taskScheduler = new LuaTaskScheduler(state, _numEvents);
 
-			for (u32 i = 0; i < _eventToLuaStateFuncRefList.size(); i++)
+			lua_setthreaddata(state, eventTable);
+			_states.push_back(state);
+
+			// Coroutines and tasks created by the state share its event table, so they can register callbacks and await like the state itself
+			lua_callbacks(state)->userthread = InheritEventTable;
+		}
+		void ClearEvents(lua_State* state)
+		{
+			LuaEventTable* eventTable = GetEventTable(state);
+			if (eventTable == nullptr)
+				return;
+
+			// States can be threads that get reused, so the refs have to be released even though the state stays alive
+			ReleaseCallbacks(state, *eventTable);
+
+			delete eventTable->taskScheduler;
+			delete eventTable;
+			lua_setthreaddata(state, nullptr);
+
+			auto itr = std::find(_states.begin(), _states.end(), state);
+			if (itr != _states.end())
 			{
-				robin_hood::unordered_map<u64, std::vector<i32>>& luaStateToFuncRefList = _eventToLuaStateFuncRefList[i];
+				_states.erase(itr);
+			}
+		}
+		void ClearScriptEvents(lua_State* state, u32 scriptHash)
+		{
+			LuaEventTable* eventTable = GetEventTable(state);
+			if (eventTable == nullptr)
+				return;
 
-				std::vector<i32>& funcRefList = luaStateToFuncRefList[key];
-				funcRefList.clear();
-				funcRefList.reserve(16);
+			FlushEvents(state);
+			eventTable->taskScheduler->ClearScriptTasks(scriptHash);
+
+			for (std::vector<LuaEventCallback>& callbacks : eventTable->eventToCallbacks)
+			{
+				for (u32 i = 0; i < callbacks.size();)
+				{
+					if (callbacks[i].scriptHash != scriptHash)
+					{
+						i++;
+						continue;
+					}
+
+					// Keep the registration order of the remaining callbacks intact
+					lua_unref(state, callbacks[i].funcRef);
+					callbacks.erase(callbacks.begin() + i);
+				}
 			}
 		}
-		void ClearEvents(lua_State* state)
+
+		// Moves callbacks registered since the last call into the event table, must not be called while the state is dispatching an event
+		void FlushEvents(lua_State* state)
+		{
+			LuaEventTable* eventTable = GetEventTable(state);
+			if (eventTable == nullptr)
+				return;
+
+			for (auto& pair : eventTable->pendingCallbacks)
+			{
+				eventTable->eventToCallbacks[pair.first].push_back(pair.second);
+			}
+
+			eventTable->pendingCallbacks.clear();
+		}
+
+		static LuaEventTable* GetEventTable(lua_State* state)
+		{
+			return reinterpret_cast<LuaEventTable*>(lua_getthreaddata(state));
+		}
+
+	protected:
+		void AddEventCallback(lua_State* state, u32 eventID, const LuaEventCallback& callback)
+		{
+			LuaEventTable* eventTable = GetEventTable(state);
+			if (eventTable == nullptr)
+			{
+				lua_unref(state, callback.funcRef);
+				luaL_error(state, "RegisterGameEvent : The calling thread has no event table, callbacks can't be registered from it");
+			}
+
+			// The state might be iterating over the callbacks of this very event right now
+			eventTable->pendingCallbacks.push_back({ eventID, callback });
+		}
+
+	private:
+		// Called by the VM for every thread it creates and with a null parent for every thread it destroys
+		static void InheritEventTable(lua_State* parent, lua_State* thread)
 		{
-			u64 key = reinterpret_cast<u64>(state);
+			if (parent == nullptr)
+				return;
+
+			lua_setthreaddata(thread, lua_getthreaddata(parent));
+		}
 
-			for (u32 i = 0; i < _eventToLuaStateFuncRefList.size(); i++)
+		void ReleaseCallbacks(lua_State* state, LuaEventTable& eventTable)
+		{
+			for (std::vector<LuaEventCallback>& callbacks : eventTable.eventToCallbacks)
 			{
-				robin_hood::unordered_map<u64, std::vector<i32>>& luaStateToFuncRefList = _eventToLuaStateFuncRefList[i];
+				for (const LuaEventCallback& callback : callbacks)
+				{
+					lua_unref(state, callback.funcRef);
+				}
+
+				callbacks.clear();
+			}
 
-				luaStateToFuncRefList.erase(key);
+			for (auto& pair : eventTable.pendingCallbacks)
+			{
+				lua_unref(state, pair.second.funcRef);
 			}
+
+			eventTable.pendingCallbacks.clear();
+
+			eventTable.taskScheduler->Clear();
 		}
 
 	protected:
 		const u32 _numEvents;
 
-		std::vector<robin_hood::unordered_map<u64, std::vector<i32>>> _eventToLuaStateFuncRefList;
 		std::vector<EventHandlerFn> _eventToFuncHandlerList;
+		std::vector<lua_State*> _states; // Only changes through SetupEvents and ClearEvents
 	};
 }
\ No newline at end of file
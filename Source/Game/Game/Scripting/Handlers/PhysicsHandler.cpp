@@ -0,0 +1,116 @@
+#include "PhysicsHandler.h"
+#include "Game/Application/EnttRegistries.h"
+#include "Game/ECS/Singletons/JoltState.h"
+#include "Game/Physics/SceneQuery.h"
+#include "Game/Scripting/LuaBinding.h"
+#include "Game/Scripting/LuaManager.h"
+#include "Game/Scripting/LuaStateCtx.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <entt/entt.hpp>
+#include <lualib.h>
+
+#include <vector>
+
+namespace Scripting
+{
+	static Jolt::SceneQuery& GetSceneQuery()
+	{
+		entt::registry* registry = ServiceLocator::GetEnttRegistries()->gameRegistry;
+		return registry->ctx().at<ECS::Singletons::JoltState>().sceneQuery;
+	}
+
+	void PhysicsHandler::Register()
+	{
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+
+		LuaTable physicsTable =
+		{
+			{
+				{ "Raycast", LuaBind<Raycast> },
+				{ "RaycastBatch", RaycastBatch },
+				{ "OverlapSphere", LuaBind<OverlapSphere> }
+			}
+		};
+
+		luaManager->SetGlobal("Physics", physicsTable, true);
+	}
+
+	// Physics.Raycast(origin, direction) -> hit, position, entity
+	std::tuple<bool, std::optional<vec3>, std::optional<u32>> PhysicsHandler::Raycast(const vec3& origin, const vec3& direction)
+	{
+		Jolt::RayQuery ray;
+		ray.origin = origin;
+		ray.direction = direction;
+
+		Jolt::RayHit hit;
+		if (!GetSceneQuery().CastRay(ray, hit))
+			return { false, std::nullopt, std::nullopt };
+
+		return { true, hit.position, static_cast<u32>(hit.userData) };
+	}
+
+	// Physics.RaycastBatch(origins, directions) -> { fraction, entity, fraction, entity, ... }
+	// Rays that miss get a fraction of 1 and an entity of -1
+	i32 PhysicsHandler::RaycastBatch(lua_State* state)
+	{
+		LuaStateCtx ctx(state);
+
+		if (!lua_istable(state, 1) || !lua_istable(state, 2))
+		{
+			ctx.PushNil();
+			return 1;
+		}
+
+		u32 numRays = static_cast<u32>(glm::min(lua_objlen(state, 1), lua_objlen(state, 2)));
+
+		std::vector<Jolt::RayQuery> rays(numRays);
+		for (u32 i = 0; i < numRays; i++)
+		{
+			lua_rawgeti(state, 1, i + 1);
+			rays[i].origin = ctx.GetVector();
+			lua_rawgeti(state, 2, i + 1);
+			rays[i].direction = ctx.GetVector();
+			lua_pop(state, 2);
+		}
+
+		std::vector<Jolt::RayHit> hits(numRays);
+		GetSceneQuery().CastRays(rays.data(), numRays, hits.data());
+
+		lua_createtable(state, numRays * 2, 0);
+		for (u32 i = 0; i < numRays; i++)
+		{
+			const Jolt::RayHit& hit = hits[i];
+
+			lua_pushnumber(state, hit.fraction);
+			lua_rawseti(state, -2, (i * 2) + 1);
+
+			lua_pushnumber(state, hit.IsHit() ? static_cast<f64>(static_cast<u32>(hit.userData)) : -1.0);
+			lua_rawseti(state, -2, (i * 2) + 2);
+		}
+
+		return 1;
+	}
+
+	// Physics.OverlapSphere(center, radius, maxHits = 32) -> { entity, entity, ... }
+	std::vector<u32> PhysicsHandler::OverlapSphere(const vec3& center, f32 radius, std::optional<u32> maxHits)
+	{
+		Jolt::SphereOverlapQuery query;
+		query.center = center;
+		query.radius = radius;
+
+		std::vector<Jolt::OverlapResult> results;
+		std::vector<Jolt::OverlapHit> hits;
+		GetSceneQuery().OverlapSpheres(&query, 1, maxHits.value_or(32), results, hits);
+
+		const Jolt::OverlapResult& result = results[0];
+
+		std::vector<u32> entities(result.count);
+		for (u32 i = 0; i < result.count; i++)
+		{
+			entities[i] = static_cast<u32>(hits[result.offset + i].userData);
+		}
+
+		return entities;
+	}
+}
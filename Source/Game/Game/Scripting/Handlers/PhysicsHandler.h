@@ -0,0 +1,24 @@
+#pragma once
+#include "LuaHandlerBase.h"
+#include "Game/Scripting/LuaDefines.h"
+
+#include <Base/Types.h>
+
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace Scripting
+{
+	class PhysicsHandler : public LuaHandlerBase
+	{
+	private:
+		void Register();
+		void Clear() { }
+
+	private: // Registered Functions
+		static std::tuple<bool, std::optional<vec3>, std::optional<u32>> Raycast(const vec3& origin, const vec3& direction);
+		static i32 RaycastBatch(lua_State* state);
+		static std::vector<u32> OverlapSphere(const vec3& center, f32 radius, std::optional<u32> maxHits);
+	};
+}
@@ -0,0 +1,113 @@
+#include "TaskHandler.h"
+#include "Game/Scripting/LuaManager.h"
+#include "Game/Scripting/LuaTaskScheduler.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <lualib.h>
+
+namespace Scripting
+{
+	// Waiting is only possible from a task, the state itself is resumed by the engine and a coroutine the script created itself
+	// with coroutine.create would be resumed from two places at once
+	static LuaTaskScheduler* GetWaitingTaskScheduler(lua_State* state, const char* functionName)
+	{
+		LuaTaskScheduler* scheduler = LuaTaskScheduler::Get(state);
+		if (scheduler == nullptr || !scheduler->IsTask(state) || !lua_isyieldable(state))
+		{
+			luaL_error(state, "%s : Can only be called from a function started through Task.Spawn", functionName);
+		}
+
+		return scheduler;
+	}
+
+	void TaskHandler::Register()
+	{
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+
+		LuaTable taskTable =
+		{
+			{
+				{ "Spawn", Spawn },
+				{ "Wait", Wait },
+				{ "WaitForEvent", WaitForEvent },
+				{ "Await", Await }
+			}
+		};
+
+		luaManager->SetGlobal("Task", taskTable, true);
+	}
+
+	// Task.Spawn(fn, ...) -> task
+	// Runs fn(...) until it finishes or waits for the first time
+	i32 TaskHandler::Spawn(lua_State* state)
+	{
+		luaL_checktype(state, 1, LUA_TFUNCTION);
+
+		LuaTaskScheduler* scheduler = LuaTaskScheduler::Get(state);
+		if (scheduler == nullptr)
+		{
+			luaL_error(state, "Task.Spawn : The state has no task scheduler");
+		}
+
+		i32 numArgs = lua_gettop(state) - 1;
+		scheduler->Spawn(state, numArgs);
+
+		return 1;
+	}
+
+	// Task.Wait(seconds) -> elapsed
+	// Without seconds the task is resumed in the next update
+	i32 TaskHandler::Wait(lua_State* state)
+	{
+		LuaTaskScheduler* scheduler = GetWaitingTaskScheduler(state, "Task.Wait");
+
+		f64 seconds = luaL_optnumber(state, 1, 0.0);
+		scheduler->WaitForTime(state, seconds);
+
+		return lua_yield(state, 0);
+	}
+
+	// Task.WaitForEvent(eventID) -> eventID, ...
+	// Resumed with the same arguments the callbacks of the event get, the next time the event fires for this state
+	i32 TaskHandler::WaitForEvent(lua_State* state)
+	{
+		LuaTaskScheduler* scheduler = GetWaitingTaskScheduler(state, "Task.WaitForEvent");
+
+		u32 eventID = static_cast<u32>(luaL_checkunsigned(state, 1));
+
+		LuaGameEvent gameEventID = static_cast<LuaGameEvent>(eventID);
+		if (gameEventID == LuaGameEvent::Invalid || gameEventID >= LuaGameEvent::Count)
+		{
+			luaL_error(state, "Task.WaitForEvent : %u is not a valid event", eventID);
+		}
+
+		scheduler->WaitForEvent(state, eventID);
+
+		return lua_yield(state, 0);
+	}
+
+	// Task.Await(operation) -> success
+	// Waits for an engine operation, like the one returned by LoadMapAsync, and returns right away if it's already complete.
+	// Returns whether the operation succeeded, or nil if it completed so long ago that its result is no longer known
+	i32 TaskHandler::Await(lua_State* state)
+	{
+		u32 operationID = static_cast<u32>(luaL_checkunsigned(state, 1));
+
+		LuaTaskScheduler::OperationState operationState = LuaTaskScheduler::GetOperationState(operationID);
+		if (operationState == LuaTaskScheduler::OperationState::Invalid)
+		{
+			luaL_error(state, "Task.Await : %u is not a valid operation", operationID);
+		}
+
+		if (operationState != LuaTaskScheduler::OperationState::Pending)
+		{
+			LuaTaskScheduler::PushOperationResult(state, operationState);
+			return 1;
+		}
+
+		LuaTaskScheduler* scheduler = GetWaitingTaskScheduler(state, "Task.Await");
+		scheduler->WaitForOperation(state, operationID);
+
+		return lua_yield(state, 0);
+	}
+}
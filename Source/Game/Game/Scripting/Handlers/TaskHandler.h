@@ -0,0 +1,23 @@
+#pragma once
+#include "LuaHandlerBase.h"
+#include "Game/Scripting/LuaDefines.h"
+
+#include <Base/Types.h>
+
+namespace Scripting
+{
+	// Script side of the LuaTaskScheduler. Task.Spawn runs a function as a task, which can then wait without polling
+	// through Task.Wait, Task.WaitForEvent and Task.Await
+	class TaskHandler : public LuaHandlerBase
+	{
+	private:
+		void Register();
+		void Clear() { }
+
+	private: // Registered Functions
+		static i32 Spawn(lua_State* state);
+		static i32 Wait(lua_State* state);
+		static i32 WaitForEvent(lua_State* state);
+		static i32 Await(lua_State* state);
+	};
+}
@@ -0,0 +1,153 @@
+#include "LuaAllocator.h"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Scripting
+{
+	LuaAllocator::~LuaAllocator()
+	{
+		for (u8* page : _pages)
+		{
+			std::free(page);
+		}
+
+		_pages.clear();
+	}
+
+	void* LuaAllocator::Allocate(void* userData, void* ptr, size_t oldSize, size_t newSize)
+	{
+		LuaAllocator* allocator = reinterpret_cast<LuaAllocator*>(userData);
+		return allocator->Reallocate(ptr, oldSize, newSize);
+	}
+
+	void LuaAllocator::ResetFrameStats()
+	{
+		_numAllocations = 0;
+		_numFailedAllocations = 0;
+	}
+
+	void* LuaAllocator::Reallocate(void* ptr, size_t oldSize, size_t newSize)
+	{
+		if (ptr == nullptr)
+		{
+			oldSize = 0;
+		}
+
+		if (newSize == 0)
+		{
+			if (ptr != nullptr)
+			{
+				ReleaseBlock(ptr, oldSize);
+				_usedBytes -= oldSize;
+			}
+
+			return nullptr;
+		}
+
+		// Luau expects shrinking to always succeed, so only growing is held to the limit
+		if (newSize > oldSize && _hardLimit > 0 && _usedBytes + (newSize - oldSize) > _hardLimit)
+		{
+			_numFailedAllocations++;
+			return nullptr;
+		}
+
+		void* result = nullptr;
+
+		if (ptr != nullptr && IsSmall(oldSize) && IsSmall(newSize) && GetSizeClass(oldSize) == GetSizeClass(newSize))
+		{
+			result = ptr;
+		}
+		else if (ptr != nullptr && !IsSmall(oldSize) && !IsSmall(newSize))
+		{
+			result = std::realloc(ptr, newSize);
+			if (result == nullptr)
+				return nullptr;
+
+			_largeBytes += newSize;
+			_largeBytes -= oldSize;
+		}
+		else
+		{
+			result = AllocateBlock(newSize);
+			if (result == nullptr)
+				return nullptr;
+
+			if (ptr != nullptr)
+			{
+				memcpy(result, ptr, std::min(oldSize, newSize));
+				ReleaseBlock(ptr, oldSize);
+			}
+
+			_numAllocations++;
+		}
+
+		_usedBytes += newSize;
+		_usedBytes -= oldSize;
+		_peakBytes = std::max(_peakBytes, _usedBytes);
+
+		return result;
+	}
+
+	void* LuaAllocator::AllocateBlock(size_t size)
+	{
+		if (!IsSmall(size))
+		{
+			void* block = std::malloc(size);
+			if (block != nullptr)
+			{
+				_largeBytes += size;
+			}
+
+			return block;
+		}
+
+		u32 sizeClass = GetSizeClass(size);
+
+		FreeBlock* freeBlock = _freeLists[sizeClass];
+		if (freeBlock != nullptr)
+		{
+			_freeLists[sizeClass] = freeBlock->next;
+			return freeBlock;
+		}
+
+		size_t blockSize = static_cast<size_t>(sizeClass + 1) * SIZE_CLASS_GRANULARITY;
+		if (_pageCursor == nullptr || _pageCursor + blockSize > _pageEnd)
+		{
+			ZoneScopedN("LuaAllocator::AllocatePage");
+
+			// The tail of the old page is lost, it is never more than a single block of the largest size class
+			u8* page = reinterpret_cast<u8*>(std::malloc(PAGE_SIZE));
+			if (page == nullptr)
+				return nullptr;
+
+			_pages.push_back(page);
+			_pageCursor = page;
+			_pageEnd = page + PAGE_SIZE;
+		}
+
+		void* block = _pageCursor;
+		_pageCursor += blockSize;
+
+		return block;
+	}
+
+	void LuaAllocator::ReleaseBlock(void* ptr, size_t size)
+	{
+		if (!IsSmall(size))
+		{
+			std::free(ptr);
+			_largeBytes -= size;
+			return;
+		}
+
+		u32 sizeClass = GetSizeClass(size);
+
+		FreeBlock* freeBlock = reinterpret_cast<FreeBlock*>(ptr);
+		freeBlock->next = _freeLists[sizeClass];
+		_freeLists[sizeClass] = freeBlock;
+	}
+}
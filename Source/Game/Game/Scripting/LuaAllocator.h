@@ -0,0 +1,66 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <vector>
+
+namespace Scripting
+{
+	// Allocator for a single Luau VM, passed to lua_newstate. Small blocks come from per size class free lists carved out of pages,
+	// larger ones go straight to the heap. A VM is only ever used by one thread at a time, so none of this needs locks.
+	// Growing past the hard limit fails, which Luau turns into a memory error in the script that allocated.
+	class LuaAllocator
+	{
+	public:
+		static constexpr u32 PAGE_SIZE = 64 * 1024;
+		static constexpr u32 SIZE_CLASS_GRANULARITY = 16;
+		static constexpr u32 MAX_SMALL_SIZE = 512;
+		static constexpr u32 NUM_SIZE_CLASSES = MAX_SMALL_SIZE / SIZE_CLASS_GRANULARITY;
+
+		LuaAllocator(size_t hardLimit) : _hardLimit(hardLimit) { }
+		~LuaAllocator();
+
+		// Matches lua_Alloc, userData is the LuaAllocator
+		static void* Allocate(void* userData, void* ptr, size_t oldSize, size_t newSize);
+
+		void SetHardLimit(size_t hardLimit) { _hardLimit = hardLimit; }
+		size_t GetHardLimit() const { return _hardLimit; }
+
+		size_t GetUsedBytes() const { return _usedBytes; }
+		size_t GetPeakBytes() const { return _peakBytes; }
+		size_t GetReservedBytes() const { return (_pages.size() * PAGE_SIZE) + _largeBytes; }
+
+		// These count since the last call to ResetFrameStats
+		u32 GetNumAllocations() const { return _numAllocations; }
+		u32 GetNumFailedAllocations() const { return _numFailedAllocations; }
+		void ResetFrameStats();
+
+	private:
+		struct FreeBlock
+		{
+		public:
+			FreeBlock* next;
+		};
+
+		void* Reallocate(void* ptr, size_t oldSize, size_t newSize);
+		void* AllocateBlock(size_t size);
+		void ReleaseBlock(void* ptr, size_t size);
+
+		static bool IsSmall(size_t size) { return size <= MAX_SMALL_SIZE; }
+		static u32 GetSizeClass(size_t size) { return static_cast<u32>((size + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY) - 1; }
+
+	private:
+		FreeBlock* _freeLists[NUM_SIZE_CLASSES] = { };
+
+		std::vector<u8*> _pages;
+		u8* _pageCursor = nullptr;
+		u8* _pageEnd = nullptr;
+
+		size_t _hardLimit = 0;
+		size_t _usedBytes = 0;
+		size_t _peakBytes = 0;
+		size_t _largeBytes = 0;
+
+		u32 _numAllocations = 0;
+		u32 _numFailedAllocations = 0;
+	};
+}
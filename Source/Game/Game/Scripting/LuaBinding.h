@@ -0,0 +1,333 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+#include <Base/Util/Reflection.h>
+
+#include <lua.h>
+#include <lualib.h>
+
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Scripting
+{
+	// Specialize this for a reflected struct to pass it to and from bound functions as tagged userdata.
+	// Tag is checked by Luau on access, MetaTableName is set on every pushed copy and MethodTableName is where
+	// LuaIndex<T> looks up keys that aren't fields
+	template <typename T>
+	struct LuaUserData
+	{
+	public:
+		static constexpr bool IsBound = false;
+	};
+
+	// Converts between C++ values and the Lua stack. Reading a value of the wrong type gives the default value,
+	// the same as the LuaStateCtx getters, but without checking the type separately from converting it
+	template <typename T, typename = void>
+	struct LuaType
+	{
+		static_assert(sizeof(T) == 0, "LuaType : No conversion to and from Lua exists for this type");
+	};
+
+	template <>
+	struct LuaType<bool>
+	{
+		static bool Get(lua_State* state, i32 index) { return lua_toboolean(state, index) != 0; }
+		static void Push(lua_State* state, bool value) { lua_pushboolean(state, value); }
+	};
+
+	template <>
+	struct LuaType<i32>
+	{
+		static i32 Get(lua_State* state, i32 index) { return lua_tointegerx(state, index, nullptr); }
+		static void Push(lua_State* state, i32 value) { lua_pushnumber(state, static_cast<f64>(value)); }
+	};
+
+	template <>
+	struct LuaType<u32>
+	{
+		static u32 Get(lua_State* state, i32 index) { return lua_tounsignedx(state, index, nullptr); }
+		static void Push(lua_State* state, u32 value) { lua_pushnumber(state, static_cast<f64>(value)); }
+	};
+
+	template <>
+	struct LuaType<f32>
+	{
+		static f32 Get(lua_State* state, i32 index) { return static_cast<f32>(lua_tonumberx(state, index, nullptr)); }
+		static void Push(lua_State* state, f32 value) { lua_pushnumber(state, static_cast<f64>(value)); }
+	};
+
+	template <>
+	struct LuaType<f64>
+	{
+		static f64 Get(lua_State* state, i32 index) { return lua_tonumberx(state, index, nullptr); }
+		static void Push(lua_State* state, f64 value) { lua_pushnumber(state, value); }
+	};
+
+	// Only valid while the value stays on the stack, which is the whole call for arguments
+	template <>
+	struct LuaType<const char*>
+	{
+		static const char* Get(lua_State* state, i32 index) { return lua_tolstring(state, index, nullptr); }
+		static void Push(lua_State* state, const char* value)
+		{
+			if (value == nullptr)
+			{
+				lua_pushnil(state);
+				return;
+			}
+
+			lua_pushstring(state, value);
+		}
+	};
+
+	template <>
+	struct LuaType<std::string_view>
+	{
+		static std::string_view Get(lua_State* state, i32 index)
+		{
+			size_t length = 0;
+			const char* value = lua_tolstring(state, index, &length);
+
+			return value != nullptr ? std::string_view(value, length) : std::string_view();
+		}
+		static void Push(lua_State* state, std::string_view value) { lua_pushlstring(state, value.data(), value.size()); }
+	};
+
+	template <>
+	struct LuaType<std::string>
+	{
+		static std::string Get(lua_State* state, i32 index) { return std::string(LuaType<std::string_view>::Get(state, index)); }
+		static void Push(lua_State* state, const std::string& value) { lua_pushlstring(state, value.c_str(), value.size()); }
+	};
+
+	template <>
+	struct LuaType<vec3>
+	{
+		static vec3 Get(lua_State* state, i32 index)
+		{
+			const f32* value = lua_tovector(state, index);
+			return value != nullptr ? vec3(value[0], value[1], value[2]) : vec3(0.0f, 0.0f, 0.0f);
+		}
+		static void Push(lua_State* state, const vec3& value) { lua_pushvector(state, value.x, value.y, value.z); }
+	};
+
+	// Missing and nil arguments read as std::nullopt, std::nullopt is pushed as nil
+	template <typename T>
+	struct LuaType<std::optional<T>>
+	{
+		static std::optional<T> Get(lua_State* state, i32 index)
+		{
+			if (lua_isnoneornil(state, index))
+				return std::nullopt;
+
+			return LuaType<T>::Get(state, index);
+		}
+		static void Push(lua_State* state, const std::optional<T>& value)
+		{
+			if (!value.has_value())
+			{
+				lua_pushnil(state);
+				return;
+			}
+
+			LuaType<T>::Push(state, *value);
+		}
+	};
+
+	// Arrays, anything that isn't a table reads as an empty vector
+	template <typename T>
+	struct LuaType<std::vector<T>>
+	{
+		static std::vector<T> Get(lua_State* state, i32 index)
+		{
+			std::vector<T> values;
+			if (!lua_istable(state, index))
+				return values;
+
+			index = lua_absindex(state, index);
+
+			i32 numValues = lua_objlen(state, index);
+			values.reserve(numValues);
+
+			for (i32 i = 1; i <= numValues; i++)
+			{
+				lua_rawgeti(state, index, i);
+				values.push_back(LuaType<T>::Get(state, -1));
+				lua_pop(state, 1);
+			}
+
+			return values;
+		}
+		static void Push(lua_State* state, const std::vector<T>& values)
+		{
+			i32 numValues = static_cast<i32>(values.size());
+			lua_createtable(state, numValues, 0);
+
+			for (i32 i = 0; i < numValues; i++)
+			{
+				LuaType<T>::Push(state, values[i]);
+				lua_rawseti(state, -2, i + 1);
+			}
+		}
+	};
+
+	// Bound structs are copied into a new userdata when pushed by value
+	template <typename T>
+	struct LuaType<T, std::enable_if_t<LuaUserData<T>::IsBound>>
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "LuaType : Bound userdata types can't have a destructor, Luau wouldn't call it for tagged userdata");
+
+		static T Get(lua_State* state, i32 index)
+		{
+			T* value = LuaType<T*>::Get(state, index);
+			return value != nullptr ? *value : T();
+		}
+		static void Push(lua_State* state, const T& value)
+		{
+			void* userData = lua_newuserdatatagged(state, sizeof(T), static_cast<i32>(LuaUserData<T>::Tag));
+			new (userData) T(value);
+
+			luaL_getmetatable(state, LuaUserData<T>::MetaTableName);
+			lua_setmetatable(state, -2);
+		}
+	};
+
+	// Pointers to bound structs read the userdata in place, anything else reads as nullptr
+	template <typename T>
+	struct LuaType<T*, std::enable_if_t<LuaUserData<std::remove_const_t<T>>::IsBound>>
+	{
+		static T* Get(lua_State* state, i32 index)
+		{
+			return static_cast<T*>(lua_touserdatatagged(state, index, static_cast<i32>(LuaUserData<std::remove_const_t<T>>::Tag)));
+		}
+	};
+
+	// Pushes a returned value, tuples are returned as multiple values
+	template <typename T>
+	i32 LuaPush(lua_State* state, const T& value)
+	{
+		LuaType<T>::Push(state, value);
+		return 1;
+	}
+	template <typename... Types>
+	i32 LuaPush(lua_State* state, const std::tuple<Types...>& values)
+	{
+		std::apply([state](const auto&... value)
+		{
+			(LuaType<std::decay_t<decltype(value)>>::Push(state, value), ...);
+		}, values);
+
+		return static_cast<i32>(sizeof...(Types));
+	}
+
+	template <typename Signature>
+	struct LuaFunction;
+
+	template <typename Result, typename... Args>
+	struct LuaFunction<Result(*)(Args...)>
+	{
+		template <auto Func>
+		static i32 Call(lua_State* state)
+		{
+			return Invoke<Func>(state, std::index_sequence_for<Args...>());
+		}
+
+		template <auto Func, size_t... Indices>
+		static i32 Invoke(lua_State* state, std::index_sequence<Indices...>)
+		{
+			if constexpr (std::is_void_v<Result>)
+			{
+				Func(LuaType<std::decay_t<Args>>::Get(state, static_cast<i32>(Indices) + 1)...);
+				return 0;
+			}
+			else
+			{
+				return LuaPush(state, Func(LuaType<std::decay_t<Args>>::Get(state, static_cast<i32>(Indices) + 1)...));
+			}
+		}
+	};
+
+	// Generates the lua_CFunction for a C++ function at compile time, each argument is read with the conversion for its type
+	// and the result is pushed the same way. Functions that need the state itself still have to be written by hand
+	template <auto Func>
+	i32 LuaBind(lua_State* state)
+	{
+		return LuaFunction<decltype(Func)>::template Call<Func>(state);
+	}
+
+	// __index for a bound struct, reflected fields are pushed directly and other keys are looked up in its method table
+	template <typename T>
+	i32 LuaIndex(lua_State* state)
+	{
+		const T* object = LuaType<const T*>::Get(state, 1);
+		std::string_view key = LuaType<std::string_view>::Get(state, 2);
+
+		bool isField = false;
+		if (object != nullptr)
+		{
+			refl::util::for_each(refl::reflect<T>().members, [&](auto member)
+			{
+				if constexpr (refl::descriptor::is_field(member) && !refl::descriptor::has_attribute<Reflection::Hidden>(member))
+				{
+					if (isField || key != refl::descriptor::get_name(member).c_str())
+						return;
+
+					using FieldType = std::decay_t<decltype(member.get(*object))>;
+					LuaType<FieldType>::Push(state, member.get(*object));
+					isField = true;
+				}
+			});
+		}
+
+		if (isField)
+			return 1;
+
+		lua_getglobal(state, LuaUserData<T>::MethodTableName);
+		if (!lua_istable(state, -1))
+			return 1;
+
+		lua_pushlstring(state, key.data(), key.size());
+		lua_rawget(state, -2);
+		return 1;
+	}
+
+	// __newindex for a bound struct, only reflected fields that aren't hidden or read only can be written
+	template <typename T>
+	i32 LuaNewIndex(lua_State* state)
+	{
+		T* object = LuaType<T*>::Get(state, 1);
+		std::string_view key = LuaType<std::string_view>::Get(state, 2);
+
+		bool isField = false;
+		if (object != nullptr)
+		{
+			refl::util::for_each(refl::reflect<T>().members, [&](auto member)
+			{
+				if constexpr (refl::descriptor::is_field(member) && !refl::descriptor::has_attribute<Reflection::Hidden>(member) && !refl::descriptor::has_attribute<Reflection::ReadOnly>(member))
+				{
+					if (isField || key != refl::descriptor::get_name(member).c_str())
+						return;
+
+					using FieldType = std::decay_t<decltype(member.get(*object))>;
+					member.get(*object) = LuaType<FieldType>::Get(state, 3);
+					isField = true;
+				}
+			});
+		}
+
+		if (!isField)
+		{
+			luaL_error(state, "'%.*s' is not a writable field", static_cast<i32>(key.size()), key.data());
+		}
+
+		return 0;
+	}
+}
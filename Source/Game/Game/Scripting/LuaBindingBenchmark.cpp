@@ -0,0 +1,130 @@
+#include "LuaBindingBenchmark.h"
+#include "LuaBinding.h"
+#include "LuaManager.h"
+#include "LuaStateCtx.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Luau/Compiler.h>
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+namespace Scripting
+{
+	// The result is kept in a local so the call can't be skipped, but passed in the same vector every time
+	static const char* CallSource = R"(
+		return function(fn, numCalls, value)
+			local result = nil
+			for i = 1, numCalls do
+				result = fn(value, 0.5)
+			end
+			return result
+		end
+	)";
+
+	static vec3 Scale(const vec3& value, f32 scale)
+	{
+		return value * scale;
+	}
+
+	static i32 ScaleEmpty(lua_State* state)
+	{
+		return 0;
+	}
+
+	static i32 ScaleManual(lua_State* state)
+	{
+		LuaStateCtx ctx(state);
+
+		vec3 value = ctx.GetVector(vec3(0.0f, 0.0f, 0.0f), 1);
+		f32 scale = ctx.GetF32(0.0f, 2);
+
+		ctx.PushVector(Scale(value, scale));
+		return 1;
+	}
+
+	void LuaBindingBenchmark::Run(u32 numCalls, u32 numStates, LuaBindingBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaBindingBenchmarkResult();
+
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		const LuaTable& globalTable = luaManager->GetGlobalTable();
+		result.numGlobals = static_cast<u32>(globalTable.data.size());
+
+		// Calls
+		{
+			std::string bytecode = Luau::compile(CallSource);
+
+			LuaStateCtx ctx(luaL_newstate());
+			ctx.RegisterDefaultLibraries();
+
+			lua_State* state = ctx.GetState();
+			RunCalls(state, bytecode, ScaleEmpty, numCalls, result.emptyNSPerCall);
+			RunCalls(state, bytecode, ScaleManual, numCalls, result.manualNSPerCall);
+			RunCalls(state, bytecode, LuaBind<Scale>, numCalls, result.boundNSPerCall);
+
+			ctx.Close();
+		}
+
+		// State setup
+		{
+			Timer timer;
+			f64 globalsMS = 0.0;
+
+			for (u32 i = 0; i < numStates; i++)
+			{
+				LuaStateCtx ctx(luaL_newstate());
+				ctx.RegisterDefaultLibraries();
+
+				f64 startTime = timer.GetLifeTime();
+				ctx.SetGlobal(globalTable);
+				globalsMS += (timer.GetLifeTime() - startTime) * 1000.0;
+
+				ctx.MakeReadOnly();
+				ctx.Close();
+			}
+
+			f64 totalMS = timer.GetLifeTime() * 1000.0;
+
+			result.globalsMSPerState = globalsMS / numStates;
+			result.setupMSPerState = totalMS / numStates;
+		}
+	}
+
+	bool LuaBindingBenchmark::RunCalls(lua_State* state, const std::string& bytecode, lua_CFunction function, u32 numCalls, f64& nsPerCall)
+	{
+		LuaStateCtx ctx(state);
+
+		if (ctx.LoadBytecode("LuaBindingBenchmark", bytecode, 0) != LUA_OK)
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		if (lua_pcall(state, 0, 1, 0) != LUA_OK || !lua_isfunction(state, -1))
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		lua_pushcfunction(state, function, "LuaBindingBenchmark");
+		lua_pushnumber(state, static_cast<f64>(numCalls));
+		lua_pushvector(state, 1.0f, 2.0f, 3.0f);
+
+		Timer timer;
+		bool didSucceed = lua_pcall(state, 3, 1, 0) == LUA_OK;
+		nsPerCall = (timer.GetLifeTime() * 1000000000.0) / numCalls;
+
+		if (!didSucceed)
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		lua_pop(state, 1);
+		return true;
+	}
+}
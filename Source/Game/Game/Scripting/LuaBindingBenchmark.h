@@ -0,0 +1,32 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+
+#include <string>
+
+namespace Scripting
+{
+	struct LuaBindingBenchmarkResult
+	{
+	public:
+		f64 emptyNSPerCall = 0.0;
+		f64 manualNSPerCall = 0.0; // Marshalled by hand through the LuaStateCtx getters, like the handlers used to be
+		f64 boundNSPerCall = 0.0; // Generated by LuaBind
+
+		f64 globalsMSPerState = 0.0;
+		f64 setupMSPerState = 0.0; // Libraries, globals and sandboxing, what every base state of a LuaStatePool pays
+		u32 numGlobals = 0;
+	};
+
+	// Calls the same function numCalls times through a hand written and a generated binding, and sets up numStates states
+	// with the global table of the LuaManager. Setup builds a whole VM per state, so it grows with the number of bindings registered
+	class LuaBindingBenchmark
+	{
+	public:
+		static void Run(u32 numCalls, u32 numStates, LuaBindingBenchmarkResult& result);
+
+	private:
+		static bool RunCalls(lua_State* state, const std::string& bytecode, lua_CFunction function, u32 numCalls, f64& nsPerCall);
+	};
+}
@@ -0,0 +1,107 @@
+#include "LuaBytecodeCache.h"
+
+#include <Base/Util/DebugHandler.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace Scripting
+{
+	void LuaBytecodeCache::SetDirectory(const std::string& directory)
+	{
+		_directory = directory;
+
+		std::error_code errorCode;
+		fs::create_directories(_directory, errorCode);
+
+		if (errorCode)
+		{
+			DebugHandler::PrintWarning("LuaBytecodeCache : Failed to create '{0}', bytecode will not be cached ({1})", _directory, errorCode.message());
+			_directory.clear();
+		}
+	}
+
+	bool LuaBytecodeCache::Load(const std::string& scriptPath, u64 sourceHash, std::string& bytecode)
+	{
+		if (_directory.empty())
+			return false;
+
+		std::ifstream file(GetEntryPath(scriptPath), std::ios::binary);
+		if (!file)
+			return false;
+
+		EntryHeader header;
+		if (!file.read(reinterpret_cast<char*>(&header), sizeof(EntryHeader)))
+			return false;
+
+		if (header.magic != FILE_MAGIC || header.version != FILE_VERSION)
+			return false;
+
+		if (header.sourceHash != sourceHash || header.optionsHash != _optionsHash)
+			return false;
+
+		bytecode.resize(header.bytecodeSize);
+		if (!file.read(bytecode.data(), header.bytecodeSize))
+		{
+			bytecode.clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	void LuaBytecodeCache::Store(const std::string& scriptPath, u64 sourceHash, const std::string& bytecode)
+	{
+		if (_directory.empty())
+			return;
+
+		// Write to a temporary file first so a crash can never leave a truncated entry behind
+		std::string entryPath = GetEntryPath(scriptPath);
+		std::string tempPath = entryPath + ".tmp";
+
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return;
+
+			EntryHeader header;
+			header.sourceHash = sourceHash;
+			header.optionsHash = _optionsHash;
+			header.bytecodeSize = bytecode.size();
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(EntryHeader));
+			file.write(bytecode.data(), bytecode.size());
+
+			if (!file)
+				return;
+		}
+
+		std::error_code errorCode;
+		fs::rename(tempPath, entryPath, errorCode);
+	}
+
+	u64 LuaBytecodeCache::Hash(const std::string& data, u64 seed)
+	{
+		// FNV-1a, 64 bits so source files practically never collide
+		u64 hash = seed;
+		for (char c : data)
+		{
+			hash ^= static_cast<u8>(c);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	std::string LuaBytecodeCache::GetEntryPath(const std::string& scriptPath)
+	{
+		u64 pathHash = Hash(scriptPath);
+
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "%016llx.luauc", static_cast<unsigned long long>(pathHash));
+
+		return (fs::path(_directory) / fileName).string();
+	}
+}
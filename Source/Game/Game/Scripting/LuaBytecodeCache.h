@@ -0,0 +1,42 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <atomic>
+#include <string>
+
+namespace Scripting
+{
+	// Stores compiled Luau bytecode on disk, one file per script path. An entry is only used if it was compiled
+	// from the same source with the same compiler options and bytecode version, otherwise the script is compiled again.
+	class LuaBytecodeCache
+	{
+	public:
+		void SetDirectory(const std::string& directory);
+		void SetOptionsHash(u64 optionsHash) { _optionsHash = optionsHash; }
+
+		// Safe to call from several threads as long as they work on different scripts
+		bool Load(const std::string& scriptPath, u64 sourceHash, std::string& bytecode);
+		void Store(const std::string& scriptPath, u64 sourceHash, const std::string& bytecode);
+
+		static u64 Hash(const std::string& data, u64 seed = 14695981039346656037ull);
+
+	private:
+		std::string GetEntryPath(const std::string& scriptPath);
+
+	private:
+		static constexpr u32 FILE_MAGIC = 0x43434C4C; // "LLCC"
+		static constexpr u32 FILE_VERSION = 1;
+
+		struct EntryHeader
+		{
+			u32 magic = FILE_MAGIC;
+			u32 version = FILE_VERSION;
+			u64 sourceHash = 0;
+			u64 optionsHash = 0;
+			u64 bytecodeSize = 0;
+		};
+
+		std::string _directory;
+		u64 _optionsHash = 0;
+	};
+}
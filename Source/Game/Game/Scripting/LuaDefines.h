@@ -1,6 +1,11 @@
 #pragma once
+#include <Base/Types.h>
+
 #include <robinhood/robinhood.h>
-#include <any>
+
+#include <memory>
+#include <string>
+#include <variant>
 
 struct lua_State;
 typedef i32 (*lua_CFunction)(lua_State* L);
@@ -10,21 +15,57 @@ namespace Scripting
 	class LuaManager;
 	class LuaHandlerBase;
 	class LuaSystemBase;
+	struct LuaTable;
+
+	// A value that can be set as a global or stored in a LuaTable. The type is fixed when it is constructed,
+	// so pushing it is a single visit instead of comparing typeids until one matches
+	struct LuaValue
+	{
+	public:
+		using Data = std::variant<std::monostate, bool, i32, u32, f32, f64, std::string, vec3, lua_CFunction, std::shared_ptr<const LuaTable>>;
+
+		LuaValue() { }
+		LuaValue(bool value) : data(value) { }
+		LuaValue(i32 value) : data(value) { }
+		LuaValue(u32 value) : data(value) { }
+		LuaValue(f32 value) : data(value) { }
+		LuaValue(f64 value) : data(value) { }
+		LuaValue(const char* value) : data(std::string(value)) { }
+		LuaValue(const std::string& value) : data(value) { }
+		LuaValue(const vec3& value) : data(value) { }
+		LuaValue(lua_CFunction value) : data(value) { }
+		LuaValue(const LuaTable& value);
+
+		Data data;
+	};
 
 	struct LuaTable
 	{
 	public:
-		using Table = robin_hood::unordered_map<std::string, std::any>;
+		using Table = robin_hood::unordered_map<std::string, LuaValue>;
 
 		Table data;
 		bool isMetaTable = false;
 	};
+	inline LuaValue::LuaValue(const LuaTable& value) : data(std::make_shared<const LuaTable>(value)) { }
+
 	using LuaUserDataDtor = void(void*);
 
+	// Tags of the userdata types bound through LuaBinding.h, Luau checks them with a single compare
+	enum class LuaUserDataType : u8
+	{
+		Invalid,
+		Panel,
+		Count
+	};
+
 	enum class LuaHandlerType
 	{
 		Global,
 		GameEvent,
+		Physics,
+		Entity,
+		Task,
 		Count
 	};
 
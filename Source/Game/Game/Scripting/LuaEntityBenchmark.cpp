@@ -0,0 +1,207 @@
+#include "LuaEntityBenchmark.h"
+#include "LuaStateCtx.h"
+#include "Handlers/EntityHandler.h"
+#include "Game/ECS/Components/Transform.h"
+#include "Game/ECS/Singletons/ScriptTransformWrites.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Luau/Compiler.h>
+#include <entt/entt.hpp>
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+namespace Scripting
+{
+	static const char* BatchedEntitySource = R"(
+		return function()
+			local query = Entities.Query("Transform")
+			local position = query.position
+			for i = 0, query.count - 1 do
+				local offset = i * 12 + 4
+				buffer.writef32(position, offset, buffer.readf32(position, offset) + 0.01)
+			end
+			Entities.Commit(query)
+		end
+	)";
+
+	static const char* NaiveEntitySource = R"(
+		return function(entities)
+			for i = 1, #entities do
+				local entity = entities[i]
+				local x, y, z = GetPosition(entity)
+				SetPosition(entity, x, y + 0.01, z)
+			end
+		end
+	)";
+
+	static entt::registry* GetBenchmarkRegistry(lua_State* state)
+	{
+		return static_cast<entt::registry*>(lua_tolightuserdata(state, lua_upvalueindex(1)));
+	}
+
+	// GetPosition(entity) -> x, y, z
+	static i32 GetEntityPosition(lua_State* state)
+	{
+		entt::registry* registry = GetBenchmarkRegistry(state);
+		entt::entity entity = static_cast<entt::entity>(lua_tounsignedx(state, 1, nullptr));
+
+		const ECS::Components::Transform* transform = registry->try_get<ECS::Components::Transform>(entity);
+		if (transform == nullptr)
+			return 0;
+
+		lua_pushnumber(state, transform->position.x);
+		lua_pushnumber(state, transform->position.y);
+		lua_pushnumber(state, transform->position.z);
+		return 3;
+	}
+
+	// SetPosition(entity, x, y, z)
+	static i32 SetEntityPosition(lua_State* state)
+	{
+		entt::registry* registry = GetBenchmarkRegistry(state);
+		entt::entity entity = static_cast<entt::entity>(lua_tounsignedx(state, 1, nullptr));
+
+		ECS::Components::Transform* transform = registry->try_get<ECS::Components::Transform>(entity);
+		if (transform == nullptr)
+			return 0;
+
+		f32 x = static_cast<f32>(lua_tonumberx(state, 2, nullptr));
+		f32 y = static_cast<f32>(lua_tonumberx(state, 3, nullptr));
+		f32 z = static_cast<f32>(lua_tonumberx(state, 4, nullptr));
+
+		transform->position = vec3(x, y, z);
+		transform->isDirty = true;
+		registry->get_or_emplace<ECS::Components::DirtyTransform>(entity);
+		return 0;
+	}
+
+	static void PushBenchmarkFunction(lua_State* state, entt::registry* registry, lua_CFunction function, const char* name)
+	{
+		lua_pushlightuserdata(state, registry);
+		lua_pushcclosure(state, function, name, 1);
+	}
+
+	void LuaEntityBenchmark::Run(u32 numEntities, u32 numIterations, LuaEntityBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaEntityBenchmarkResult();
+
+		entt::registry registry;
+		registry.ctx().emplace<ECS::Singletons::ScriptTransformWrites>();
+
+		for (u32 i = 0; i < numEntities; i++)
+		{
+			entt::entity entity = registry.create();
+
+			ECS::Components::Transform& transform = registry.emplace<ECS::Components::Transform>(entity);
+			transform.position = vec3(static_cast<f32>(i), 0.0f, 0.0f);
+		}
+
+		LuaStateCtx ctx(luaL_newstate());
+		ctx.RegisterDefaultLibraries();
+
+		lua_State* state = ctx.GetState();
+
+		lua_createtable(state, 0, 2);
+		PushBenchmarkFunction(state, &registry, EntityHandler::Query, "Query");
+		lua_setfield(state, -2, "Query");
+		PushBenchmarkFunction(state, &registry, EntityHandler::Commit, "Commit");
+		lua_setfield(state, -2, "Commit");
+		lua_setglobal(state, "Entities");
+
+		PushBenchmarkFunction(state, &registry, GetEntityPosition, "GetPosition");
+		lua_setglobal(state, "GetPosition");
+		PushBenchmarkFunction(state, &registry, SetEntityPosition, "SetPosition");
+		lua_setglobal(state, "SetPosition");
+
+		f64 numMovedEntities = static_cast<f64>(numEntities) * numIterations;
+
+		// Batched
+		i32 batchedRef = 0;
+		if (LoadFunction(state, BatchedEntitySource, batchedRef))
+		{
+			Timer timer;
+			f64 applyMS = 0.0;
+
+			for (u32 i = 0; i < numIterations; i++)
+			{
+				lua_getref(state, batchedRef);
+				if (lua_pcall(state, 0, 0, 0) != LUA_OK)
+				{
+					ctx.ReportError();
+					break;
+				}
+
+				f64 applyStartTime = timer.GetLifeTime();
+				EntityHandler::ApplyWrites(registry);
+				applyMS += (timer.GetLifeTime() - applyStartTime) * 1000.0;
+			}
+
+			f64 totalMS = timer.GetLifeTime() * 1000.0;
+
+			result.batchedEntitiesPerMS = numMovedEntities / totalMS;
+			result.applyMSPerIteration = applyMS / numIterations;
+		}
+
+		// Naive, the entity list is built up front so only the bindings are measured
+		i32 naiveRef = 0;
+		if (LoadFunction(state, NaiveEntitySource, naiveRef))
+		{
+			auto view = registry.view<ECS::Components::Transform>();
+
+			lua_createtable(state, static_cast<i32>(view.size()), 0);
+
+			i32 index = 1;
+			for (entt::entity entity : view)
+			{
+				lua_pushnumber(state, static_cast<f64>(entt::to_integral(entity)));
+				lua_rawseti(state, -2, index++);
+			}
+
+			i32 entitiesRef = lua_ref(state, -1);
+			lua_pop(state, 1);
+
+			Timer timer;
+
+			for (u32 i = 0; i < numIterations; i++)
+			{
+				lua_getref(state, naiveRef);
+				lua_getref(state, entitiesRef);
+				if (lua_pcall(state, 1, 0, 0) != LUA_OK)
+				{
+					ctx.ReportError();
+					break;
+				}
+			}
+
+			f64 totalMS = timer.GetLifeTime() * 1000.0;
+			result.naiveEntitiesPerMS = numMovedEntities / totalMS;
+		}
+
+		ctx.Close();
+	}
+
+	bool LuaEntityBenchmark::LoadFunction(lua_State* state, const char* source, i32& ref)
+	{
+		LuaStateCtx ctx(state);
+
+		std::string bytecode = Luau::compile(source);
+		if (ctx.LoadBytecode("LuaEntityBenchmark", bytecode, 0) != LUA_OK)
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		if (lua_pcall(state, 0, 1, 0) != LUA_OK || !lua_isfunction(state, -1))
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		ref = lua_ref(state, -1);
+		lua_pop(state, 1);
+		return true;
+	}
+}
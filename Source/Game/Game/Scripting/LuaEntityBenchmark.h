@@ -0,0 +1,26 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+
+namespace Scripting
+{
+	struct LuaEntityBenchmarkResult
+	{
+	public:
+		f64 batchedEntitiesPerMS = 0.0; // Entities.Query, buffer writes and Entities.Commit, including applying the writes
+		f64 applyMSPerIteration = 0.0;
+		f64 naiveEntitiesPerMS = 0.0; // One call to read and one call to write the position of every entity
+	};
+
+	// Moves numEntities entities numIterations times, once through the batched entity API and once through a binding per entity.
+	// Runs on a registry of its own, so the entities of the game are never touched
+	class LuaEntityBenchmark
+	{
+	public:
+		static void Run(u32 numEntities, u32 numIterations, LuaEntityBenchmarkResult& result);
+
+	private:
+		static bool LoadFunction(lua_State* state, const char* source, i32& ref);
+	};
+}
@@ -0,0 +1,104 @@
+#include "LuaEventBenchmark.h"
+#include "LuaManager.h"
+#include "LuaStateCtx.h"
+#include "Handlers/GameEventHandler.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Luau/Compiler.h>
+#include <lualib.h>
+#include <enkiTS/TaskScheduler.h>
+#include <tracy/Tracy.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Scripting
+{
+	void LuaEventBenchmark::Run(u32 numStates, u32 numEvents, LuaEventBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaEventBenchmarkResult();
+
+		if (numStates == 0 || numEvents == 0)
+			return;
+
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		auto gameEventHandler = luaManager->GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
+
+		std::string source = "local counter = 0\n";
+		source += "for i = 1, " + std::to_string(NUM_CALLBACKS) + " do\n";
+		source += "	RegisterGameEvent(GameEvent.Updated, function(eventID, deltaTime) counter += deltaTime end)\n";
+		source += "end\n";
+
+		std::string bytecode = Luau::compile(source);
+
+		// Every state gets its own VM so they can run in parallel
+		std::vector<lua_State*> states(numStates);
+		for (u32 i = 0; i < numStates; i++)
+		{
+			LuaStateCtx ctx(luaL_newstate());
+			ctx.RegisterDefaultLibraries();
+			ctx.SetGlobal(luaManager->GetGlobalTable());
+			ctx.MakeReadOnly();
+
+			gameEventHandler->SetupEvents(ctx.GetState());
+
+			if (ctx.LoadBytecode("LuaEventBenchmark", bytecode, 0) != LUA_OK || ctx.Resume() != LUA_OK)
+			{
+				ctx.ReportError();
+			}
+
+			states[i] = ctx.GetState();
+		}
+
+		LuaGameEventUpdatedData eventData;
+		eventData.deltaTime = 1.0f / 60.0f;
+
+		u32 eventID = static_cast<u32>(LuaGameEvent::Updated);
+		f64 numDispatches = static_cast<f64>(numStates) * static_cast<f64>(numEvents);
+
+		Timer timer;
+
+		for (u32 i = 0; i < numStates; i++)
+		{
+			for (u32 j = 0; j < numEvents; j++)
+			{
+				gameEventHandler->CallEvent(states[i], eventID, &eventData);
+			}
+		}
+
+		f64 serialTime = timer.GetLifeTime();
+
+		// The event tables live in the states themselves, so the tasks share nothing but the read only event handlers
+		enki::TaskSet dispatchTask(numStates, [&](enki::TaskSetPartition range, u32 threadNum)
+		{
+			for (u32 i = range.start; i < range.end; i++)
+			{
+				for (u32 j = 0; j < numEvents; j++)
+				{
+					gameEventHandler->CallEvent(states[i], eventID, &eventData);
+				}
+			}
+		});
+		dispatchTask.m_MinRange = 1;
+
+		enki::TaskScheduler* taskScheduler = ServiceLocator::GetTaskScheduler();
+		taskScheduler->AddTaskSetToPipe(&dispatchTask);
+		taskScheduler->WaitforTask(&dispatchTask);
+
+		f64 parallelTime = timer.GetLifeTime() - serialTime;
+
+		for (u32 i = 0; i < numStates; i++)
+		{
+			gameEventHandler->ClearEvents(states[i]);
+			lua_close(states[i]);
+		}
+
+		result.serialEventsPerSecond = serialTime > 0.0 ? numDispatches / serialTime : 0.0;
+		result.parallelEventsPerSecond = parallelTime > 0.0 ? numDispatches / parallelTime : 0.0;
+		result.parallelCallbacksPerSecond = result.parallelEventsPerSecond * static_cast<f64>(NUM_CALLBACKS);
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <Base/Types.h>
+
+namespace Scripting
+{
+	struct LuaEventBenchmarkResult
+	{
+	public:
+		f64 serialEventsPerSecond = 0.0;
+		f64 parallelEventsPerSecond = 0.0;
+		f64 parallelCallbacksPerSecond = 0.0;
+	};
+
+	// Creates numStates states that each register NUM_CALLBACKS callbacks for the Updated event and fires that event
+	// numEvents times to every state, once with all states on the calling thread and once with a task per state.
+	// The parallel pass can't go faster than the number of worker threads the task scheduler was started with
+	class LuaEventBenchmark
+	{
+	public:
+		static constexpr u32 NUM_CALLBACKS = 4;
+
+		static void Run(u32 numStates, u32 numEvents, LuaEventBenchmarkResult& result);
+	};
+}
@@ -1,8 +1,14 @@
 #include "LuaManager.h"
 #include "LuaDefines.h"
+#include "LuaNativeCodegen.h"
+#include "LuaProfiler.h"
 #include "LuaStateCtx.h"
+#include "LuaTaskScheduler.h"
+#include "Handlers/EntityHandler.h"
 #include "Handlers/GameEventHandler.h"
 #include "Handlers/GlobalHandler.h"
+#include "Handlers/PhysicsHandler.h"
+#include "Handlers/TaskHandler.h"
 #include "Systems/LuaSystemBase.h"
 #include "Systems/GenericSystem.h"
 #include "Game/Util/ServiceLocator.h"
@@ -10,21 +16,63 @@
 #include <Base/CVarSystem/CVarSystem.h>
 #include <Base/Memory/Bytebuffer.h>
 #include <Base/Memory/FileReader.h>
+#include <Base/Util/DebugHandler.h>
+#include <Base/Util/StringUtils.h>
+#include <Base/Util/Timer.h>
 
+#include <Luau/Bytecode.h>
 #include <Luau/Compiler.h>
 #include <lualib.h>
 #include <enkiTS/TaskScheduler.h>
+#include <tracy/Tracy.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include <vector>
 #include <filesystem>
 namespace fs = std::filesystem;
 
 AutoCVar_String CVAR_ScriptDir("scripting.directory", "defines the directory from where scripts are loaded", "Data/Scripts");
 AutoCVar_String CVAR_ScriptExtension("scripting.extension", "defines the file extension to recognized as a script file", ".luau");
+AutoCVar_Int CVAR_ScriptBytecodeCacheEnabled("scripting.bytecodeCache.enabled", "cache compiled script bytecode on disk and only recompile scripts that changed", 1, CVarFlags::EditCheckbox);
+AutoCVar_String CVAR_ScriptBytecodeCacheDir("scripting.bytecodeCache.directory", "defines the directory compiled script bytecode is cached in", "Data/ScriptCache");
+AutoCVar_Int CVAR_ScriptHotReloadEnabled("scripting.hotReload.enabled", "watch the script directory and reload scripts that changed without restarting the other scripts", 1, CVarFlags::EditCheckbox);
 AutoCVar_String CVAR_ScriptMotd("scripting.motd", "defines the message of the day passed in the GameLoaded Event", "Welcome to Novuscore");
 
 namespace Scripting
 {
+	// How long hot reload waits before it tries to watch a script directory again that it couldn't watch, doubled on every failure
+	static constexpr u32 SCRIPT_WATCHER_MIN_RETRY_MS = 1000;
+	static constexpr u32 SCRIPT_WATCHER_MAX_RETRY_MS = 60000;
+
+	static Luau::CompileOptions GetCompileOptions()
+	{
+		Luau::CompileOptions compileOptions;
+		{
+			compileOptions.optimizationLevel = 1;
+			compileOptions.debugLevel = 2;
+			compileOptions.coverageLevel = 2;
+			compileOptions.vectorLib = "Vector3";
+			compileOptions.vectorCtor = "new";
+		}
+
+		return compileOptions;
+	}
+
+	static u64 GetCompileOptionsHash()
+	{
+		// Anything that changes the produced bytecode has to be part of this, otherwise stale cache entries get used
+		const Luau::CompileOptions compileOptions = GetCompileOptions();
+
+		std::string options = std::to_string(compileOptions.optimizationLevel) + ":" + std::to_string(compileOptions.debugLevel) + ":" + std::to_string(compileOptions.coverageLevel) + ":";
+		options += std::string(compileOptions.vectorLib) + "." + compileOptions.vectorCtor + ":" + std::to_string(LBC_VERSION_TARGET);
+
+		return LuaBytecodeCache::Hash(options);
+	}
+
 	LuaManager::LuaManager() : _state(nullptr)
 	{
 		_luaHandlers.reserve(16);
@@ -36,6 +84,11 @@ namespace Scripting
 		_luaHandlers.resize(static_cast<u32>(LuaHandlerType::Count));
 		SetLuaHandler(LuaHandlerType::Global, new GlobalHandler());
 		SetLuaHandler(LuaHandlerType::GameEvent, new GameEventHandler());
+		SetLuaHandler(LuaHandlerType::Physics, new PhysicsHandler());
+		SetLuaHandler(LuaHandlerType::Entity, new EntityHandler());
+		SetLuaHandler(LuaHandlerType::Task, new TaskHandler());
+
+		LuaNativeCodegen::Init();
 
 		Prepare();
 
@@ -53,6 +106,17 @@ namespace Scripting
 
 	void LuaManager::Update(f32 deltaTime)
 	{
+		// Normally done at the end of the last frame, none of the work below can happen while a system is running
+		WaitForSystems();
+
+		LuaProfiler::Update();
+		LuaTaskScheduler::UpdateOperations();
+
+		if (!_isDirty)
+		{
+			UpdateHotReload();
+		}
+
 		bool isDirty = _isDirty;
 
 		if (isDirty)
@@ -72,59 +136,99 @@ namespace Scripting
 			isDirty = result;
 		}
 
-		enki::TaskScheduler* scheduler = ServiceLocator::GetTaskScheduler();
+		_statePool.StepGC();
 
-		for (u32 i = 0; i < _luaSystems.size(); i++)
+		if (LuaTaskScheduler* taskScheduler = LuaTaskScheduler::Get(_state))
 		{
-			LuaSystemBase* luaSystem = _luaSystems[i];
+			taskScheduler->Update(deltaTime);
+		}
 
+		for (LuaSystemBase* luaSystem : _luaSystems)
+		{
 			u32 numStates = static_cast<u32>(luaSystem->_states.size());
-			if (numStates == 0)
-				continue;
+			if (numStates > 0)
+			{
+				if (isDirty)
+				{
+					luaSystem->PushEvent(LuaSystemEvent::Reload);
+				}
+
+				luaSystem->Update(deltaTime);
+			}
 
-			if (isDirty)
+			luaSystem->ResetNode(deltaTime);
+		}
+
+		// Systems with dependencies are launched by the last one of them to finish
+		for (LuaSystemBase* luaSystem : _luaSystems)
+		{
+			if (luaSystem->_dependencies.size() == 0)
 			{
-				luaSystem->PushEvent(LuaSystemEvent::Reload);
+				luaSystem->Launch();
 			}
+		}
+	}
 
-			luaSystem->Update(deltaTime);
-			luaSystem->Prepare(deltaTime);
+	void LuaManager::WaitForSystems()
+	{
+		ZoneScoped;
 
-			scheduler->WaitforAll();
+		Timer timer;
 
-			for (u32 j = 0; j < numStates; j++)
-			{
-				if (_tasks.size() <= j)
-				{
-					_tasks.push_back(new enki::TaskSet(nullptr));
-				}
+		for (LuaSystemBase* luaSystem : _luaSystems)
+		{
+			WaitForSystem(luaSystem);
+		}
 
-				enki::TaskSet* task = task = _tasks[j];
-				task->m_Function = [&luaSystem, deltaTime, j](enki::TaskSetPartition range, uint32_t threadNum)
-				{
-					luaSystem->Run(deltaTime, j);
-				};
+		_systemWaitTimeNS += static_cast<u64>(timer.GetLifeTime() * 1000000000.0);
+	}
 
-				scheduler->AddTaskSetToPipe(task);
+	void LuaManager::WaitForSystems(const ECS::SystemAccess& access)
+	{
+		ZoneScoped;
+
+		Timer timer;
+
+		for (LuaSystemBase* luaSystem : _luaSystems)
+		{
+			if (luaSystem->GetAccess().ConflictsWith(access))
+			{
+				WaitForSystem(luaSystem);
 			}
 		}
 
-		scheduler->WaitforAll();
+		_systemWaitTimeNS += static_cast<u64>(timer.GetLifeTime() * 1000000000.0);
 	}
 
-	bool LuaManager::DoString(const std::string& code)
+	void LuaManager::ConsumeSystemStats(LuaSystemStats& stats)
 	{
-		LuaStateCtx ctx(_state);
+		stats = LuaSystemStats();
 
-		Luau::CompileOptions compileOptions;
+		for (LuaSystemBase* luaSystem : _luaSystems)
 		{
-			compileOptions.optimizationLevel = 1;
-			compileOptions.debugLevel = 2;
-			compileOptions.coverageLevel = 2;
-			compileOptions.vectorLib = "Vector3";
-			compileOptions.vectorCtor = "new";
+			stats.runTimeMS += static_cast<f64>(luaSystem->_runTimeNS.exchange(0)) / 1000000.0;
+		}
+
+		stats.waitTimeMS = static_cast<f64>(_systemWaitTimeNS.exchange(0)) / 1000000.0;
+	}
+
+	void LuaManager::WaitForSystem(LuaSystemBase* luaSystem)
+	{
+		// A system that hasn't been launched yet counts as complete, its dependencies have to be done first for it to be queued
+		for (LuaSystemBase* dependency : luaSystem->_dependencies)
+		{
+			WaitForSystem(dependency);
 		}
 
+		enki::TaskScheduler* scheduler = ServiceLocator::GetTaskScheduler();
+		scheduler->WaitforTask(&luaSystem->_task);
+	}
+
+	bool LuaManager::DoString(const std::string& code)
+	{
+		LuaStateCtx ctx(_state);
+
+		Luau::CompileOptions compileOptions = GetCompileOptions();
 		Luau::ParseOptions parseOptions;
 		
 		std::string bytecode = Luau::compile(code, compileOptions, parseOptions);
@@ -152,13 +256,20 @@ namespace Scripting
 
 	void LuaManager::RegisterLuaSystem(LuaSystemBase* systemBase)
 	{
+		// Conflicting systems keep running in the order they were registered in
+		for (LuaSystemBase* luaSystem : _luaSystems)
+		{
+			if (luaSystem->GetAccess().ConflictsWith(systemBase->GetAccess()))
+			{
+				systemBase->AddDependency(luaSystem);
+			}
+		}
+
 		_luaSystems.push_back(systemBase);
 	}
 
 	void LuaManager::Prepare()
 	{
-		_tasks.reserve(32);
-
 		for (u32 i = 0; i < _luaHandlers.size(); i++)
 		{
 			LuaHandlerBase* base = _luaHandlers[i];
@@ -181,10 +292,15 @@ namespace Scripting
 
 		const LuaTable& table = GetGlobalTable();
 
-		LuaStateCtx ctx(luaL_newstate());
-		ctx.RegisterDefaultLibraries();
-		ctx.SetGlobal(table);
-		ctx.MakeReadOnly();
+		// The old state stays acquired until the new one loaded successfully
+		lua_State* pooledState = _statePool.Acquire(table, _globalTableVersion);
+		if (pooledState == nullptr)
+		{
+			_isDirty = false;
+			return false;
+		}
+
+		LuaStateCtx ctx(pooledState);
 
 		// TODO : Figure out if this catches hidden folders, and if so exclude them
 		// TODO : Should we use a custom file extension for "include" files? Force load any files that for example use ".ext"
@@ -192,18 +308,9 @@ namespace Scripting
 		std::filesystem::recursive_directory_iterator dirpos{ scriptDirectory };
 		std::copy(begin(dirpos), end(dirpos), std::back_inserter(paths));
 
-		Luau::CompileOptions compileOptions;
-		{
-			compileOptions.optimizationLevel = 1;
-			compileOptions.debugLevel = 2;
-			compileOptions.coverageLevel = 2;
-			compileOptions.vectorLib = "Vector3";
-			compileOptions.vectorCtor = "new";
-		}
-		Luau::ParseOptions parseOptions;
-
-		_bytecodeList.clear();
-		_bytecodeList.reserve(paths.size());
+		// Filter out everything that isn't a script up front so the compile task only sees real work
+		std::vector<std::string> scriptPaths;
+		scriptPaths.reserve(paths.size());
 
 		for (auto& path : paths)
 		{
@@ -213,36 +320,91 @@ namespace Scripting
 			if (path.extension() != scriptExtension)
 				continue;
 
-			const std::string pathAsStr = path.string();
-			FileReader reader(pathAsStr);
+			scriptPaths.push_back(path.string());
+		}
 
-			if (!reader.Open())
-				continue;
+		Timer timer;
+
+		bool useBytecodeCache = CVAR_ScriptBytecodeCacheEnabled.Get();
+		if (useBytecodeCache)
+		{
+			_bytecodeCache.SetDirectory(CVAR_ScriptBytecodeCacheDir.Get());
+			_bytecodeCache.SetOptionsHash(GetCompileOptionsHash());
+		}
+
+		u32 numScripts = static_cast<u32>(scriptPaths.size());
+		std::vector<std::string> bytecodes(numScripts);
+		std::vector<u8> didRead(numScripts, 0);
+		std::vector<u8> nativeAnnotations(numScripts, 0);
+
+		std::atomic<u32> numCompiled = 0;
+		std::atomic<u32> numCached = 0;
+
+		// Read, hash and compile the scripts on the workers, only scripts that changed since they were cached get compiled
+		enki::TaskSet compileTask(numScripts, [&](enki::TaskSetPartition range, u32 threadNum)
+		{
+			for (u32 i = range.start; i < range.end; i++)
+			{
+				bool fromCache = false;
+				bool hasNativeAnnotation = false;
+				if (!CompileScript(scriptPaths[i], useBytecodeCache, bytecodes[i], fromCache, hasNativeAnnotation))
+					continue;
+
+				didRead[i] = 1;
+				nativeAnnotations[i] = hasNativeAnnotation;
+
+				if (fromCache)
+				{
+					numCached++;
+				}
+				else
+				{
+					numCompiled++;
+				}
+			}
+		});
+		compileTask.m_MinRange = 1;
+
+		enki::TaskScheduler* taskScheduler = ServiceLocator::GetTaskScheduler();
+		taskScheduler->AddTaskSetToPipe(&compileTask);
+		taskScheduler->WaitforTask(&compileTask);
+
+		f32 compileTimeMS = timer.GetLifeTime() * 1000.0f;
+
+		_bytecodeList.clear();
+		_bytecodeList.reserve(numScripts);
 
-			u32 bufferSize = static_cast<u32>(reader.Length());
-			std::shared_ptr<Bytebuffer> buffer = Bytebuffer::BorrowRuntime(bufferSize);
-			reader.Read(buffer.get(), bufferSize);
+		u32 numNative = 0;
 
-			std::string luaCode;
-			if (!buffer->GetString(luaCode, bufferSize))
+		// Loading into the state has to happen serially and in a stable order
+		for (u32 i = 0; i < numScripts; i++)
+		{
+			if (!didRead[i])
 				continue;
 
+			fs::path path = scriptPaths[i];
+
 			LuaBytecodeEntry bytecodeEntry
 			{
 				path.filename().string(),
 				path.parent_path().string(),
-				Luau::compile(luaCode, compileOptions, parseOptions)
+				std::move(bytecodes[i]),
+				nativeAnnotations[i] != 0
 			};
 
-			_bytecodeList.push_back(bytecodeEntry);
+			i32 result = LoadModule(ctx.GetState(), bytecodeEntry);
+			numNative += result == LUA_OK && LuaNativeCodegen::ShouldCompile(bytecodeEntry.hasNativeAnnotation);
+
+			_bytecodeList.push_back(std::move(bytecodeEntry));
 
-			i32 result = ctx.LoadBytecode(pathAsStr, bytecodeEntry.bytecode, 0);
 			if (result != LUA_OK)
 			{
 				ctx.ReportError();
 			}
 		}
 
+		DebugHandler::Print("LuaManager : Prepared {0} scripts in {1:.2f}ms ({2} compiled, {3} from cache), loaded in {4:.2f}ms ({5} native)", numScripts, compileTimeMS, numCompiled.load(), numCached.load(), (timer.GetLifeTime() * 1000.0f) - compileTimeMS, numNative);
+
 		auto gameEventHandler = GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
 		gameEventHandler->SetupEvents(ctx.GetState());
 
@@ -267,9 +429,7 @@ namespace Scripting
 			if (_state != nullptr)
 			{
 				gameEventHandler->ClearEvents(_state);
-
-				LuaStateCtx oldCtx(_state);
-				oldCtx.Close();
+				_statePool.Release(_state);
 			}
 
 			_state = ctx.GetState();
@@ -277,9 +437,243 @@ namespace Scripting
 		else
 		{
 			gameEventHandler->ClearEvents(ctx.GetState());
+			_statePool.Release(ctx.GetState());
 		}
 
 		_isDirty = false;
 		return !didFail;
 	}
+
+	bool LuaManager::CompileScript(const std::string& scriptPath, bool useBytecodeCache, std::string& bytecode, bool& fromCache, bool& hasNativeAnnotation)
+	{
+		std::ifstream file(scriptPath, std::ios::binary);
+		if (!file)
+			return false;
+
+		std::stringstream sourceStream;
+		sourceStream << file.rdbuf();
+		std::string luaCode = sourceStream.str();
+
+		hasNativeAnnotation = LuaNativeCodegen::HasNativeAnnotation(luaCode);
+
+		u64 sourceHash = LuaBytecodeCache::Hash(luaCode);
+		if (useBytecodeCache && _bytecodeCache.Load(scriptPath, sourceHash, bytecode))
+		{
+			fromCache = true;
+			return true;
+		}
+
+		Luau::CompileOptions compileOptions = GetCompileOptions();
+		Luau::ParseOptions parseOptions;
+
+		bytecode = Luau::compile(luaCode, compileOptions, parseOptions);
+		fromCache = false;
+
+		// Bytecode starting with 0 holds a compile error, we want to see that error again next time
+		if (useBytecodeCache && bytecode.size() > 0 && bytecode[0] != 0)
+		{
+			_bytecodeCache.Store(scriptPath, sourceHash, bytecode);
+		}
+
+		return true;
+	}
+
+	void LuaManager::UpdateHotReload()
+	{
+		bool hotReloadEnabled = CVAR_ScriptHotReloadEnabled.Get();
+		if (!hotReloadEnabled)
+		{
+			if (_scriptWatcher.IsWatching())
+			{
+				_scriptWatcher.Stop();
+			}
+
+			// Turning it back on tries again right away
+			_scriptWatcherRetryDelayMS = 0;
+			_scriptWatcherRetryTime = std::chrono::steady_clock::time_point();
+
+			return;
+		}
+
+		if (!_scriptWatcher.IsWatching())
+		{
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (now < _scriptWatcherRetryTime)
+				return;
+
+			fs::path scriptDirectory = fs::absolute(CVAR_ScriptDir.Get());
+			if (_scriptWatcher.Start(scriptDirectory.string(), CVAR_ScriptExtension.Get()))
+			{
+				_scriptWatcherRetryDelayMS = 0;
+				return;
+			}
+
+			_scriptWatcherRetryDelayMS = std::clamp(_scriptWatcherRetryDelayMS * 2, SCRIPT_WATCHER_MIN_RETRY_MS, SCRIPT_WATCHER_MAX_RETRY_MS);
+			_scriptWatcherRetryTime = now + std::chrono::milliseconds(_scriptWatcherRetryDelayMS);
+
+			DebugHandler::PrintWarning("LuaManager : Failed to watch {0} for script changes, trying again in {1}s", scriptDirectory.string(), _scriptWatcherRetryDelayMS / 1000);
+			return;
+		}
+
+		Util::FileWatcher::Changes changes;
+		if (!_scriptWatcher.Poll(changes))
+			return;
+
+		// Adding or removing a script changes the load order of everything after it, that needs a full reload
+		if (changes.structureChanged || _state == nullptr)
+		{
+			DebugHandler::Print("LuaManager : Scripts were added or removed, reloading all scripts");
+			_isDirty = true;
+			return;
+		}
+
+		if (!ReloadScripts(changes.modifiedPaths))
+		{
+			DebugHandler::PrintWarning("LuaManager : Hot reload failed, falling back to reloading all scripts");
+			_isDirty = true;
+		}
+	}
+
+	bool LuaManager::ReloadScripts(const std::vector<std::string>& scriptPaths)
+	{
+		ZoneScoped;
+
+		Timer timer;
+
+		bool useBytecodeCache = CVAR_ScriptBytecodeCacheEnabled.Get();
+
+		struct ScriptReload
+		{
+			u32 bytecodeIndex;
+			std::string bytecode;
+			bool hasNativeAnnotation;
+		};
+
+		// Compile everything up front, a script that doesn't compile keeps running its previous version
+		std::vector<ScriptReload> reloads;
+		reloads.reserve(scriptPaths.size());
+
+		for (const std::string& scriptPath : scriptPaths)
+		{
+			fs::path path = fs::path(scriptPath).lexically_normal();
+
+			u32 bytecodeIndex = std::numeric_limits<u32>().max();
+			for (u32 i = 0; i < _bytecodeList.size(); i++)
+			{
+				if (fs::path(_bytecodeList[i].GetPath()).lexically_normal() == path)
+				{
+					bytecodeIndex = i;
+					break;
+				}
+			}
+
+			if (bytecodeIndex == std::numeric_limits<u32>().max())
+				return false;
+
+			std::string bytecode;
+			bool fromCache = false;
+			bool hasNativeAnnotation = false;
+			if (!CompileScript(scriptPath, useBytecodeCache, bytecode, fromCache, hasNativeAnnotation))
+				return false;
+
+			if (bytecode.size() == 0 || bytecode[0] == 0)
+			{
+				DebugHandler::PrintError("LuaManager : Failed to compile {0}, keeping the previous version", scriptPath);
+				DebugHandler::PrintError("{0}", bytecode.size() > 1 ? bytecode.c_str() + 1 : "Unknown Error");
+				continue;
+			}
+
+			reloads.push_back({ bytecodeIndex, std::move(bytecode), hasNativeAnnotation });
+		}
+
+		if (reloads.size() == 0)
+			return true;
+
+		f32 compileTimeMS = timer.GetLifeTime() * 1000.0f;
+
+		// Every file is its own module, the only thing other code holds on to are the event callbacks it registered.
+		// Those get dropped for the reloaded script before its new chunk runs and registers them again
+		for (ScriptReload& reload : reloads)
+		{
+			LuaBytecodeEntry& bytecodeEntry = _bytecodeList[reload.bytecodeIndex];
+			bytecodeEntry.bytecode = std::move(reload.bytecode);
+			bytecodeEntry.hasNativeAnnotation = reload.hasNativeAnnotation;
+
+			std::string chunkName = bytecodeEntry.GetPath();
+			u32 scriptHash = StringUtils::fnv1a_32(chunkName.c_str(), chunkName.length());
+
+			if (!ReloadScript(_state, bytecodeEntry, scriptHash))
+				return false;
+
+			for (LuaSystemBase* luaSystem : _luaSystems)
+			{
+				for (lua_State* state : luaSystem->_states)
+				{
+					if (!ReloadScript(state, bytecodeEntry, scriptHash))
+						return false;
+				}
+			}
+		}
+
+		f32 reloadTimeMS = timer.GetLifeTime() * 1000.0f;
+		DebugHandler::Print("LuaManager : Hot reloaded {0} script(s) in {1:.2f}ms (compile {2:.2f}ms)", reloads.size(), reloadTimeMS, compileTimeMS);
+
+		return true;
+	}
+
+	bool LuaManager::ReloadScript(lua_State* state, const LuaBytecodeEntry& bytecodeEntry, u32 scriptHash)
+	{
+		auto gameEventHandler = GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
+		gameEventHandler->ClearScriptEvents(state, scriptHash);
+
+		// Code loaded into the same global table twice must not assume the environment is untouched
+		lua_setsafeenv(state, LUA_GLOBALSINDEX, false);
+
+		LuaStateCtx ctx(state);
+
+		i32 result = LoadModule(state, bytecodeEntry);
+		if (result != LUA_OK)
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		// PCall reports the runtime error itself, this says which script it came from and that the states now disagree on its version
+		result = ctx.PCall();
+		if (result != LUA_OK)
+		{
+			DebugHandler::PrintError("LuaManager : {0} failed to run after reloading it", bytecodeEntry.GetPath());
+			return false;
+		}
+
+		return true;
+	}
+
+	i32 LuaManager::LoadModule(lua_State* state, const LuaBytecodeEntry& bytecodeEntry)
+	{
+		LuaStateCtx ctx(state);
+
+		i32 result = ctx.LoadBytecode(bytecodeEntry.GetPath(), bytecodeEntry.bytecode, 0);
+		if (result == LUA_OK && LuaNativeCodegen::ShouldCompile(bytecodeEntry.hasNativeAnnotation))
+		{
+			LuaNativeCodegen::Compile(state);
+		}
+
+		return result;
+	}
+
+	void LuaManager::ConsumeMemoryStats(LuaMemoryStats& stats)
+	{
+		stats = LuaMemoryStats();
+
+		_statePool.ConsumeMemoryStats(stats);
+
+		for (LuaSystemBase* luaSystem : _luaSystems)
+		{
+			for (LuaStatePool* statePool : luaSystem->_statePools)
+			{
+				statePool->ConsumeMemoryStats(stats);
+			}
+		}
+	}
 }
\ No newline at end of file
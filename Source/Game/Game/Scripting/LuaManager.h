@@ -1,26 +1,43 @@
 #pragma once
 #include "LuaDefines.h"
+#include "LuaBytecodeCache.h"
+#include "LuaStatePool.h"
+#include "Game/ECS/SystemAccess.h"
+#include "Game/Util/FileWatcher.h"
 
 #include <Base/Types.h>
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 
-namespace enki
-{
-	class TaskSet;
-}
-
 namespace Scripting
 {
 	class GenericSystem;
 	class GameEventHandler;
+	class LuaStateBenchmark;
+	class LuaEventBenchmark;
+	class LuaNativeBenchmark;
+	class LuaBindingBenchmark;
+	class LuaTaskBenchmark;
 
 	struct LuaBytecodeEntry
 	{
-		const std::string fileName;
-		const std::string filePath;
+		std::string fileName;
+		std::string filePath;
 
-		const std::string bytecode;
+		std::string bytecode;
+		bool hasNativeAnnotation = false;
+
+		// Used as the chunk name in every state, callbacks are tracked per script through it
+		std::string GetPath() const { return filePath + "/" + fileName; }
+	};
+
+	struct LuaSystemStats
+	{
+	public:
+		f64 runTimeMS = 0.0; // Summed over every state and thread
+		f64 waitTimeMS = 0.0; // Time the main thread spent waiting for systems to finish
 	};
 
 	class LuaManager
@@ -29,8 +46,14 @@ namespace Scripting
 		LuaManager();
 
 		void Init();
+
+		// Launches the script systems on the task scheduler and returns without waiting for them
 		void Update(f32 deltaTime);
 
+		// Waits for every system, or only for the systems that conflict with access
+		void WaitForSystems();
+		void WaitForSystems(const ECS::SystemAccess& access);
+
 		bool DoString(const std::string& code);
 
 		template <typename T>
@@ -40,23 +63,45 @@ namespace Scripting
 				return false;
 
 			_globalTable.data[name] = value;
+			_globalTableVersion++;
 			_isDirty = true;
 			return true;
 		}
 
 		void SetDirty() { _isDirty = true; }
 
+		// Memory and garbage collection stats of every script VM since the last call
+		void ConsumeMemoryStats(LuaMemoryStats& stats);
+
+		// Time spent running and waiting for script systems since the last call
+		void ConsumeSystemStats(LuaSystemStats& stats);
+
 	private:
 		friend LuaHandlerBase;
 		friend LuaSystemBase;
 		friend GenericSystem;
 		friend GameEventHandler;
+		friend LuaStateBenchmark;
+		friend LuaEventBenchmark;
+		friend LuaNativeBenchmark;
+		friend LuaBindingBenchmark;
+		friend LuaTaskBenchmark;
 
 		void Prepare();
 		bool LoadScripts();
+		bool CompileScript(const std::string& scriptPath, bool useBytecodeCache, std::string& bytecode, bool& fromCache, bool& hasNativeAnnotation);
+
+		// Loads the module onto the top of the stack, compiling it to native code if it opted in
+		i32 LoadModule(lua_State* state, const LuaBytecodeEntry& bytecodeEntry);
+
+		// Reloads scripts that changed on disk into the existing states, falls back to a full reload if that isn't possible
+		void UpdateHotReload();
+		bool ReloadScripts(const std::vector<std::string>& scriptPaths);
+		bool ReloadScript(lua_State* state, const LuaBytecodeEntry& bytecodeEntry, u32 scriptHash);
 
 		void SetLuaHandler(LuaHandlerType handlerType, LuaHandlerBase* luaHandler);
 		void RegisterLuaSystem(LuaSystemBase* systemBase);
+		void WaitForSystem(LuaSystemBase* luaSystem);
 		
 		template <typename T>
 		T GetLuaHandler(LuaHandlerType handler)
@@ -70,17 +115,25 @@ namespace Scripting
 
 		const std::vector<LuaBytecodeEntry>& GetBytecodeList() { return _bytecodeList; }
 		const LuaTable& GetGlobalTable() { return _globalTable; }
+		u32 GetGlobalTableVersion() { return _globalTableVersion; }
 
 	private:
 		lua_State* _state;
 
 		std::vector<LuaHandlerBase*> _luaHandlers;
 		std::vector<LuaSystemBase*> _luaSystems;
-		std::vector<enki::TaskSet*> _tasks;
+		std::atomic<u64> _systemWaitTimeNS = 0; // Native systems wait from several tasks at once
 
 		std::vector<LuaBytecodeEntry> _bytecodeList;
 
 		LuaTable _globalTable;
+		u32 _globalTableVersion = 0;
+
+		LuaStatePool _statePool;
+		LuaBytecodeCache _bytecodeCache;
+		Util::FileWatcher _scriptWatcher;
+		std::chrono::steady_clock::time_point _scriptWatcherRetryTime;
+		u32 _scriptWatcherRetryDelayMS = 0;
 		
 		bool _isDirty = false;
 	};
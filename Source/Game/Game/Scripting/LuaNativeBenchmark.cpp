@@ -0,0 +1,146 @@
+#include "LuaNativeBenchmark.h"
+#include "LuaManager.h"
+#include "LuaStateCtx.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Luau/Compiler.h>
+#include <lualib.h>
+#include <luacodegen.h>
+#include <tracy/Tracy.hpp>
+
+#include <string>
+
+namespace Scripting
+{
+	// Every workload returns a function that takes the number of iterations
+	static const char* WorkloadNames[LuaNativeBenchmarkResult::NUM_WORKLOADS] =
+	{
+		"Math",
+		"Table",
+		"Binding"
+	};
+
+	static const char* WorkloadSources[LuaNativeBenchmarkResult::NUM_WORKLOADS] =
+	{
+		R"(
+		return function(numIterations)
+			local sum = 0
+			for i = 1, numIterations do
+				local x = i * 0.001
+				sum += math.sin(x) * math.cos(x) + math.sqrt(x) / (1 + x * x)
+			end
+			return sum
+		end
+		)",
+
+		R"(
+		return function(numIterations)
+			local items = table.create(256)
+			local sum = 0
+			for i = 1, numIterations do
+				local index = (i % 256) + 1
+				items[index] = { id = i, value = i * 2 }
+				sum += items[index].value
+			end
+			return sum
+		end
+		)",
+
+		R"(
+		return function(numIterations)
+			local panel = Panel.new()
+			local sum = 0
+			for i = 1, numIterations do
+				local x, y = Panel.GetPosition(panel)
+				sum += x + y
+			end
+			return sum
+		end
+		)"
+	};
+
+	void LuaNativeBenchmark::Run(u32 numIterations, LuaNativeBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaNativeBenchmarkResult();
+		result.isSupported = luau_codegen_supported() != 0;
+
+		for (u32 i = 0; i < LuaNativeBenchmarkResult::NUM_WORKLOADS; i++)
+		{
+			LuaNativeBenchmarkWorkload& workload = result.workloads[i];
+			workload.name = WorkloadNames[i];
+
+			std::string bytecode = Luau::compile(WorkloadSources[i]);
+
+			f64 compileMS = 0.0;
+			f64 interpreterKB = 0.0;
+			if (!RunWorkload(bytecode, false, numIterations, workload.interpreterMS, compileMS, interpreterKB))
+				continue;
+
+			if (!result.isSupported)
+				continue;
+
+			f64 nativeKB = 0.0;
+			if (!RunWorkload(bytecode, true, numIterations, workload.nativeMS, workload.compileMS, nativeKB))
+				continue;
+
+			workload.extraKB = nativeKB - interpreterKB;
+		}
+	}
+
+	bool LuaNativeBenchmark::RunWorkload(const std::string& bytecode, bool useNative, u32 numIterations, f64& runMS, f64& compileMS, f64& memoryKB)
+	{
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+
+		LuaStateCtx ctx(luaL_newstate());
+		ctx.RegisterDefaultLibraries();
+		ctx.SetGlobal(luaManager->GetGlobalTable());
+		ctx.MakeReadOnly();
+
+		lua_State* state = ctx.GetState();
+		if (useNative)
+		{
+			luau_codegen_create(state);
+		}
+
+		f64 memoryBeforeKB = static_cast<f64>(lua_gc(state, LUA_GCCOUNT, 0)) + (static_cast<f64>(lua_gc(state, LUA_GCCOUNTB, 0)) / 1024.0);
+
+		if (ctx.LoadBytecode("LuaNativeBenchmark", bytecode, 0) != LUA_OK)
+		{
+			ctx.ReportError();
+			ctx.Close();
+			return false;
+		}
+
+		Timer timer;
+
+		if (useNative)
+		{
+			luau_codegen_compile(state, -1);
+		}
+
+		compileMS = timer.GetLifeTime() * 1000.0;
+		memoryKB = (static_cast<f64>(lua_gc(state, LUA_GCCOUNT, 0)) + (static_cast<f64>(lua_gc(state, LUA_GCCOUNTB, 0)) / 1024.0)) - memoryBeforeKB;
+
+		bool didSucceed = false;
+		if (lua_pcall(state, 0, 1, 0) == LUA_OK && lua_isfunction(state, -1))
+		{
+			lua_pushnumber(state, static_cast<f64>(numIterations));
+
+			f64 startTime = timer.GetLifeTime();
+			didSucceed = lua_pcall(state, 1, 1, 0) == LUA_OK;
+			runMS = (timer.GetLifeTime() - startTime) * 1000.0;
+		}
+
+		if (!didSucceed)
+		{
+			ctx.ReportError();
+		}
+
+		ctx.Close();
+		return didSucceed;
+	}
+}
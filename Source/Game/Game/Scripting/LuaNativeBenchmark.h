@@ -0,0 +1,38 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <string>
+
+namespace Scripting
+{
+	struct LuaNativeBenchmarkWorkload
+	{
+	public:
+		const char* name = nullptr;
+
+		f64 interpreterMS = 0.0;
+		f64 nativeMS = 0.0;
+		f64 compileMS = 0.0;
+		f64 extraKB = 0.0; // Only counts the Lua heap, the native code itself lives in pages owned by the code generator
+	};
+
+	struct LuaNativeBenchmarkResult
+	{
+	public:
+		static constexpr u32 NUM_WORKLOADS = 3;
+
+		bool isSupported = false;
+		LuaNativeBenchmarkWorkload workloads[NUM_WORKLOADS];
+	};
+
+	// Runs a math heavy, a table heavy and a binding heavy module for numIterations iterations,
+	// once in the interpreter and once compiled to native code, each in a fresh state
+	class LuaNativeBenchmark
+	{
+	public:
+		static void Run(u32 numIterations, LuaNativeBenchmarkResult& result);
+
+	private:
+		static bool RunWorkload(const std::string& bytecode, bool useNative, u32 numIterations, f64& runMS, f64& compileMS, f64& memoryKB);
+	};
+}
@@ -0,0 +1,98 @@
+#include "LuaNativeCodegen.h"
+
+#include <Base/CVarSystem/CVarSystem.h>
+#include <Base/Util/DebugHandler.h>
+
+#include <lua.h>
+#include <luacodegen.h>
+#include <tracy/Tracy.hpp>
+
+#include <string_view>
+
+AutoCVar_Int CVAR_ScriptNativeEnabled("scripting.native.enabled", "allow script modules to be compiled to native code, requires a restart", 1, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_ScriptNativeCompileAll("scripting.native.compileAll", "compile every script module to native code instead of only the ones annotated with --!native", 0, CVarFlags::EditCheckbox);
+
+namespace Scripting
+{
+	bool LuaNativeCodegen::_isEnabled = false;
+
+	void LuaNativeCodegen::Init()
+	{
+		_isEnabled = false;
+
+		if (!CVAR_ScriptNativeEnabled.Get())
+			return;
+
+		if (!IsSupported())
+		{
+			DebugHandler::PrintWarning("LuaNativeCodegen : Native code generation isn't supported on this platform, scripts will run in the interpreter");
+			return;
+		}
+
+		_isEnabled = true;
+	}
+
+	bool LuaNativeCodegen::IsSupported()
+	{
+		return luau_codegen_supported() != 0;
+	}
+
+	void LuaNativeCodegen::PrepareState(lua_State* state)
+	{
+		if (!_isEnabled)
+			return;
+
+		luau_codegen_create(state);
+	}
+
+	bool LuaNativeCodegen::ShouldCompile(bool hasNativeAnnotation)
+	{
+		if (!_isEnabled)
+			return false;
+
+		return hasNativeAnnotation || CVAR_ScriptNativeCompileAll.Get();
+	}
+
+	void LuaNativeCodegen::Compile(lua_State* state, i32 index)
+	{
+		ZoneScoped;
+
+		if (!_isEnabled)
+			return;
+
+		luau_codegen_compile(state, index);
+	}
+
+	bool LuaNativeCodegen::HasNativeAnnotation(const std::string& source)
+	{
+		// Hot comments are only recognized in the comments before the first line of code
+		size_t lineStart = 0;
+		while (lineStart < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+			{
+				lineEnd = source.size();
+			}
+
+			std::string_view line(source.data() + lineStart, lineEnd - lineStart);
+
+			size_t first = line.find_first_not_of(" \t\r");
+			if (first != std::string_view::npos)
+			{
+				line = line.substr(first);
+
+				if (line.substr(0, 2) != "--")
+					return false;
+
+				size_t last = line.find_last_not_of(" \t\r");
+				if (line.substr(0, last + 1) == "--!native")
+					return true;
+			}
+
+			lineStart = lineEnd + 1;
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+
+#include <string>
+
+namespace Scripting
+{
+	// Compiles script modules to native code with the Luau CodeGen backend. Modules opt in with a "--!native" hot comment,
+	// or all of them are compiled if scripting.native.compileAll is set. On platforms without a backend everything keeps
+	// running in the interpreter. Whether states get a codegen context at all is decided once in Init.
+	class LuaNativeCodegen
+	{
+	public:
+		static void Init();
+
+		static bool IsSupported();
+		static bool IsEnabled() { return _isEnabled; }
+
+		// Must be called once for every VM before anything is compiled in it, threads share the context of their VM
+		static void PrepareState(lua_State* state);
+
+		static bool ShouldCompile(bool hasNativeAnnotation);
+
+		// Compiles the freshly loaded module at the given index, it runs in the interpreter until this is called
+		static void Compile(lua_State* state, i32 index = -1);
+
+		static bool HasNativeAnnotation(const std::string& source);
+
+	private:
+		LuaNativeCodegen() { }
+
+		static bool _isEnabled;
+	};
+}
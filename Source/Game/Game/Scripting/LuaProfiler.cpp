@@ -0,0 +1,596 @@
+#include "LuaProfiler.h"
+
+#include <Base/CVarSystem/CVarSystem.h>
+#include <Base/Util/DebugHandler.h>
+
+#include <lua.h>
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+
+AutoCVar_Int CVAR_ScriptProfilerSampleRate("scripting.profiler.sampleRateHz", "samples per second taken by the script profiler, changing it resets the profile on the next start", 1000);
+
+namespace Scripting
+{
+	// Bounds the memory of a long capture, the aggregated stacks keep counting once the timeline is full
+	static constexpr u32 MAX_VM_SAMPLES_PER_UPDATE = 64 * 1024;
+	static constexpr u32 MAX_TIMELINE_SAMPLES = 1024 * 1024;
+	static constexpr u32 INVALID_INDEX = std::numeric_limits<u32>::max();
+
+	std::atomic<u64> LuaProfiler::_ticks = 0;
+	std::atomic<bool> LuaProfiler::_isTimerRunning = false;
+	std::thread LuaProfiler::_timerThread;
+
+	std::mutex LuaProfiler::_vmStatesMutex;
+	std::vector<LuaProfiler::VMState*> LuaProfiler::_vmStates;
+	u32 LuaProfiler::_nextTrackID = 0;
+
+	bool LuaProfiler::_isRunning = false;
+	bool LuaProfiler::_isRequested = false;
+	bool LuaProfiler::_isResetRequested = false;
+	f64 LuaProfiler::_tickDurationMS = 1.0;
+
+	robin_hood::unordered_map<std::string, u32> LuaProfiler::_stackToProfileStack;
+	std::vector<LuaProfiler::ProfileStack> LuaProfiler::_profileStacks;
+
+	robin_hood::unordered_map<std::string, u32> LuaProfiler::_nameToFunction;
+	std::vector<LuaProfileFunction> LuaProfiler::_functions;
+	std::vector<u32> LuaProfiler::_functionStamps;
+	u32 LuaProfiler::_stamp = 0;
+
+	std::vector<LuaProfiler::TimelineSample> LuaProfiler::_timeline;
+	u64 LuaProfiler::_numSamples = 0;
+	u64 LuaProfiler::_numProfiledTicks = 0;
+	u64 LuaProfiler::_numDroppedSamples = 0;
+
+	static void WriteJsonString(std::ofstream& file, const std::string& value)
+	{
+		file << '"';
+
+		for (char c : value)
+		{
+			switch (c)
+			{
+				case '"': file << "\\\""; break;
+				case '\\': file << "\\\\"; break;
+				case '\n': file << "\\n"; break;
+				case '\t': file << "\\t"; break;
+
+				default:
+				{
+					if (static_cast<u8>(c) < 0x20)
+						continue;
+
+					file << c;
+					break;
+				}
+			}
+		}
+
+		file << '"';
+	}
+
+	void LuaProfiler::Start()
+	{
+		_isRequested = true;
+	}
+
+	void LuaProfiler::Stop()
+	{
+		_isRequested = false;
+	}
+
+	void LuaProfiler::Reset()
+	{
+		_isResetRequested = true;
+	}
+
+	void LuaProfiler::Shutdown()
+	{
+		_isTimerRunning = false;
+
+		if (_timerThread.joinable())
+		{
+			_timerThread.join();
+		}
+	}
+
+	void LuaProfiler::RegisterState(lua_State* state)
+	{
+		std::scoped_lock lock(_vmStatesMutex);
+
+		VMState* vmState = new VMState();
+		vmState->state = state;
+		vmState->trackID = _nextTrackID++;
+		vmState->lastTick = _ticks.load(std::memory_order_relaxed);
+
+		lua_Callbacks* callbacks = lua_callbacks(state);
+		callbacks->userdata = vmState;
+		callbacks->interrupt = _isRunning ? Interrupt : nullptr;
+
+		_vmStates.push_back(vmState);
+	}
+
+	void LuaProfiler::UnregisterState(lua_State* state)
+	{
+		std::scoped_lock lock(_vmStatesMutex);
+
+		lua_Callbacks* callbacks = lua_callbacks(state);
+		VMState* vmState = reinterpret_cast<VMState*>(callbacks->userdata);
+		if (vmState == nullptr)
+			return;
+
+		callbacks->userdata = nullptr;
+		callbacks->interrupt = nullptr;
+
+		// Keep what it sampled since the last update
+		MergeVMState(vmState);
+
+		auto itr = std::find(_vmStates.begin(), _vmStates.end(), vmState);
+		if (itr != _vmStates.end())
+		{
+			_vmStates.erase(itr);
+		}
+
+		delete vmState;
+	}
+
+	void LuaProfiler::OnEnter(lua_State* state)
+	{
+		lua_Callbacks* callbacks = lua_callbacks(state);
+		if (callbacks->interrupt == nullptr)
+			return;
+
+		VMState* vmState = reinterpret_cast<VMState*>(callbacks->userdata);
+		if (vmState->depth++ == 0)
+		{
+			vmState->lastTick = _ticks.load(std::memory_order_relaxed);
+		}
+	}
+
+	void LuaProfiler::OnLeave(lua_State* state)
+	{
+		lua_Callbacks* callbacks = lua_callbacks(state);
+		if (callbacks->interrupt == nullptr)
+			return;
+
+		VMState* vmState = reinterpret_cast<VMState*>(callbacks->userdata);
+		if (vmState->depth > 0)
+		{
+			vmState->depth--;
+		}
+	}
+
+	void LuaProfiler::Update()
+	{
+		ZoneScoped;
+
+		std::scoped_lock lock(_vmStatesMutex);
+
+		if (_isResetRequested)
+		{
+			ResetProfile();
+			_isResetRequested = false;
+		}
+
+		if (_isRequested != _isRunning)
+		{
+			ApplyRunning(_isRequested);
+		}
+
+		if (!_isRunning)
+			return;
+
+		for (VMState* vmState : _vmStates)
+		{
+			MergeVMState(vmState);
+		}
+	}
+
+	void LuaProfiler::GetTopFunctions(u32 count, std::vector<const LuaProfileFunction*>& functions)
+	{
+		functions.clear();
+		functions.reserve(_functions.size());
+
+		for (const LuaProfileFunction& function : _functions)
+		{
+			functions.push_back(&function);
+		}
+
+		count = std::min(count, static_cast<u32>(functions.size()));
+		std::partial_sort(functions.begin(), functions.begin() + count, functions.end(), [](const LuaProfileFunction* a, const LuaProfileFunction* b)
+		{
+			return a->selfTicks > b->selfTicks;
+		});
+
+		functions.resize(count);
+	}
+
+	bool LuaProfiler::ExportFolded(const std::string& path)
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			DebugHandler::PrintError("LuaProfiler : Failed to open {0} for writing", path);
+			return false;
+		}
+
+		for (const ProfileStack& profileStack : _profileStacks)
+		{
+			if (profileStack.ticks == 0)
+				continue;
+
+			for (u32 i = 0; i < profileStack.functions.size(); i++)
+			{
+				if (i > 0)
+				{
+					file << ';';
+				}
+
+				file << _functions[profileStack.functions[i]].name;
+			}
+
+			file << ' ' << profileStack.ticks << '\n';
+		}
+
+		return file.good();
+	}
+
+	bool LuaProfiler::ExportChromeTrace(const std::string& path)
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			DebugHandler::PrintError("LuaProfiler : Failed to open {0} for writing", path);
+			return false;
+		}
+
+		// Every VM is a track of its own, its samples are already in order
+		std::vector<TimelineSample> timeline = _timeline;
+		std::stable_sort(timeline.begin(), timeline.end(), [](const TimelineSample& a, const TimelineSample& b)
+		{
+			return a.trackID < b.trackID;
+		});
+
+		u64 firstTick = std::numeric_limits<u64>::max();
+		for (const TimelineSample& sample : timeline)
+		{
+			firstTick = std::min(firstTick, sample.tick - sample.numTicks);
+		}
+
+		f64 tickDurationUS = _tickDurationMS * 1000.0;
+		bool isFirstEvent = true;
+
+		auto writeEvent = [&](char phase, u32 trackID, u32 functionIndex, u64 tick)
+		{
+			file << (isFirstEvent ? "\n" : ",\n");
+			isFirstEvent = false;
+
+			file << "{\"ph\":\"" << phase << "\",\"pid\":0,\"tid\":" << trackID << ",\"ts\":" << static_cast<f64>(tick - firstTick) * tickDurationUS << ",\"name\":";
+			WriteJsonString(file, _functions[functionIndex].name);
+			file << '}';
+		};
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		std::vector<u32> openFunctions;
+		u32 trackID = INVALID_INDEX;
+		u64 lastTick = 0;
+
+		auto closeFunctions = [&](u32 numRemaining, u64 tick)
+		{
+			while (openFunctions.size() > numRemaining)
+			{
+				writeEvent('E', trackID, openFunctions.back(), tick);
+				openFunctions.pop_back();
+			}
+		};
+
+		for (const TimelineSample& sample : timeline)
+		{
+			u64 startTick = sample.tick - sample.numTicks;
+
+			// Close everything when moving on to the next track or when the VM didn't run in between two samples
+			if (sample.trackID != trackID || startTick != lastTick)
+			{
+				closeFunctions(0, lastTick);
+			}
+
+			if (sample.trackID != trackID)
+			{
+				trackID = sample.trackID;
+
+				file << (isFirstEvent ? "\n" : ",\n");
+				isFirstEvent = false;
+				file << "{\"ph\":\"M\",\"pid\":0,\"tid\":" << trackID << ",\"name\":\"thread_name\",\"args\":{\"name\":\"Lua VM " << trackID << "\"}}";
+			}
+
+			const std::vector<u32>& functions = _profileStacks[sample.stackIndex].functions;
+
+			u32 numShared = 0;
+			while (numShared < openFunctions.size() && numShared < functions.size() && openFunctions[numShared] == functions[numShared])
+			{
+				numShared++;
+			}
+
+			closeFunctions(numShared, startTick);
+
+			for (u32 i = numShared; i < functions.size(); i++)
+			{
+				writeEvent('B', trackID, functions[i], startTick);
+				openFunctions.push_back(functions[i]);
+			}
+
+			lastTick = sample.tick;
+		}
+
+		closeFunctions(0, lastTick);
+
+		file << "\n]}\n";
+		return file.good();
+	}
+
+	void LuaProfiler::Interrupt(lua_State* state, i32 gc)
+	{
+		VMState* vmState = reinterpret_cast<VMState*>(lua_callbacks(state)->userdata);
+		if (vmState == nullptr)
+			return;
+
+		// This runs at every safepoint of every running state, everything up to here has to stay cheap
+		u64 currentTick = _ticks.load(std::memory_order_relaxed);
+		if (currentTick == vmState->lastTick)
+			return;
+
+		u32 numTicks = static_cast<u32>(currentTick - vmState->lastTick);
+		vmState->lastTick = currentTick;
+
+		if (vmState->depth == 0)
+			return;
+
+		std::string& stack = vmState->scratch;
+		stack.clear();
+
+		if (gc > 0)
+		{
+			stack += "[GC]";
+		}
+
+		lua_Debug ar;
+		for (i32 level = 0; lua_getinfo(state, level, "sn", &ar); level++)
+		{
+			if (!stack.empty())
+			{
+				stack += ';';
+			}
+
+			stack += ar.name != nullptr ? ar.name : "<anonymous>";
+			stack += " (";
+			stack += ar.short_src;
+
+			if (ar.linedefined > 0)
+			{
+				stack += ':';
+				stack += std::to_string(ar.linedefined);
+			}
+
+			stack += ')';
+		}
+
+		if (stack.empty())
+			return;
+
+		u32 stackIndex = 0;
+
+		auto itr = vmState->stackToIndex.find(stack);
+		if (itr != vmState->stackToIndex.end())
+		{
+			stackIndex = itr->second;
+		}
+		else
+		{
+			stackIndex = static_cast<u32>(vmState->stacks.size());
+
+			vmState->stackToIndex[stack] = stackIndex;
+			vmState->stacks.push_back(stack);
+			vmState->stackToProfileStack.push_back(INVALID_INDEX);
+			vmState->stackTicks.push_back(0);
+		}
+
+		if (vmState->stackTicks[stackIndex] == 0)
+		{
+			vmState->dirtyStacks.push_back(stackIndex);
+		}
+
+		vmState->stackTicks[stackIndex] += numTicks;
+
+		if (vmState->samples.size() < MAX_VM_SAMPLES_PER_UPDATE)
+		{
+			vmState->samples.push_back({ currentTick, numTicks, stackIndex });
+		}
+		else
+		{
+			vmState->numDroppedSamples++;
+		}
+	}
+
+	void LuaProfiler::RunTimer()
+	{
+		// Ticks are derived from the elapsed time rather than counted, so oversleeping doesn't slow the clock down
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		u64 startTick = _ticks.load();
+
+		std::chrono::microseconds interval(std::max(static_cast<i64>(_tickDurationMS * 1000.0), static_cast<i64>(1)));
+
+		while (_isTimerRunning)
+		{
+			std::this_thread::sleep_for(interval);
+
+			f64 elapsedMS = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+			_ticks.store(startTick + static_cast<u64>(elapsedMS / _tickDurationMS), std::memory_order_relaxed);
+		}
+	}
+
+	void LuaProfiler::ApplyRunning(bool isRunning)
+	{
+		if (isRunning)
+		{
+			i32 sampleRate = std::clamp(CVAR_ScriptProfilerSampleRate.Get(), 10, 10000);
+			f64 tickDurationMS = 1000.0 / static_cast<f64>(sampleRate);
+
+			// Ticks of different lengths can't be mixed in one profile
+			if (tickDurationMS != _tickDurationMS)
+			{
+				ResetProfile();
+				_tickDurationMS = tickDurationMS;
+			}
+
+			_isTimerRunning = true;
+			_timerThread = std::thread(RunTimer);
+		}
+		else
+		{
+			Shutdown();
+		}
+
+		u64 currentTick = _ticks.load();
+
+		for (VMState* vmState : _vmStates)
+		{
+			if (!isRunning)
+			{
+				MergeVMState(vmState);
+			}
+
+			vmState->lastTick = currentTick;
+			vmState->depth = 0;
+
+			lua_callbacks(vmState->state)->interrupt = isRunning ? Interrupt : nullptr;
+		}
+
+		_isRunning = isRunning;
+	}
+
+	void LuaProfiler::ResetProfile()
+	{
+		for (VMState* vmState : _vmStates)
+		{
+			vmState->stackToIndex.clear();
+			vmState->stacks.clear();
+			vmState->stackToProfileStack.clear();
+			vmState->stackTicks.clear();
+			vmState->dirtyStacks.clear();
+			vmState->samples.clear();
+			vmState->numDroppedSamples = 0;
+		}
+
+		_stackToProfileStack.clear();
+		_profileStacks.clear();
+
+		_nameToFunction.clear();
+		_functions.clear();
+		_functionStamps.clear();
+
+		_timeline.clear();
+		_numSamples = 0;
+		_numProfiledTicks = 0;
+		_numDroppedSamples = 0;
+	}
+
+	void LuaProfiler::MergeVMState(VMState* vmState)
+	{
+		for (u32 stackIndex : vmState->dirtyStacks)
+		{
+			u32& profileStackIndex = vmState->stackToProfileStack[stackIndex];
+			if (profileStackIndex == INVALID_INDEX)
+			{
+				profileStackIndex = GetProfileStack(vmState->stacks[stackIndex]);
+			}
+
+			u64 ticks = vmState->stackTicks[stackIndex];
+			vmState->stackTicks[stackIndex] = 0;
+
+			ProfileStack& profileStack = _profileStacks[profileStackIndex];
+			profileStack.ticks += ticks;
+
+			// Recursive functions show up several times in one stack but the time only passed once
+			_stamp++;
+			for (u32 functionIndex : profileStack.functions)
+			{
+				if (_functionStamps[functionIndex] == _stamp)
+					continue;
+
+				_functionStamps[functionIndex] = _stamp;
+				_functions[functionIndex].totalTicks += ticks;
+			}
+
+			_functions[profileStack.functions.back()].selfTicks += ticks;
+			_numProfiledTicks += ticks;
+		}
+
+		vmState->dirtyStacks.clear();
+
+		for (const Sample& sample : vmState->samples)
+		{
+			if (_timeline.size() >= MAX_TIMELINE_SAMPLES)
+			{
+				_numDroppedSamples++;
+				continue;
+			}
+
+			_timeline.push_back({ sample.tick, sample.numTicks, vmState->stackToProfileStack[sample.stackIndex], vmState->trackID });
+		}
+
+		_numSamples += vmState->samples.size();
+		_numDroppedSamples += vmState->numDroppedSamples;
+
+		vmState->samples.clear();
+		vmState->numDroppedSamples = 0;
+	}
+
+	u32 LuaProfiler::GetProfileStack(const std::string& stack)
+	{
+		auto itr = _stackToProfileStack.find(stack);
+		if (itr != _stackToProfileStack.end())
+			return itr->second;
+
+		u32 profileStackIndex = static_cast<u32>(_profileStacks.size());
+		ProfileStack& profileStack = _profileStacks.emplace_back();
+
+		// Stacks are captured leaf first
+		size_t end = stack.size();
+		while (true)
+		{
+			size_t start = stack.rfind(';', end - 1);
+			size_t nameStart = start == std::string::npos ? 0 : start + 1;
+
+			profileStack.functions.push_back(GetFunction(stack.substr(nameStart, end - nameStart)));
+
+			if (start == std::string::npos)
+				break;
+
+			end = start;
+		}
+
+		_stackToProfileStack[stack] = profileStackIndex;
+		return profileStackIndex;
+	}
+
+	u32 LuaProfiler::GetFunction(const std::string& name)
+	{
+		auto itr = _nameToFunction.find(name);
+		if (itr != _nameToFunction.end())
+			return itr->second;
+
+		u32 functionIndex = static_cast<u32>(_functions.size());
+
+		LuaProfileFunction& function = _functions.emplace_back();
+		function.name = name;
+		_functionStamps.push_back(0);
+
+		_nameToFunction[name] = functionIndex;
+		return functionIndex;
+	}
+}
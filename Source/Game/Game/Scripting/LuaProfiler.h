@@ -0,0 +1,150 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+
+#include <robinhood/robinhood.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Scripting
+{
+	struct LuaProfileFunction
+	{
+	public:
+		std::string name;
+
+		u64 selfTicks = 0;
+		u64 totalTicks = 0; // Counted once per sample even if the function is on the stack several times
+	};
+
+	// Sampling profiler for script code. A timer thread advances a tick counter at scripting.profiler.sampleRateHz and the interrupt
+	// callback of every VM records its current stack whenever it sees the counter moved, attributing the elapsed ticks to that stack.
+	// Samples are only written to buffers owned by the VM that took them, so running states never wait on each other,
+	// and are merged into the profile at the start of the next script update.
+	class LuaProfiler
+	{
+	public:
+		// Start and Stop take effect at the next script update, where no state is running
+		static void Start();
+		static void Stop();
+		static void Reset();
+		static bool IsRunning() { return _isRunning; }
+
+		// Stops the timer thread, the profile is kept
+		static void Shutdown();
+
+		// Must be called for every VM when it is created and before it is closed, threads share the sampling state of their VM
+		static void RegisterState(lua_State* state);
+		static void UnregisterState(lua_State* state);
+
+		// Wrap every call into a state so the time it spent idle before isn't attributed to the first stack sampled
+		static void OnEnter(lua_State* state);
+		static void OnLeave(lua_State* state);
+
+		// Merges the samples of every VM into the profile, no state may be running
+		static void Update();
+
+		static f64 GetTickDurationMS() { return _tickDurationMS; }
+		static u64 GetNumSamples() { return _numSamples; }
+		static u64 GetNumTicks() { return _numProfiledTicks; }
+		static u64 GetNumDroppedSamples() { return _numDroppedSamples; }
+
+		// Sorted by self time
+		static void GetTopFunctions(u32 count, std::vector<const LuaProfileFunction*>& functions);
+
+		// Folded stacks ("root;...;leaf ticks" per line) as read by flamegraph.pl and speedscope, and the Chrome trace event format
+		static bool ExportFolded(const std::string& path);
+		static bool ExportChromeTrace(const std::string& path);
+
+	private:
+		friend class LuaProfilerBenchmark;
+
+		LuaProfiler() { }
+
+		struct Sample
+		{
+		public:
+			u64 tick;
+			u32 numTicks;
+			u32 stackIndex;
+		};
+
+		struct VMState
+		{
+		public:
+			lua_State* state = nullptr;
+			u32 trackID = 0;
+
+			u64 lastTick = 0;
+			u32 depth = 0;
+
+			std::string scratch;
+
+			robin_hood::unordered_map<std::string, u32> stackToIndex; // Leaf first, frames separated by ';'
+			std::vector<std::string> stacks;
+			std::vector<u32> stackToProfileStack;
+
+			std::vector<u64> stackTicks;
+			std::vector<u32> dirtyStacks;
+			std::vector<Sample> samples;
+			u32 numDroppedSamples = 0;
+		};
+
+		struct ProfileStack
+		{
+		public:
+			std::vector<u32> functions; // Root first
+			u64 ticks = 0;
+		};
+
+		struct TimelineSample
+		{
+		public:
+			u64 tick;
+			u32 numTicks;
+			u32 stackIndex;
+			u32 trackID;
+		};
+
+		static void Interrupt(lua_State* state, i32 gc);
+		static void RunTimer();
+
+		static void ApplyRunning(bool isRunning);
+		static void ResetProfile();
+		static void MergeVMState(VMState* vmState);
+		static u32 GetProfileStack(const std::string& stack);
+		static u32 GetFunction(const std::string& name);
+
+	private:
+		static std::atomic<u64> _ticks;
+		static std::atomic<bool> _isTimerRunning;
+		static std::thread _timerThread;
+
+		static std::mutex _vmStatesMutex;
+		static std::vector<VMState*> _vmStates;
+		static u32 _nextTrackID;
+
+		static bool _isRunning;
+		static bool _isRequested;
+		static bool _isResetRequested;
+		static f64 _tickDurationMS;
+
+		static robin_hood::unordered_map<std::string, u32> _stackToProfileStack;
+		static std::vector<ProfileStack> _profileStacks;
+
+		static robin_hood::unordered_map<std::string, u32> _nameToFunction;
+		static std::vector<LuaProfileFunction> _functions;
+		static std::vector<u32> _functionStamps;
+		static u32 _stamp;
+
+		static std::vector<TimelineSample> _timeline;
+		static u64 _numSamples;
+		static u64 _numProfiledTicks;
+		static u64 _numDroppedSamples;
+	};
+}
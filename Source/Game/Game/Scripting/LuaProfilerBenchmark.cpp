@@ -0,0 +1,141 @@
+#include "LuaProfilerBenchmark.h"
+#include "LuaProfiler.h"
+#include "LuaStateCtx.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Luau/Compiler.h>
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace Scripting
+{
+	// Both runs are repeated and the fastest one kept, a single run is too noisy to show an overhead of a few percent
+	static constexpr u32 PROFILER_BENCHMARK_NUM_RUNS = 5;
+
+	// Calls several levels deep with a mix of arithmetic and table work, so the sampled stacks look like the ones of real scripts
+	static const char* ProfilerWorkloadSource = R"(
+		local function fib(n)
+			if n < 2 then
+				return n
+			end
+
+			return fib(n - 1) + fib(n - 2)
+		end
+
+		local function fill(count)
+			local values = table.create(count)
+			for i = 1, count do
+				values[i] = (i * 7919) % count
+			end
+
+			table.sort(values)
+			return values[count]
+		end
+
+		return function()
+			return fib(18) + fill(512)
+		end
+	)";
+
+	static f64 RunProfilerWorkload(lua_State* state, i32 workloadRef, u32 numIterations)
+	{
+		f64 bestMS = 0.0;
+
+		for (u32 run = 0; run < PROFILER_BENCHMARK_NUM_RUNS; run++)
+		{
+			Timer timer;
+
+			for (u32 i = 0; i < numIterations; i++)
+			{
+				LuaProfiler::OnEnter(state);
+
+				lua_getref(state, workloadRef);
+				i32 status = lua_pcall(state, 0, 0, 0);
+
+				LuaProfiler::OnLeave(state);
+
+				if (status != LUA_OK)
+				{
+					LuaStateCtx ctx(state);
+					ctx.ReportError();
+					return 0.0;
+				}
+			}
+
+			f64 totalMS = timer.GetLifeTime() * 1000.0;
+			bestMS = run == 0 ? totalMS : std::min(bestMS, totalMS);
+		}
+
+		return bestMS;
+	}
+
+	bool LuaProfilerBenchmark::Run(u32 numIterations, u32 sampleRate, LuaProfilerBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaProfilerBenchmarkResult();
+
+		if (numIterations == 0 || sampleRate == 0)
+			return false;
+
+		// The timer thread and the tick duration are shared with a running capture
+		if (LuaProfiler::_isRunning || LuaProfiler::_isTimerRunning)
+			return false;
+
+		LuaStateCtx ctx(luaL_newstate());
+		ctx.RegisterDefaultLibraries();
+
+		lua_State* state = ctx.GetState();
+
+		std::string bytecode = Luau::compile(ProfilerWorkloadSource);
+		if (ctx.LoadBytecode("LuaProfilerBenchmark", bytecode, 0) != LUA_OK || lua_pcall(state, 0, 1, 0) != LUA_OK)
+		{
+			ctx.ReportError();
+			lua_close(state);
+			return false;
+		}
+
+		i32 workloadRef = lua_ref(state, -1);
+		lua_pop(state, 1);
+
+		// Not registered with the profiler, so its samples stay out of the profile
+		LuaProfiler::VMState vmState;
+		vmState.state = state;
+
+		lua_Callbacks* callbacks = lua_callbacks(state);
+		callbacks->userdata = &vmState;
+
+		// Warm up once, then off before on so the off run doesn't benefit from a warmer cache
+		RunProfilerWorkload(state, workloadRef, numIterations);
+		result.offMS = RunProfilerWorkload(state, workloadRef, numIterations);
+
+		f64 previousTickDurationMS = LuaProfiler::_tickDurationMS;
+		LuaProfiler::_tickDurationMS = 1000.0 / static_cast<f64>(sampleRate);
+		LuaProfiler::_isTimerRunning = true;
+		LuaProfiler::_timerThread = std::thread(LuaProfiler::RunTimer);
+
+		vmState.lastTick = LuaProfiler::_ticks.load();
+		callbacks->interrupt = LuaProfiler::Interrupt;
+
+		result.onMS = RunProfilerWorkload(state, workloadRef, numIterations);
+
+		callbacks->interrupt = nullptr;
+		callbacks->userdata = nullptr;
+
+		LuaProfiler::Shutdown();
+		LuaProfiler::_tickDurationMS = previousTickDurationMS;
+
+		result.sampleRate = sampleRate;
+		result.numSamples = vmState.samples.size() + vmState.numDroppedSamples;
+		result.overheadPercent = result.offMS > 0.0 ? (result.onMS - result.offMS) / result.offMS * 100.0 : 0.0;
+
+		lua_unref(state, workloadRef);
+		lua_close(state);
+
+		return result.offMS > 0.0 && result.onMS > 0.0;
+	}
+}
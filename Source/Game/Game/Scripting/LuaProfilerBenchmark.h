@@ -0,0 +1,23 @@
+#pragma once
+#include <Base/Types.h>
+
+namespace Scripting
+{
+	struct LuaProfilerBenchmarkResult
+	{
+	public:
+		u32 sampleRate = 0;
+		f64 offMS = 0.0;
+		f64 onMS = 0.0;
+		f64 overheadPercent = 0.0;
+		u64 numSamples = 0;
+	};
+
+	// Runs the same script workload numIterations times with the profiler off and sampling at sampleRate, on a state of its own.
+	// The benchmark drives the timer thread itself and never touches the collected profile, so the profiler has to be stopped.
+	class LuaProfilerBenchmark
+	{
+	public:
+		static bool Run(u32 numIterations, u32 sampleRate, LuaProfilerBenchmarkResult& result);
+	};
+}
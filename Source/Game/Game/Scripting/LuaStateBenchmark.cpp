@@ -0,0 +1,147 @@
+#include "LuaStateBenchmark.h"
+#include "LuaManager.h"
+#include "LuaNativeCodegen.h"
+#include "LuaStateCtx.h"
+#include "LuaStatePool.h"
+#include "Handlers/GameEventHandler.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <Base/Util/Timer.h>
+
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+#include <vector>
+
+namespace Scripting
+{
+	void LuaStateBenchmark::Run(u32 numStates, LuaStateBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaStateBenchmarkResult();
+
+		if (numStates == 0)
+			return;
+
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		auto gameEventHandler = luaManager->GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
+
+		const LuaTable& table = luaManager->GetGlobalTable();
+		u32 globalsVersion = luaManager->GetGlobalTableVersion();
+
+		std::vector<lua_State*> states(numStates);
+		f64 numStatesF64 = static_cast<f64>(numStates);
+
+		Timer timer;
+
+		// From scratch, every state opens the libraries and sets the globals itself
+		{
+			f64 startTime = timer.GetLifeTime();
+
+			for (u32 i = 0; i < numStates; i++)
+			{
+				LuaStateCtx ctx(luaL_newstate());
+				ctx.RegisterDefaultLibraries();
+				ctx.SetGlobal(table);
+				ctx.MakeReadOnly();
+				LuaNativeCodegen::PrepareState(ctx.GetState());
+
+				LoadScripts(ctx.GetState());
+				states[i] = ctx.GetState();
+			}
+
+			result.freshMSPerState = ((timer.GetLifeTime() - startTime) * 1000.0) / numStatesF64;
+
+			for (u32 i = 0; i < numStates; i++)
+			{
+				result.freshKBPerState += GetMemoryUsageKB(states[i]) / numStatesF64;
+
+				gameEventHandler->ClearEvents(states[i]);
+				lua_close(states[i]);
+			}
+		}
+
+		// Threads of a frozen base state
+		{
+			LuaStatePool pool(0);
+
+			f64 startTime = timer.GetLifeTime();
+
+			lua_State* baseState = pool.Acquire(table, globalsVersion);
+			if (baseState == nullptr)
+				return;
+
+			pool.Release(baseState);
+
+			result.baseMS = (timer.GetLifeTime() - startTime) * 1000.0;
+			result.baseKB = static_cast<f64>(pool.GetMemoryUsage()) / 1024.0;
+
+			// The first pass has to create the threads, the second one gets the ones released by the first
+			for (u32 pass = 0; pass < 2; pass++)
+			{
+				startTime = timer.GetLifeTime();
+
+				for (u32 i = 0; i < numStates; i++)
+				{
+					states[i] = pool.Acquire(table, globalsVersion);
+					LoadScripts(states[i]);
+				}
+
+				f64 msPerState = ((timer.GetLifeTime() - startTime) * 1000.0) / numStatesF64;
+				if (pass == 0)
+				{
+					result.pooledMSPerState = msPerState;
+					result.pooledKBPerState = ((static_cast<f64>(pool.GetMemoryUsage()) / 1024.0) - result.baseKB) / numStatesF64;
+				}
+				else
+				{
+					result.reusedMSPerState = msPerState;
+				}
+
+				for (u32 i = 0; i < numStates; i++)
+				{
+					gameEventHandler->ClearEvents(states[i]);
+					pool.Release(states[i]);
+				}
+			}
+		}
+	}
+
+	void LuaStateBenchmark::LoadScripts(lua_State* state)
+	{
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		auto gameEventHandler = luaManager->GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
+
+		LuaStateCtx ctx(state);
+
+		const std::vector<LuaBytecodeEntry>& bytecodeList = luaManager->GetBytecodeList();
+		for (const LuaBytecodeEntry& bytecodeEntry : bytecodeList)
+		{
+			i32 result = luaManager->LoadModule(state, bytecodeEntry);
+			if (result != LUA_OK)
+			{
+				ctx.Pop();
+			}
+		}
+
+		gameEventHandler->SetupEvents(state);
+
+		i32 top = ctx.GetTop();
+		for (i32 i = 0; i < top; i++)
+		{
+			ctx.Resume();
+
+			if (ctx.GetStatus() != LUA_OK)
+			{
+				ctx.Pop();
+				break;
+			}
+		}
+	}
+
+	f64 LuaStateBenchmark::GetMemoryUsageKB(lua_State* state)
+	{
+		return static_cast<f64>(lua_gc(state, LUA_GCCOUNT, 0)) + (static_cast<f64>(lua_gc(state, LUA_GCCOUNTB, 0)) / 1024.0);
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+
+namespace Scripting
+{
+	struct LuaStateBenchmarkResult
+	{
+	public:
+		f64 freshMSPerState = 0.0;
+		f64 freshKBPerState = 0.0;
+
+		f64 baseMS = 0.0;
+		f64 baseKB = 0.0;
+
+		f64 pooledMSPerState = 0.0;
+		f64 pooledKBPerState = 0.0;
+		f64 reusedMSPerState = 0.0;
+	};
+
+	// Creates numStates states with every script loaded into them, once from scratch with a VM per state and once as threads
+	// handed out by a LuaStatePool, both when the pool has to create them and when it reuses released ones.
+	// The scripts are the bytecode the LuaManager loaded last, so the numbers change with what is in the script directory
+	class LuaStateBenchmark
+	{
+	public:
+		static void Run(u32 numStates, LuaStateBenchmarkResult& result);
+
+	private:
+		static void LoadScripts(lua_State* state);
+		static f64 GetMemoryUsageKB(lua_State* state);
+	};
+}
@@ -1,4 +1,5 @@
 #include "LuaStateCtx.h"
+#include "LuaProfiler.h"
 #include "Handlers/GameEventHandler.h"
 #include "Handlers/GlobalHandler.h"
 
@@ -6,6 +7,8 @@
 
 #include <lualib.h>
 
+#include <type_traits>
+
 namespace Scripting
 {
 	void LuaStateCtx::GetRaw(i32 index)
@@ -63,70 +66,17 @@ namespace Scripting
 	}
 	void LuaStateCtx::SetGlobal(const char* key, const LuaTable& value)
 	{
-		SetLuaTable(key, value, 0);
+		PushTable(key, value);
+		SetGlobal(key);
 	}
 	void LuaStateCtx::SetGlobal(const LuaTable& value, bool isMetaTable /*= false*/)
 	{
 		for (const auto& pair : value.data)
 		{
-			const std::string& key = pair.first;
-			const std::any& value = pair.second;
+			const char* key = pair.first.c_str();
 
-			auto& type = value.type();
-			if (value.type() == typeid(bool))
-			{
-				auto val = std::any_cast<bool>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(i32))
-			{
-				auto val = std::any_cast<i32>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(u32))
-			{
-				auto val = std::any_cast<u32>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(f32))
-			{
-				auto val = std::any_cast<f32>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(f64))
-			{
-				auto val = std::any_cast<f64>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(vec3))
-			{
-				auto val = std::any_cast<vec3>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(char*))
-			{
-				auto val = std::any_cast<char*>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(std::string))
-			{
-				auto val = std::any_cast<std::string>(value);
-				SetGlobal(key.c_str(), val.c_str());
-			}
-			else if (value.type() == typeid(lua_CFunction))
-			{
-				auto val = std::any_cast<lua_CFunction>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else if (value.type() == typeid(LuaTable))
-			{
-				auto& val = std::any_cast<LuaTable>(value);
-				SetGlobal(key.c_str(), val);
-			}
-			else
-			{
-				DebugHandler::PrintFatal("Failed to SetGlobal, invalid typeid");
-			}
+			PushValue(key, pair.second);
+			SetGlobal(key);
 		}
 	}
 
@@ -145,11 +95,14 @@ namespace Scripting
 		return lua_status(_state);
 	}
 
-	void LuaStateCtx::PCall(i32 numResults /*= 0*/, i32 errorfunc /*= 0*/)
+	i32 LuaStateCtx::PCall(i32 numResults /*= 0*/, i32 errorfunc /*= 0*/)
 	{
 		u32 numArgs = _pushCounter;
 
+		LuaProfiler::OnEnter(_state);
 		i32 result = lua_pcall(_state, numArgs, numResults, errorfunc);
+		LuaProfiler::OnLeave(_state);
+
 		if (result != LUA_OK)
 		{
 			DebugHandler::PrintError("[Scripting] Failed to run a script. Please check the errors below and correct them");
@@ -158,6 +111,7 @@ namespace Scripting
 		}
 
 		_pushCounter = 0;
+		return result;
 	}
 
 	void LuaStateCtx::PushNil(bool incrementPushCounter /*= true*/)
@@ -195,7 +149,7 @@ namespace Scripting
 		lua_pushstring(_state, value);
 		_pushCounter += 1 * incrementPushCounter;
 	}
-	void LuaStateCtx::PushVector(vec3& value, bool incrementPushCounter)
+	void LuaStateCtx::PushVector(const vec3& value, bool incrementPushCounter)
 	{
 		lua_pushvector(_state, value.x, value.y, value.z);
 		_pushCounter += 1 * incrementPushCounter;
@@ -210,6 +164,66 @@ namespace Scripting
 		lua_rawgeti(_state, LUA_REGISTRYINDEX, funcRef);
 		_pushCounter += 1 * incrementPushCounter;
 	}
+	void LuaStateCtx::PushValue(const char* name, const LuaValue& value, bool incrementPushCounter /*= true*/)
+	{
+		std::visit([&](const auto& val)
+		{
+			using T = std::decay_t<decltype(val)>;
+
+			if constexpr (std::is_same_v<T, std::monostate>)
+			{
+				PushNil(incrementPushCounter);
+			}
+			else if constexpr (std::is_same_v<T, bool>)
+			{
+				PushBool(val, incrementPushCounter);
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				lua_pushlstring(_state, val.c_str(), val.size());
+				_pushCounter += 1 * incrementPushCounter;
+			}
+			else if constexpr (std::is_same_v<T, vec3>)
+			{
+				PushVector(val, incrementPushCounter);
+			}
+			else if constexpr (std::is_same_v<T, lua_CFunction>)
+			{
+				PushCFunction(val, incrementPushCounter);
+			}
+			else if constexpr (std::is_same_v<T, std::shared_ptr<const LuaTable>>)
+			{
+				PushTable(name, *val, incrementPushCounter);
+			}
+			else
+			{
+				PushNumber(val, incrementPushCounter);
+			}
+		}, value.data);
+	}
+	void LuaStateCtx::PushTable(const char* name, const LuaTable& table, bool incrementPushCounter /*= true*/)
+	{
+		if (table.isMetaTable)
+		{
+			CreateMetaTable(name);
+		}
+		else
+		{
+			lua_createtable(_state, 0, static_cast<i32>(table.data.size()));
+		}
+
+		// The table is fresh, so there are no metamethods to go through
+		for (const auto& pair : table.data)
+		{
+			const std::string& key = pair.first;
+
+			lua_pushlstring(_state, key.c_str(), key.size());
+			PushValue(key.c_str(), pair.second, false);
+			lua_rawset(_state, -3);
+		}
+
+		_pushCounter += 1 * incrementPushCounter;
+	}
 	void LuaStateCtx::Pop(i32 index /*= -1*/)
 	{
 		lua_pop(_state, index);
@@ -350,7 +364,9 @@ namespace Scripting
 
 	void LuaStateCtx::SetTable(const char* key, LuaTable& value, i32 index /*= -3*/)
 	{
-		SetLuaTable(key, value, 1);
+		PushString(key);
+		PushTable(key, value);
+		SetTable(index);
 	}
 
 	i32 LuaStateCtx::LoadBytecode(const std::string& chunkName, const std::string& bytecode, i32 env)
@@ -360,7 +376,11 @@ namespace Scripting
 
 	i32 LuaStateCtx::Resume(i32 index, lua_State* from)
 	{
-		return lua_resume(_state, from, index);
+		LuaProfiler::OnEnter(_state);
+		i32 result = lua_resume(_state, from, index);
+		LuaProfiler::OnLeave(_state);
+
+		return result;
 	}
 
 	void LuaStateCtx::MakeReadOnly()
@@ -384,122 +404,4 @@ namespace Scripting
 	{
 		luaL_openlibs(_state);
 	}
-	void LuaStateCtx::SetLuaTable(const char* key, const LuaTable& value, u32 recursiveCounter)
-	{
-		if (recursiveCounter > 0)
-		{
-			PushString(key);
-		}
-
-		if (value.isMetaTable)
-		{
-			CreateMetaTable(key);
-		}
-		else
-		{
-			CreateTable();
-		}
-
-		for (const auto& pair : value.data)
-		{
-			const std::string& key = pair.first;
-			const std::any& any = pair.second;
-
-			auto& type = any.type();
-
-			if (any.type() == typeid(bool))
-			{
-				auto val = std::any_cast<bool>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(i32))
-			{
-				auto val = std::any_cast<i32>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(u32))
-			{
-				auto val = std::any_cast<u32>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(f32))
-			{
-				auto val = std::any_cast<f32>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(f64))
-			{
-				auto val = std::any_cast<f64>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(vec3))
-			{
-				auto val = std::any_cast<vec3>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(vec3*))
-			{
-				auto val = std::any_cast<vec3*>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(char*))
-			{
-				auto val = std::any_cast<char*>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(const char*))
-			{
-				auto val = std::any_cast<const char*>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(std::string))
-			{
-				auto val = std::any_cast<std::string>(any);
-				SetTable(key.c_str(), val.c_str());
-			}
-			else if (any.type() == typeid(std::string*))
-			{
-				auto val = std::any_cast<std::string*>(any);
-				SetTable(key.c_str(), val->c_str());
-			}
-			else if (any.type() == typeid(lua_CFunction))
-			{
-				auto val = std::any_cast<lua_CFunction>(any);
-				SetTable(key.c_str(), *val);
-			}
-			else if (any.type() == typeid(lua_CFunction&))
-			{
-				auto val = std::any_cast<const lua_CFunction&>(any);
-				SetTable(key.c_str(), *val);
-			}
-			else if (any.type() == typeid(lua_CFunction*))
-			{
-				auto val = std::any_cast<lua_CFunction*>(any);
-				SetTable(key.c_str(), val);
-			}
-			else if (any.type() == typeid(LuaTable))
-			{
-				auto& val = std::any_cast<const LuaTable>(any);
-				SetLuaTable(key.c_str(), val, recursiveCounter + 1);
-			}
-			else if (any.type() == typeid(LuaTable&))
-			{
-				const auto& val = std::any_cast<const LuaTable&>(any);
-				SetLuaTable(key.c_str(), val, recursiveCounter + 1);
-			}
-			else
-			{
-				DebugHandler::PrintFatal("Failed to SetLuaTable, invalid typeid ({0})", any.type().name());
-			}
-		}
-
-		if (recursiveCounter > 0)
-		{
-			SetTable();
-		}
-		else
-		{
-			SetGlobal(key);
-		}
-	}
 }
\ No newline at end of file
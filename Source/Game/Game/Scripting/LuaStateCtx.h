@@ -31,7 +31,7 @@ namespace Scripting
 
 		i32 GetStatus();
 
-		void PCall(i32 numResults = 0, i32 errorfunc = 0);
+		i32 PCall(i32 numResults = 0, i32 errorfunc = 0);
 
 		void PushNil(bool incrementPushCounter = true);
 		void PushBool(bool value, bool incrementPushCounter = true);
@@ -40,10 +40,14 @@ namespace Scripting
 		void PushNumber(f32 value, bool incrementPushCounter = true);
 		void PushNumber(f64 value, bool incrementPushCounter = true);
 		void PushString(const char* value, bool incrementPushCounter = true);
-		void PushVector(vec3& value, bool incrementPushCounter = true);
+		void PushVector(const vec3& value, bool incrementPushCounter = true);
 		void PushCFunction(lua_CFunction func, bool incrementPushCounter = true);
 		void PushLFunction(i32 funcRef, bool incrementPushCounter = true);
 
+		// The name is only used for tables that are meta tables, they are registered under it
+		void PushValue(const char* name, const LuaValue& value, bool incrementPushCounter = true);
+		void PushTable(const char* name, const LuaTable& table, bool incrementPushCounter = true);
+
 		template <typename T>
 		T* PushUserData(LuaUserDataDtor dtor, bool incrementPushCounter = true)
 		{
@@ -98,9 +102,6 @@ namespace Scripting
 	public: // Custom Helper API
 		void RegisterDefaultLibraries();
 
-	private: // Internal Helpers
-		void SetLuaTable(const char* key, const LuaTable& value, u32 recursiveCounter);
-
 	private:
 		lua_State* _state;
 		u32 _pushCounter;
@@ -0,0 +1,295 @@
+#include "LuaStatePool.h"
+#include "LuaNativeCodegen.h"
+#include "LuaProfiler.h"
+#include "LuaStateCtx.h"
+
+#include <Base/CVarSystem/CVarSystem.h>
+#include <Base/Util/DebugHandler.h>
+#include <Base/Util/Timer.h>
+
+#include <lua.h>
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+AutoCVar_Int CVAR_ScriptMemorySoftLimitMB("scripting.memory.softLimitMB", "script heap size per VM above which a full garbage collection runs at the start of the next frame", 64);
+AutoCVar_Int CVAR_ScriptMemoryHardLimitMB("scripting.memory.hardLimitMB", "script heap size per VM above which allocations fail with a memory error, 0 disables the limit", 256);
+AutoCVar_Float CVAR_ScriptGCStepBudgetMS("scripting.gc.stepBudgetMS", "time per VM and frame spent on incremental garbage collection at the start of the frame", 0.25f);
+
+namespace Scripting
+{
+	// Amount of work per call to lua_gc(LUA_GCSTEP), small enough to stay close to the time budget
+	static constexpr i32 GC_STEP_SIZE_KB = 8;
+
+	LuaStatePool::~LuaStatePool()
+	{
+		Clear();
+	}
+
+	lua_State* LuaStatePool::Acquire(const LuaTable& globals, u32 globalsVersion)
+	{
+		ZoneScoped;
+
+		Base* base = _bases.size() > 0 ? _bases.back() : nullptr;
+		if (base == nullptr || base->globalsVersion != globalsVersion)
+		{
+			// Nothing holds on to the current base anymore, there's no reason to keep it around next to the new one
+			if (base != nullptr && base->numAcquired == 0)
+			{
+				DestroyBase(base);
+				_bases.pop_back();
+			}
+
+			base = CreateBase(globals, globalsVersion);
+			if (base == nullptr)
+				return nullptr;
+
+			_bases.push_back(base);
+		}
+
+		lua_State* state = nullptr;
+		if (base->freeStates.size() > 0)
+		{
+			state = base->freeStates.back();
+			base->freeStates.pop_back();
+		}
+		else
+		{
+			state = CreateThread(base);
+		}
+
+		base->numAcquired++;
+		return state;
+	}
+
+	void LuaStatePool::Release(lua_State* state)
+	{
+		lua_State* mainState = lua_mainthread(state);
+
+		for (u32 i = 0; i < _bases.size(); i++)
+		{
+			Base* base = _bases[i];
+			if (base->state != mainState)
+				continue;
+
+			base->numAcquired--;
+
+			bool isCurrent = i == _bases.size() - 1;
+			if (isCurrent)
+			{
+				ResetThread(base, state);
+				base->freeStates.push_back(state);
+			}
+			else if (base->numAcquired == 0)
+			{
+				DestroyBase(base);
+				_bases.erase(_bases.begin() + i);
+			}
+
+			return;
+		}
+
+		DebugHandler::PrintError("LuaStatePool : Tried to release a state that doesn't belong to this pool");
+	}
+
+	void LuaStatePool::Clear()
+	{
+		for (Base* base : _bases)
+		{
+			if (base->numAcquired > 0)
+			{
+				DebugHandler::PrintWarning("LuaStatePool : Closing a base state that still has {0} acquired states", base->numAcquired);
+			}
+
+			DestroyBase(base);
+		}
+
+		_bases.clear();
+	}
+
+	u32 LuaStatePool::GetNumAcquired() const
+	{
+		u32 numAcquired = 0;
+
+		for (const Base* base : _bases)
+		{
+			numAcquired += base->numAcquired;
+		}
+
+		return numAcquired;
+	}
+
+	u32 LuaStatePool::GetNumFree() const
+	{
+		u32 numFree = 0;
+
+		for (const Base* base : _bases)
+		{
+			numFree += static_cast<u32>(base->freeStates.size());
+		}
+
+		return numFree;
+	}
+
+	size_t LuaStatePool::GetMemoryUsage() const
+	{
+		size_t memoryUsage = 0;
+
+		for (const Base* base : _bases)
+		{
+			memoryUsage += base->allocator->GetUsedBytes();
+		}
+
+		return memoryUsage;
+	}
+
+	void LuaStatePool::StepGC()
+	{
+		ZoneScoped;
+
+		size_t softLimit = static_cast<size_t>(CVAR_ScriptMemorySoftLimitMB.Get()) * 1024 * 1024;
+		f64 budgetMS = static_cast<f64>(CVAR_ScriptGCStepBudgetMS.Get());
+
+		Timer timer;
+
+		for (Base* base : _bases)
+		{
+			size_t usedBytes = base->allocator->GetUsedBytes();
+			bool hasGrown = usedBytes >= base->heapBytesAfterCycle + (base->heapBytesAfterCycle / 2);
+
+			// A full collection doesn't help if most of the heap survived the last one
+			if (softLimit > 0 && usedBytes > softLimit && hasGrown)
+			{
+				lua_gc(base->state, LUA_GCCOLLECT, 0);
+
+				base->isCycleInProgress = false;
+				base->heapBytesAfterCycle = base->allocator->GetUsedBytes();
+				_numFullCollections++;
+				continue;
+			}
+
+			// Stepping while the collector is paused starts a new cycle, so only do that once the heap grew enough to be worth it.
+			// That happens well before Luau's own threshold, paying the work off here keeps it from landing in the middle of a script
+			if (!base->isCycleInProgress && !hasGrown)
+				continue;
+
+			base->isCycleInProgress = true;
+
+			f64 startTime = timer.GetLifeTime();
+			while ((timer.GetLifeTime() - startTime) * 1000.0 < budgetMS)
+			{
+				// Returns 1 once a cycle finished
+				if (lua_gc(base->state, LUA_GCSTEP, GC_STEP_SIZE_KB))
+				{
+					base->isCycleInProgress = false;
+					base->heapBytesAfterCycle = base->allocator->GetUsedBytes();
+					break;
+				}
+			}
+		}
+
+		_gcTimeMS += timer.GetLifeTime() * 1000.0;
+	}
+
+	void LuaStatePool::ConsumeMemoryStats(LuaMemoryStats& stats)
+	{
+		for (Base* base : _bases)
+		{
+			LuaAllocator* allocator = base->allocator;
+
+			stats.heapBytes += allocator->GetUsedBytes();
+			stats.reservedBytes += allocator->GetReservedBytes();
+			stats.numAllocations += allocator->GetNumAllocations();
+			stats.numFailedAllocations += allocator->GetNumFailedAllocations();
+
+			allocator->ResetFrameStats();
+		}
+
+		stats.numFullCollections += _numFullCollections;
+		stats.numBasesCreated += _numBasesCreated;
+		stats.baseCreateMS += _baseCreateMS;
+		stats.gcTimeMS += _gcTimeMS;
+
+		_numFullCollections = 0;
+		_gcTimeMS = 0.0;
+		_numBasesCreated = 0;
+		_baseCreateMS = 0.0;
+	}
+
+	LuaStatePool::Base* LuaStatePool::CreateBase(const LuaTable& globals, u32 globalsVersion)
+	{
+		ZoneScoped;
+
+		Timer timer;
+
+		size_t hardLimit = static_cast<size_t>(CVAR_ScriptMemoryHardLimitMB.Get()) * 1024 * 1024;
+		LuaAllocator* allocator = new LuaAllocator(hardLimit);
+
+		// The allocator refuses anything over the hard limit, including the VM itself
+		lua_State* state = lua_newstate(LuaAllocator::Allocate, allocator);
+		if (state == nullptr)
+		{
+			DebugHandler::PrintError("LuaStatePool : Failed to create a VM, scripting.memory.hardLimitMB ({0} MB) is too small", CVAR_ScriptMemoryHardLimitMB.Get());
+
+			delete allocator;
+			return nullptr;
+		}
+
+		Base* base = new Base();
+		base->globalsVersion = globalsVersion;
+		base->allocator = allocator;
+
+		LuaStateCtx ctx(state);
+		ctx.RegisterDefaultLibraries();
+		ctx.SetGlobal(globals);
+		ctx.MakeReadOnly();
+		LuaNativeCodegen::PrepareState(ctx.GetState());
+		LuaProfiler::RegisterState(ctx.GetState());
+
+		base->state = ctx.GetState();
+
+		base->freeStates.reserve(_numPrewarmedStates);
+		for (u32 i = 0; i < _numPrewarmedStates; i++)
+		{
+			base->freeStates.push_back(CreateThread(base));
+		}
+
+		_baseCreateMS += timer.GetLifeTime() * 1000.0;
+		_numBasesCreated++;
+
+		return base;
+	}
+
+	void LuaStatePool::DestroyBase(Base* base)
+	{
+		LuaProfiler::UnregisterState(base->state);
+
+		// Closing the base collects every thread created from it
+		lua_close(base->state);
+
+		delete base->allocator;
+		delete base;
+	}
+
+	lua_State* LuaStatePool::CreateThread(Base* base)
+	{
+		lua_State* state = lua_newthread(base->state);
+		base->stateToRef[state] = lua_ref(base->state, -1);
+		lua_pop(base->state, 1);
+
+		luaL_sandboxthread(state);
+		return state;
+	}
+
+	void LuaStatePool::ResetThread(Base* base, lua_State* state)
+	{
+		lua_resetthread(state);
+
+		// Point the thread back at the frozen globals before giving it a fresh global table of its own,
+		// otherwise it would keep reading through to whatever the previous scripts left in the old one
+		lua_pushvalue(base->state, LUA_GLOBALSINDEX);
+		lua_xmove(base->state, state, 1);
+		lua_replace(state, LUA_GLOBALSINDEX);
+
+		luaL_sandboxthread(state);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "LuaDefines.h"
+#include "LuaAllocator.h"
+
+#include <Base/Types.h>
+
+#include <robinhood/robinhood.h>
+
+#include <vector>
+
+namespace Scripting
+{
+	struct LuaMemoryStats
+	{
+	public:
+		size_t heapBytes = 0;
+		size_t reservedBytes = 0;
+		u32 numAllocations = 0;
+		u32 numFailedAllocations = 0;
+		u32 numFullCollections = 0;
+		f64 gcTimeMS = 0.0;
+
+		// Every pool has a VM of its own so its states can run next to the other pools, building one is the cost the pool doesn't remove
+		u32 numBasesCreated = 0;
+		f64 baseCreateMS = 0.0;
+	};
+
+	// Opens the libraries and sets the globals once into a base state that is then frozen with luaL_sandbox.
+	// The states handed out are threads of that base, each with its own global table that reads through to the frozen one,
+	// so they share the libraries and bindings but scripts loaded into one of them can't see or modify another.
+	// Threads share the VM of their base, so a pool must only be used by one thread at a time.
+	class LuaStatePool
+	{
+	public:
+		LuaStatePool(u32 numPrewarmedStates = 1) : _numPrewarmedStates(numPrewarmedStates) { }
+		~LuaStatePool();
+
+		// A new base is built when the globals changed since the current one was, older bases are closed once all of their states are released.
+		// Returns nullptr if the base couldn't be created, which happens when scripting.memory.hardLimitMB is too small to hold it
+		lua_State* Acquire(const LuaTable& globals, u32 globalsVersion);
+		void Release(lua_State* state);
+
+		// All acquired states must have been released
+		void Clear();
+
+		u32 GetNumAcquired() const;
+		u32 GetNumFree() const;
+		size_t GetMemoryUsage() const;
+
+		// Runs the garbage collector of every base for up to scripting.gc.stepBudgetMS, or a full collection if it is over the soft limit.
+		// The states of the pool must not be running
+		void StepGC();
+
+		// Adds the stats gathered since the last call
+		void ConsumeMemoryStats(LuaMemoryStats& stats);
+
+	private:
+		struct Base
+		{
+		public:
+			lua_State* state = nullptr;
+			LuaAllocator* allocator = nullptr;
+			u32 globalsVersion = 0;
+			u32 numAcquired = 0;
+
+			bool isCycleInProgress = false;
+			size_t heapBytesAfterCycle = 0;
+
+			std::vector<lua_State*> freeStates;
+			robin_hood::unordered_map<lua_State*, i32> stateToRef; // The refs keep the threads from being collected
+		};
+
+		Base* CreateBase(const LuaTable& globals, u32 globalsVersion);
+		void DestroyBase(Base* base);
+		lua_State* CreateThread(Base* base);
+		void ResetThread(Base* base, lua_State* state);
+
+	private:
+		std::vector<Base*> _bases; // The last one is current
+		u32 _numPrewarmedStates = 0;
+
+		f64 _gcTimeMS = 0.0;
+		u32 _numFullCollections = 0;
+		f64 _baseCreateMS = 0.0;
+		u32 _numBasesCreated = 0;
+	};
+}
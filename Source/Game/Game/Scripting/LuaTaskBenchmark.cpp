@@ -0,0 +1,187 @@
+#include "LuaTaskBenchmark.h"
+#include "LuaManager.h"
+#include "LuaStateCtx.h"
+#include "LuaTaskScheduler.h"
+#include "Handlers/GameEventHandler.h"
+#include "Game/Util/ServiceLocator.h"
+
+#include <Base/Util/Timer.h>
+
+#include <Luau/Compiler.h>
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+#include <string>
+
+namespace Scripting
+{
+	static constexpr f64 TASK_BENCHMARK_DELTA_TIME = 1.0 / 60.0;
+	static constexpr f64 TASK_BENCHMARK_SLEEP_TIME = 1000000.0;
+
+	static const char* SleepingTaskSource = R"(
+		local numTasks, delay = ...
+		for i = 1, numTasks do
+			Task.Spawn(function()
+				while true do
+					Task.Wait(delay)
+				end
+			end)
+		end
+	)";
+
+	static const char* PollingTaskSource = R"(
+		local numTasks, delay = ...
+		local callbacks = table.create(numTasks)
+		for i = 1, numTasks do
+			local wakeTime = delay
+			callbacks[i] = function(time)
+				if time >= wakeTime then
+					wakeTime = time + delay
+				end
+			end
+		end
+
+		return function(time)
+			for i = 1, numTasks do
+				callbacks[i](time)
+			end
+		end
+	)";
+
+	static lua_State* CreateTaskBenchmarkState(LuaManager* luaManager, GameEventHandler* gameEventHandler)
+	{
+		LuaStateCtx ctx(luaL_newstate());
+		ctx.RegisterDefaultLibraries();
+		ctx.SetGlobal(luaManager->GetGlobalTable());
+		ctx.MakeReadOnly();
+
+		gameEventHandler->SetupEvents(ctx.GetState());
+
+		return ctx.GetState();
+	}
+
+	// Runs the chunk with numTasks and delay as its arguments
+	static bool RunTaskBenchmarkChunk(lua_State* state, const char* source, u32 numTasks, f64 delay, i32 numResults)
+	{
+		LuaStateCtx ctx(state);
+
+		std::string bytecode = Luau::compile(source);
+		if (ctx.LoadBytecode("LuaTaskBenchmark", bytecode, 0) != LUA_OK)
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		lua_pushnumber(state, static_cast<f64>(numTasks));
+		lua_pushnumber(state, delay);
+
+		if (lua_pcall(state, 2, numResults, 0) != LUA_OK)
+		{
+			ctx.ReportError();
+			return false;
+		}
+
+		return true;
+	}
+
+	void LuaTaskBenchmark::Run(u32 numTasks, u32 numFrames, LuaTaskBenchmarkResult& result)
+	{
+		ZoneScoped;
+
+		result = LuaTaskBenchmarkResult();
+
+		if (numTasks == 0 || numFrames == 0)
+			return;
+
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		auto gameEventHandler = luaManager->GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
+
+		// Sleeping, none of the tasks wake up while the benchmark runs
+		{
+			lua_State* state = CreateTaskBenchmarkState(luaManager, gameEventHandler);
+			LuaTaskScheduler* taskScheduler = LuaTaskScheduler::Get(state);
+
+			lua_gc(state, LUA_GCCOLLECT, 0);
+			i32 startKB = lua_gc(state, LUA_GCCOUNT, 0);
+
+			Timer timer;
+			if (RunTaskBenchmarkChunk(state, SleepingTaskSource, numTasks, TASK_BENCHMARK_SLEEP_TIME, 0))
+			{
+				result.spawnMS = timer.GetLifeTime() * 1000.0;
+				result.numWaiting = taskScheduler->GetNumWaiting();
+
+				lua_gc(state, LUA_GCCOLLECT, 0);
+				i32 endKB = lua_gc(state, LUA_GCCOUNT, 0);
+				result.bytesPerTask = static_cast<f64>(endKB - startKB) * 1024.0 / numTasks;
+
+				f64 startTime = timer.GetLifeTime();
+				for (u32 i = 0; i < numFrames; i++)
+				{
+					taskScheduler->Update(TASK_BENCHMARK_DELTA_TIME);
+				}
+
+				result.idleUpdateMS = (timer.GetLifeTime() - startTime) * 1000.0 / numFrames;
+			}
+
+			gameEventHandler->ClearEvents(state);
+			lua_close(state);
+		}
+
+		// Polling, every function checks its own timer each frame
+		{
+			lua_State* state = CreateTaskBenchmarkState(luaManager, gameEventHandler);
+
+			if (RunTaskBenchmarkChunk(state, PollingTaskSource, numTasks, TASK_BENCHMARK_SLEEP_TIME, 1))
+			{
+				i32 updateRef = lua_ref(state, -1);
+				lua_pop(state, 1);
+
+				Timer timer;
+				f64 time = 0.0;
+
+				for (u32 i = 0; i < numFrames; i++)
+				{
+					time += TASK_BENCHMARK_DELTA_TIME;
+
+					lua_getref(state, updateRef);
+					lua_pushnumber(state, time);
+					if (lua_pcall(state, 1, 0, 0) != LUA_OK)
+					{
+						LuaStateCtx ctx(state);
+						ctx.ReportError();
+						break;
+					}
+				}
+
+				result.pollingUpdateMS = timer.GetLifeTime() * 1000.0 / numFrames;
+			}
+
+			gameEventHandler->ClearEvents(state);
+			lua_close(state);
+		}
+
+		// Waking, every task waits for the next update so each update resumes all of them
+		{
+			lua_State* state = CreateTaskBenchmarkState(luaManager, gameEventHandler);
+			LuaTaskScheduler* taskScheduler = LuaTaskScheduler::Get(state);
+
+			if (RunTaskBenchmarkChunk(state, SleepingTaskSource, numTasks, 0.0, 0))
+			{
+				Timer timer;
+
+				for (u32 i = 0; i < numFrames; i++)
+				{
+					taskScheduler->Update(TASK_BENCHMARK_DELTA_TIME);
+				}
+
+				f64 totalMS = timer.GetLifeTime() * 1000.0;
+
+				result.wakeUpdateMS = totalMS / numFrames;
+				result.wakesPerMS = totalMS > 0.0 ? static_cast<f64>(numTasks) * numFrames / totalMS : 0.0;
+			}
+
+			gameEventHandler->ClearEvents(state);
+			lua_close(state);
+		}
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <Base/Types.h>
+
+namespace Scripting
+{
+	struct LuaTaskBenchmarkResult
+	{
+	public:
+		u32 numWaiting = 0;
+		f64 spawnMS = 0.0;
+		f64 bytesPerTask = 0.0;
+		f64 idleUpdateMS = 0.0;
+		f64 pollingUpdateMS = 0.0;
+		f64 wakeUpdateMS = 0.0;
+		f64 wakesPerMS = 0.0;
+	};
+
+	// Spawns numTasks tasks that sleep far longer than the benchmark runs and updates their scheduler numFrames times, to compare
+	// against the same number of functions checking a timer every frame. The cost of waking is measured with tasks that wait
+	// for the next update every time they run. Each pass gets a VM and scheduler of its own, tasks the game spawned are never updated
+	class LuaTaskBenchmark
+	{
+	public:
+		static void Run(u32 numTasks, u32 numFrames, LuaTaskBenchmarkResult& result);
+	};
+}
@@ -0,0 +1,307 @@
+#include "LuaTaskScheduler.h"
+#include "LuaStateCtx.h"
+#include "Handlers/LuaEventHandlerBase.h"
+
+#include <Base/Util/StringUtils.h>
+
+#include <lualib.h>
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Scripting
+{
+	std::atomic<u32> LuaTaskScheduler::_nextOperationID = 1;
+	std::mutex LuaTaskScheduler::_operationsMutex;
+	robin_hood::unordered_set<u32> LuaTaskScheduler::_pendingOperations;
+	std::vector<std::pair<u32, bool>> LuaTaskScheduler::_pendingCompletedOperations;
+	std::vector<std::pair<u32, bool>> LuaTaskScheduler::_completedOperations;
+	robin_hood::unordered_map<u32, bool> LuaTaskScheduler::_operationResults;
+	std::deque<std::pair<u64, u32>> LuaTaskScheduler::_operationResultExpiry;
+	u64 LuaTaskScheduler::_operationUpdate = 0;
+
+	LuaTaskScheduler::LuaTaskScheduler(lua_State* owner, u32 numEvents) : _owner(owner)
+	{
+		_eventTasks.resize(numEvents);
+	}
+
+	LuaTaskScheduler* LuaTaskScheduler::Get(lua_State* state)
+	{
+		LuaEventTable* eventTable = LuaEventHandlerBase::GetEventTable(state);
+		return eventTable != nullptr ? eventTable->taskScheduler : nullptr;
+	}
+
+	lua_State* LuaTaskScheduler::Spawn(lua_State* state, i32 numArgs)
+	{
+		lua_State* thread = lua_newthread(state);
+
+		// Leave the thread where the function was and move the function and its arguments over to it
+		lua_insert(state, -(numArgs + 2));
+		lua_xmove(state, thread, numArgs + 1);
+
+		// Tasks share the event table of the state that spawned them, which is how the Task functions find this scheduler
+		lua_setthreaddata(thread, lua_getthreaddata(state));
+		_taskThreads.insert(thread);
+
+		Resume(CreateTask(thread), numArgs);
+		return thread;
+	}
+
+	void LuaTaskScheduler::WaitForTime(lua_State* thread, f64 seconds)
+	{
+		_lastWaitingThread = thread;
+
+		SleepingTask sleepingTask;
+		sleepingTask.wakeTime = _time + std::max(seconds, 0.0);
+		sleepingTask.startTime = _time;
+		sleepingTask.sequence = _sequence++;
+		sleepingTask.task = CreateTask(thread);
+
+		_sleepingTasks.push_back(sleepingTask);
+		std::push_heap(_sleepingTasks.begin(), _sleepingTasks.end(), IsLater);
+	}
+
+	void LuaTaskScheduler::WaitForEvent(lua_State* thread, u32 eventID)
+	{
+		_lastWaitingThread = thread;
+		_eventTasks[eventID].push_back(CreateTask(thread));
+	}
+
+	void LuaTaskScheduler::WaitForOperation(lua_State* thread, u32 operationID)
+	{
+		_lastWaitingThread = thread;
+		_operationTasks.push_back({ operationID, CreateTask(thread) });
+	}
+
+	void LuaTaskScheduler::Update(f64 deltaTime)
+	{
+		_time += deltaTime;
+
+		if (_sleepingTasks.size() > 0 && _sleepingTasks.front().wakeTime <= _time)
+		{
+			ZoneScopedN("LuaTaskScheduler::WakeSleepingTasks");
+
+			while (_sleepingTasks.size() > 0 && _sleepingTasks.front().wakeTime <= _time)
+			{
+				std::pop_heap(_sleepingTasks.begin(), _sleepingTasks.end(), IsLater);
+				_wakingTasks.push_back(_sleepingTasks.back());
+				_sleepingTasks.pop_back();
+			}
+
+			// Tasks that go back to sleep with no delay are pushed onto the heap again, so they can't be woken twice in one update
+			for (const SleepingTask& sleepingTask : _wakingTasks)
+			{
+				lua_pushnumber(sleepingTask.task.thread, _time - sleepingTask.startTime);
+				Resume(sleepingTask.task, 1);
+			}
+
+			_wakingTasks.clear();
+		}
+
+		if (_completedOperations.size() > 0 && _operationTasks.size() > 0)
+		{
+			ZoneScopedN("LuaTaskScheduler::WakeOperationTasks");
+
+			std::vector<std::pair<u32, LuaTask>> operationTasks;
+			operationTasks.swap(_operationTasks);
+
+			for (const auto& pair : operationTasks)
+			{
+				OperationState operationState = GetOperationState(pair.first);
+				if (operationState == OperationState::Pending)
+				{
+					_operationTasks.push_back(pair);
+					continue;
+				}
+
+				PushOperationResult(pair.second.thread, operationState);
+				Resume(pair.second, 1);
+			}
+		}
+	}
+
+	void LuaTaskScheduler::ClearScriptTasks(u32 scriptHash)
+	{
+		auto isFromScript = [this, scriptHash](const LuaTask& task)
+		{
+			if (task.scriptHash != scriptHash)
+				return false;
+
+			_taskThreads.erase(task.thread);
+			ReleaseTask(task);
+			return true;
+		};
+
+		auto sleepingEnd = std::remove_if(_sleepingTasks.begin(), _sleepingTasks.end(), [&](const SleepingTask& sleepingTask) { return isFromScript(sleepingTask.task); });
+		_sleepingTasks.erase(sleepingEnd, _sleepingTasks.end());
+		std::make_heap(_sleepingTasks.begin(), _sleepingTasks.end(), IsLater);
+
+		for (std::vector<LuaTask>& tasks : _eventTasks)
+		{
+			tasks.erase(std::remove_if(tasks.begin(), tasks.end(), isFromScript), tasks.end());
+		}
+
+		auto operationEnd = std::remove_if(_operationTasks.begin(), _operationTasks.end(), [&](const std::pair<u32, LuaTask>& pair) { return isFromScript(pair.second); });
+		_operationTasks.erase(operationEnd, _operationTasks.end());
+	}
+
+	void LuaTaskScheduler::Clear()
+	{
+		for (const SleepingTask& sleepingTask : _sleepingTasks)
+		{
+			ReleaseTask(sleepingTask.task);
+		}
+
+		for (std::vector<LuaTask>& tasks : _eventTasks)
+		{
+			for (const LuaTask& task : tasks)
+			{
+				ReleaseTask(task);
+			}
+
+			tasks.clear();
+		}
+
+		for (const auto& pair : _operationTasks)
+		{
+			ReleaseTask(pair.second);
+		}
+
+		_sleepingTasks.clear();
+		_operationTasks.clear();
+		_taskThreads.clear();
+	}
+
+	u32 LuaTaskScheduler::GetNumWaiting() const
+	{
+		size_t numWaiting = _sleepingTasks.size() + _operationTasks.size();
+
+		for (const std::vector<LuaTask>& tasks : _eventTasks)
+		{
+			numWaiting += tasks.size();
+		}
+
+		return static_cast<u32>(numWaiting);
+	}
+
+	u32 LuaTaskScheduler::BeginOperation()
+	{
+		std::scoped_lock lock(_operationsMutex);
+
+		u32 operationID = _nextOperationID++;
+		_pendingOperations.insert(operationID);
+
+		return operationID;
+	}
+
+	void LuaTaskScheduler::CompleteOperation(u32 operationID, bool success)
+	{
+		std::scoped_lock lock(_operationsMutex);
+		_pendingCompletedOperations.push_back({ operationID, success });
+	}
+
+	LuaTaskScheduler::OperationState LuaTaskScheduler::GetOperationState(u32 operationID)
+	{
+		auto itr = _operationResults.find(operationID);
+		if (itr != _operationResults.end())
+			return itr->second ? OperationState::Succeeded : OperationState::Failed;
+
+		if (operationID == 0 || operationID >= _nextOperationID.load())
+			return OperationState::Invalid;
+
+		std::scoped_lock lock(_operationsMutex);
+		return _pendingOperations.contains(operationID) ? OperationState::Pending : OperationState::Expired;
+	}
+
+	void LuaTaskScheduler::PushOperationResult(lua_State* state, OperationState operationState)
+	{
+		if (operationState == OperationState::Expired)
+		{
+			lua_pushnil(state);
+			return;
+		}
+
+		lua_pushboolean(state, operationState == OperationState::Succeeded);
+	}
+
+	void LuaTaskScheduler::UpdateOperations()
+	{
+		std::scoped_lock lock(_operationsMutex);
+
+		_operationUpdate++;
+
+		while (_operationResultExpiry.size() > 0 && _operationUpdate - _operationResultExpiry.front().first > OPERATION_RESULT_LIFETIME)
+		{
+			_operationResults.erase(_operationResultExpiry.front().second);
+			_operationResultExpiry.pop_front();
+		}
+
+		_completedOperations.clear();
+		_completedOperations.swap(_pendingCompletedOperations);
+
+		for (const auto& pair : _completedOperations)
+		{
+			_pendingOperations.erase(pair.first);
+
+			_operationResults[pair.first] = pair.second;
+			_operationResultExpiry.push_back({ _operationUpdate, pair.first });
+		}
+	}
+
+	bool LuaTaskScheduler::IsLater(const SleepingTask& a, const SleepingTask& b)
+	{
+		if (a.wakeTime != b.wakeTime)
+			return a.wakeTime > b.wakeTime;
+
+		return a.sequence > b.sequence;
+	}
+
+	LuaTask LuaTaskScheduler::CreateTask(lua_State* thread)
+	{
+		LuaTask task;
+		task.thread = thread;
+
+		lua_pushthread(thread);
+		task.threadRef = lua_ref(thread, -1);
+		lua_pop(thread, 1);
+
+		// Level 1 is the function that called into the Task API, a task that hasn't started yet has none
+		lua_Debug debugInfo;
+		if (lua_getinfo(thread, 1, "s", &debugInfo) && debugInfo.source != nullptr)
+		{
+			task.scriptHash = StringUtils::fnv1a_32(debugInfo.source, strlen(debugInfo.source));
+		}
+
+		return task;
+	}
+
+	void LuaTaskScheduler::ReleaseTask(const LuaTask& task)
+	{
+		lua_unref(_owner, task.threadRef);
+	}
+
+	void LuaTaskScheduler::Resume(const LuaTask& task, i32 numArgs)
+	{
+		LuaStateCtx ctx(task.thread);
+
+		i32 result = ctx.Resume(numArgs);
+		if (result != LUA_OK && result != LUA_YIELD)
+		{
+			ctx.ReportError();
+		}
+
+		// The waits are the last thing a task does before it yields, anything resumed in between already returned
+		bool isWaiting = result == LUA_YIELD && _lastWaitingThread == task.thread;
+		_lastWaitingThread = nullptr;
+
+		// A task that waits again took a new reference to itself, one that finished or yielded on its own is left to the collector
+		// and stops being a task, the collector may hand its address to the next coroutine
+		if (!isWaiting)
+		{
+			_taskThreads.erase(task.thread);
+		}
+
+		ReleaseTask(task);
+	}
+}
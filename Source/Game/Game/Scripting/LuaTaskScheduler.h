@@ -0,0 +1,135 @@
+#pragma once
+#include "LuaDefines.h"
+
+#include <Base/Types.h>
+
+#include <robinhood/robinhood.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Scripting
+{
+	struct LuaTask
+	{
+	public:
+		lua_State* thread = nullptr;
+		i32 threadRef = 0; // Keeps the coroutine alive while nothing in the script references it
+		u32 scriptHash = 0; // Hash of the chunk name of the script the task waited from, used to drop it when that script is reloaded
+	};
+
+	// Resumes the coroutines started through Task.Spawn once whatever they wait for happened. Sleeping tasks sit in a min-heap ordered
+	// by the time they wake up, tasks waiting on events or engine operations in lists that are only looked at when one of those happens,
+	// so a waiting task costs nothing per frame. Every state has its own scheduler in its event table, only the thread running the state touches it.
+	class LuaTaskScheduler
+	{
+	public:
+		enum class OperationState : u8
+		{
+			Invalid,
+			Pending,
+			Succeeded,
+			Failed,
+			Expired // Completed longer than OPERATION_RESULT_LIFETIME updates ago, the result is gone
+		};
+
+		// Only the pending operations and the results of recent ones are kept, so the memory doesn't grow with every operation ever started
+		static constexpr u32 OPERATION_RESULT_LIFETIME = 3600;
+
+	public:
+		LuaTaskScheduler(lua_State* owner, u32 numEvents);
+
+		static LuaTaskScheduler* Get(lua_State* state);
+
+		// Runs the function at the top of the stack below its numArgs arguments as a new task, until it finishes or waits for the first time
+		lua_State* Spawn(lua_State* state, i32 numArgs);
+
+		// Called from the task itself, which has to yield right after
+		void WaitForTime(lua_State* thread, f64 seconds);
+		void WaitForEvent(lua_State* thread, u32 eventID);
+		void WaitForOperation(lua_State* thread, u32 operationID);
+
+		// Wakes the tasks whose time is up and the ones waiting on operations that completed since the last update
+		void Update(f64 deltaTime);
+
+		// pushArgs(thread) pushes the arguments of the event onto the thread and returns how many it pushed
+		template <typename PushArgs>
+		void ResumeEventTasks(u32 eventID, PushArgs&& pushArgs)
+		{
+			if (eventID >= _eventTasks.size() || _eventTasks[eventID].empty())
+				return;
+
+			// Tasks that wait for the same event again are woken up the next time it fires
+			std::vector<LuaTask> tasks;
+			tasks.swap(_eventTasks[eventID]);
+
+			for (const LuaTask& task : tasks)
+			{
+				Resume(task, pushArgs(task.thread));
+			}
+		}
+
+		void ClearScriptTasks(u32 scriptHash);
+		void Clear();
+
+		// Only threads started through Spawn that haven't finished, coroutines the script created itself are resumed by the script
+		bool IsTask(lua_State* state) const { return _taskThreads.contains(state); }
+		u32 GetNumWaiting() const;
+
+	public:
+		// Engine operations scripts can wait on, BeginOperation and CompleteOperation can be called from any thread
+		static u32 BeginOperation();
+		static void CompleteOperation(u32 operationID, bool success);
+		static OperationState GetOperationState(u32 operationID);
+
+		// Pushes what Task.Await returns for a completed operation, whether it succeeded or nil if its result expired
+		static void PushOperationResult(lua_State* state, OperationState operationState);
+
+		// Makes the operations completed since the last call visible to the schedulers, no state may be running
+		static void UpdateOperations();
+
+	private:
+		struct SleepingTask
+		{
+		public:
+			f64 wakeTime;
+			f64 startTime;
+			u64 sequence; // Tasks that wake up at the same time run in the order they went to sleep
+			LuaTask task;
+		};
+
+		static bool IsLater(const SleepingTask& a, const SleepingTask& b);
+
+		LuaTask CreateTask(lua_State* thread);
+		void ReleaseTask(const LuaTask& task);
+		void Resume(const LuaTask& task, i32 numArgs);
+
+	private:
+		lua_State* _owner;
+		lua_State* _lastWaitingThread = nullptr;
+
+		robin_hood::unordered_set<lua_State*> _taskThreads;
+
+		f64 _time = 0.0;
+		u64 _sequence = 0;
+
+		std::vector<SleepingTask> _sleepingTasks; // Min-heap on wakeTime
+		std::vector<SleepingTask> _wakingTasks;
+		std::vector<std::vector<LuaTask>> _eventTasks;
+		std::vector<std::pair<u32, LuaTask>> _operationTasks;
+
+		static std::atomic<u32> _nextOperationID;
+		static std::mutex _operationsMutex;
+		static robin_hood::unordered_set<u32> _pendingOperations; // Started and not yet visible as completed
+		static std::vector<std::pair<u32, bool>> _pendingCompletedOperations;
+
+		// Only written by UpdateOperations
+		static std::vector<std::pair<u32, bool>> _completedOperations; // Completed in the last UpdateOperations
+		static robin_hood::unordered_map<u32, bool> _operationResults;
+		static std::deque<std::pair<u64, u32>> _operationResultExpiry; // Update the result was added in and its operation, oldest first
+		static u64 _operationUpdate;
+	};
+}
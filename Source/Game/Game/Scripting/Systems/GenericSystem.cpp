@@ -9,7 +9,14 @@
 
 namespace Scripting
 {
-	GenericSystem::GenericSystem(u32 numStates) : LuaSystemBase(numStates) { }
+	// Scripts can read anything the handlers expose, transforms they write through Entities.Commit are only applied after the script update
+	static constexpr ECS::SystemAccess GenericSystemAccess =
+	{
+		ECS::SystemResource::Transform | ECS::SystemResource::Model | ECS::SystemResource::Physics,
+		0
+	};
+
+	GenericSystem::GenericSystem(u32 numStates) : LuaSystemBase(numStates, GenericSystemAccess) { }
 
 	void GenericSystem::Prepare(f32 deltaTime)
 	{
@@ -1,19 +1,32 @@
 #include "LuaSystemBase.h"
 #include "Game/Scripting/LuaDefines.h"
 #include "Game/Scripting/LuaManager.h"
+#include "Game/Scripting/LuaTaskScheduler.h"
 #include "Game/Scripting/Handlers/GameEventHandler.h"
 #include "Game/Util/ServiceLocator.h"
 
 #include <Base/Util/DebugHandler.h>
+#include <Base/Util/Timer.h>
 
 #include <lualib.h>
+#include <tracy/Tracy.hpp>
 
 #include <robinhood/robinhood.h>
 #include <Game/Scripting/LuaStateCtx.h>
 
 namespace Scripting
 {
-	LuaSystemBase::LuaSystemBase(u32 numStates) : _events()
+	LuaSystemTask::LuaSystemTask(LuaSystemBase* system) : _system(system)
+	{
+		m_MinRange = 1;
+	}
+
+	void LuaSystemTask::ExecuteRange(enki::TaskSetPartition range, u32 threadNum)
+	{
+		_system->RunStates(range.start, range.end);
+	}
+
+	LuaSystemBase::LuaSystemBase(u32 numStates, const ECS::SystemAccess& access) : _events(), _access(access), _task(this)
 	{
 		Init(numStates);
 	}
@@ -30,9 +43,16 @@ namespace Scripting
 		_states.clear();
 		_states.reserve(numStates);
 
+		for (u32 i = static_cast<u32>(_statePools.size()); i < numStates; i++)
+		{
+			_statePools.push_back(new LuaStatePool());
+		}
+
+		// States have to line up with their pools, so the ones after a state that couldn't be created aren't created either
 		for (u32 i = 0; i < numStates; i++)
 		{
-			CreateState();
+			if (CreateState(i) == nullptr)
+				break;
 		}
 	}
 
@@ -54,6 +74,12 @@ namespace Scripting
 				default: break;
 			}
 		}
+
+		// None of our states are running at this point, so this is where their collectors get to do their work
+		for (LuaStatePool* statePool : _statePools)
+		{
+			statePool->StepGC();
+		}
 	}
 
 	void LuaSystemBase::PushEvent(LuaSystemEvent systemEvent)
@@ -61,29 +87,91 @@ namespace Scripting
 		_events.enqueue(systemEvent);
 	}
 
-	lua_State* LuaSystemBase::CreateState()
+	void LuaSystemBase::ResetNode(f32 deltaTime)
 	{
-		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+		_deltaTime = deltaTime;
+		_task.m_SetSize = static_cast<u32>(_states.size());
+
+		_numPendingDependencies = static_cast<u32>(_dependencies.size());
+		_numPendingStates = static_cast<u32>(_states.size());
+	}
+
+	void LuaSystemBase::Launch()
+	{
+		// Nothing to run, but the systems waiting on this one still have to start
+		if (_states.size() == 0)
+		{
+			RunStates(0, 0);
+			return;
+		}
+
+		enki::TaskScheduler* scheduler = ServiceLocator::GetTaskScheduler();
+		scheduler->AddTaskSetToPipe(&_task);
+	}
 
-		LuaStateCtx ctx(luaL_newstate());
+	void LuaSystemBase::RunStates(u32 begin, u32 end)
+	{
+		ZoneScoped;
+
+		Timer timer;
+
+		for (u32 i = begin; i < end; i++)
+		{
+			// Tasks sleeping in this state wake up on the same thread that runs it
+			if (LuaTaskScheduler* taskScheduler = LuaTaskScheduler::Get(_states[i]))
+			{
+				taskScheduler->Update(_deltaTime);
+			}
+
+			// The first state gets the update event, it has the same VM to itself as the rest of its run
+			if (i == 0)
+			{
+				Prepare(_deltaTime);
+			}
+
+			Run(_deltaTime, i);
+		}
 
-		ctx.RegisterDefaultLibraries();
+		_runTimeNS += static_cast<u64>(timer.GetLifeTime() * 1000000000.0);
 
-		// Set Globals
+		// Dependents are launched from the last partition before it returns, so by the time waiting on this task is over they are already queued
+		u32 numStates = end - begin;
+		if (_numPendingStates.fetch_sub(numStates) != numStates)
+			return;
+
+		for (LuaSystemBase* dependent : _dependents)
 		{
-			const LuaTable& table = luaManager->GetGlobalTable();
-			ctx.SetGlobal(table);
+			if (dependent->_numPendingDependencies.fetch_sub(1) == 1)
+			{
+				dependent->Launch();
+			}
 		}
+	}
+
+	void LuaSystemBase::AddDependency(LuaSystemBase* system)
+	{
+		_dependencies.push_back(system);
+		system->_dependents.push_back(this);
+	}
+
+	lua_State* LuaSystemBase::CreateState(u32 index)
+	{
+		LuaManager* luaManager = ServiceLocator::GetLuaManager();
+
+		// The pool only builds the libraries and globals again if they changed since its base state was created
+		const LuaTable& table = luaManager->GetGlobalTable();
+		lua_State* pooledState = _statePools[index]->Acquire(table, luaManager->GetGlobalTableVersion());
+		if (pooledState == nullptr)
+			return nullptr;
 
-		ctx.MakeReadOnly();
+		LuaStateCtx ctx(pooledState);
 
 		const std::vector<LuaBytecodeEntry>& bytecodeList = luaManager->GetBytecodeList();
 		for (u32 j = 0; j < bytecodeList.size(); j++)
 		{
 			const LuaBytecodeEntry& bytecodeEntry = bytecodeList[j];
-			std::string filePath = bytecodeEntry.filePath + "/" + bytecodeEntry.fileName;
 
-			i32 result = ctx.LoadBytecode(filePath.c_str(), bytecodeEntry.bytecode, 0);
+			i32 result = luaManager->LoadModule(ctx.GetState(), bytecodeEntry);
 			if (result != LUA_OK)
 			{
 				ctx.Pop();
@@ -124,7 +212,7 @@ namespace Scripting
 		auto gameEventHandler = luaManager->GetLuaHandler<GameEventHandler*>(LuaHandlerType::GameEvent);
 		gameEventHandler->ClearEvents(ctx.GetState());
 
-		ctx.Close();
+		_statePools[index]->Release(state);
 
 		return true;
 	}
@@ -1,33 +1,76 @@
 #pragma once
+#include "Game/ECS/SystemAccess.h"
 #include "Game/Scripting/LuaDefines.h"
+#include "Game/Scripting/LuaStatePool.h"
 
 #include <Base/Types.h>
 #include <Base/Container/ConcurrentQueue.h>
 
+#include <enkiTS/TaskScheduler.h>
+
+#include <atomic>
 #include <vector>
 
 namespace Scripting
 {
+	class LuaSystemBase;
+
+	// Runs the states of a system on the task scheduler, one state per partition at the smallest
+	class LuaSystemTask : public enki::ITaskSet
+	{
+	public:
+		LuaSystemTask(LuaSystemBase* system);
+
+		void ExecuteRange(enki::TaskSetPartition range, u32 threadNum) override;
+
+	private:
+		LuaSystemBase* _system;
+	};
+
+	// A node of the script update. Systems declare what they read and write, a system only waits for the systems registered before it
+	// that it conflicts with, and the ECS scheduler only waits for the systems that conflict with the native system it runs next
 	class LuaSystemBase
 	{
 	public:
-		LuaSystemBase(u32 numStates);
+		LuaSystemBase(u32 numStates, const ECS::SystemAccess& access);
+
+		const ECS::SystemAccess& GetAccess() const { return _access; }
 
 	private:
 		friend LuaManager;
+		friend LuaSystemTask;
 
 		void Init(u32 numStates);
 		void Update(f32 deltaTime);
 		void PushEvent(LuaSystemEvent systemEvent);
 
+		// Every system has to be reset before the first one is launched, a system finishing early would otherwise count down a dependent too soon
+		void ResetNode(f32 deltaTime);
+		void Launch();
+		void RunStates(u32 begin, u32 end);
+
+		void AddDependency(LuaSystemBase* system);
+
 	protected:
 		virtual void Prepare(f32 deltaTime) = 0;
 		virtual void Run(f32 deltaTime, u32 index) = 0;
 
-		lua_State* CreateState();
+		lua_State* CreateState(u32 index);
 		bool DestroyState(u32 index);
 
 		std::vector<lua_State*> _states;
+		std::vector<LuaStatePool*> _statePools; // One per state, states of the same pool share a VM and can't run in parallel
 		moodycamel::ConcurrentQueue<LuaSystemEvent> _events;
+
+	private:
+		ECS::SystemAccess _access;
+		LuaSystemTask _task;
+		f32 _deltaTime = 0.0f;
+
+		std::vector<LuaSystemBase*> _dependencies;
+		std::vector<LuaSystemBase*> _dependents;
+		std::atomic<u32> _numPendingDependencies = 0;
+		std::atomic<u32> _numPendingStates = 0;
+		std::atomic<u64> _runTimeNS = 0;
 	};
 }
\ No newline at end of file
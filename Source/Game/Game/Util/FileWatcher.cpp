@@ -0,0 +1,255 @@
+#include "FileWatcher.h"
+
+#include <Base/Util/DebugHandler.h>
+
+#include <robinhood/robinhood.h>
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Util
+{
+	static i64 GetWriteTime(const fs::path& path)
+	{
+		std::error_code errorCode;
+		fs::file_time_type writeTime = fs::last_write_time(path, errorCode);
+		if (errorCode)
+			return 0;
+
+		return static_cast<i64>(writeTime.time_since_epoch().count());
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	bool FileWatcher::Start(const std::string& directory, const std::string& extension)
+	{
+		Stop();
+
+		std::error_code errorCode;
+		if (!fs::is_directory(directory, errorCode))
+			return false;
+
+		_directory = directory;
+		_extension = extension;
+
+		_knownFiles.clear();
+		ScanFiles(_knownFiles);
+
+#ifdef __linux__
+		_inotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_inotifyFD < 0)
+		{
+			DebugHandler::PrintWarning("FileWatcher : Failed to initialize inotify, changes in {0} won't be detected", _directory);
+			return false;
+		}
+
+		AddWatchRecursive(_directory);
+#else
+		_lastScanTime = std::chrono::steady_clock::now();
+#endif
+
+		_isWatching = true;
+		return true;
+	}
+
+	void FileWatcher::Stop()
+	{
+#ifdef __linux__
+		if (_inotifyFD >= 0)
+		{
+			// Closing the descriptor releases all of its watches
+			close(_inotifyFD);
+			_inotifyFD = -1;
+		}
+
+		_watchDescriptorToDirectory.clear();
+#endif
+
+		_knownFiles.clear();
+		_isWatching = false;
+	}
+
+	bool FileWatcher::Poll(Changes& changes)
+	{
+		changes.modifiedPaths.clear();
+		changes.structureChanged = false;
+
+		if (!_isWatching)
+			return false;
+
+#ifdef __linux__
+		// Editors often save through several events (write temp file, rename, delete backup), so we only
+		// collect the touched paths here and look at what is actually on disk once the queue is drained
+		robin_hood::unordered_set<std::string> touchedPaths;
+
+		alignas(inotify_event) char buffer[4096];
+		while (true)
+		{
+			ssize_t length = read(_inotifyFD, buffer, sizeof(buffer));
+			if (length <= 0)
+				break;
+
+			for (char* ptr = buffer; ptr < buffer + length;)
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					// We lost events, the only safe thing to do is to treat everything as changed
+					changes.structureChanged = true;
+					continue;
+				}
+
+				if (event->mask & IN_IGNORED)
+				{
+					_watchDescriptorToDirectory.erase(event->wd);
+					continue;
+				}
+
+				auto itr = _watchDescriptorToDirectory.find(event->wd);
+				if (itr == _watchDescriptorToDirectory.end() || event->len == 0)
+					continue;
+
+				fs::path path = fs::path(itr->second) / event->name;
+
+				if (event->mask & IN_ISDIR)
+				{
+					if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					{
+						AddWatchRecursive(path.string());
+					}
+
+					changes.structureChanged = true;
+					continue;
+				}
+
+				if (path.extension() != _extension)
+					continue;
+
+				touchedPaths.insert(path.string());
+			}
+		}
+
+		for (const std::string& path : touchedPaths)
+		{
+			ResolvePath(path, false, changes);
+		}
+
+		if (changes.structureChanged)
+		{
+			// Directories might have moved with files in them, rebuild the list so the next poll starts from the truth
+			_knownFiles.clear();
+			ScanFiles(_knownFiles);
+		}
+#else
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (std::chrono::duration_cast<std::chrono::milliseconds>(now - _lastScanTime).count() < POLL_INTERVAL_MS)
+			return false;
+
+		_lastScanTime = now;
+
+		robin_hood::unordered_map<std::string, i64> files;
+		ScanFiles(files);
+
+		for (auto& pair : files)
+		{
+			ResolvePath(pair.first, true, changes);
+		}
+
+		// Anything we knew about that the scan didn't find was removed
+		if (changes.structureChanged || _knownFiles.size() != files.size())
+		{
+			changes.structureChanged = true;
+			_knownFiles = std::move(files);
+		}
+#endif
+
+		return !changes.IsEmpty();
+	}
+
+	void FileWatcher::ScanFiles(robin_hood::unordered_map<std::string, i64>& files)
+	{
+		std::error_code errorCode;
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(_directory, errorCode))
+		{
+			if (!entry.is_regular_file())
+				continue;
+
+			const fs::path& path = entry.path();
+			if (path.extension() != _extension)
+				continue;
+
+			files[path.string()] = GetWriteTime(path);
+		}
+	}
+
+	void FileWatcher::ResolvePath(const std::string& path, bool compareWriteTime, Changes& changes)
+	{
+		std::error_code errorCode;
+		bool exists = fs::is_regular_file(path, errorCode);
+
+		auto itr = _knownFiles.find(path);
+		if (!exists)
+		{
+			if (itr != _knownFiles.end())
+			{
+				_knownFiles.erase(itr);
+				changes.structureChanged = true;
+			}
+
+			return;
+		}
+
+		i64 writeTime = GetWriteTime(path);
+		if (itr == _knownFiles.end())
+		{
+			_knownFiles[path] = writeTime;
+			changes.structureChanged = true;
+			return;
+		}
+
+		// Write times can have a coarse resolution, so events from inotify are trusted without comparing them
+		if (compareWriteTime && itr->second == writeTime)
+			return;
+
+		itr->second = writeTime;
+		changes.modifiedPaths.push_back(path);
+	}
+
+#ifdef __linux__
+	void FileWatcher::AddWatchRecursive(const std::string& directory)
+	{
+		const u32 mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+		i32 watchDescriptor = inotify_add_watch(_inotifyFD, directory.c_str(), mask);
+		if (watchDescriptor >= 0)
+		{
+			_watchDescriptorToDirectory[watchDescriptor] = directory;
+		}
+
+		std::error_code errorCode;
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(directory, errorCode))
+		{
+			if (!entry.is_directory())
+				continue;
+
+			std::string subDirectory = entry.path().string();
+
+			watchDescriptor = inotify_add_watch(_inotifyFD, subDirectory.c_str(), mask);
+			if (watchDescriptor >= 0)
+			{
+				_watchDescriptorToDirectory[watchDescriptor] = subDirectory;
+			}
+		}
+	}
+#endif
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <robinhood/robinhood.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Util
+{
+	// Watches a directory tree for changes to files with a given extension. Uses inotify on Linux,
+	// other platforms fall back to comparing last write times every POLL_INTERVAL_MS.
+	class FileWatcher
+	{
+	public:
+		static constexpr u32 POLL_INTERVAL_MS = 500;
+
+		struct Changes
+		{
+		public:
+			std::vector<std::string> modifiedPaths;
+			bool structureChanged = false; // Set if a watched file was added or removed
+
+			bool IsEmpty() const { return modifiedPaths.empty() && !structureChanged; }
+		};
+
+		FileWatcher() { }
+		~FileWatcher();
+
+		bool Start(const std::string& directory, const std::string& extension);
+		void Stop();
+
+		bool IsWatching() const { return _isWatching; }
+		const std::string& GetDirectory() const { return _directory; }
+
+		// Never blocks, returns true if anything changed since the last call
+		bool Poll(Changes& changes);
+
+	private:
+		void ScanFiles(robin_hood::unordered_map<std::string, i64>& files);
+		void ResolvePath(const std::string& path, bool compareWriteTime, Changes& changes);
+
+#ifdef __linux__
+		void AddWatchRecursive(const std::string& directory);
+#endif
+
+	private:
+		std::string _directory;
+		std::string _extension;
+		bool _isWatching = false;
+
+		robin_hood::unordered_map<std::string, i64> _knownFiles;
+
+#ifdef __linux__
+		i32 _inotifyFD = -1;
+		robin_hood::unordered_map<i32, std::string> _watchDescriptorToDirectory;
+#else
+		std::chrono::steady_clock::time_point _lastScanTime;
+#endif
+	};
+}
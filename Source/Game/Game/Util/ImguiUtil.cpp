@@ -860,5 +860,17 @@ namespace Util
 
 			return false;
 		}
+
+		bool Inspect(const char* name, Util::InternedString& value, f32 speed)
+		{
+			const Util::InternedString& constValue = value;
+			return Inspect(name, constValue, speed);
+		}
+
+		bool Inspect(const char* name, const Util::InternedString& value, f32 speed)
+		{
+			const std::string& string = Util::StringInterner::Resolve(value);
+			return Inspect(name, string, speed);
+		}
 	}
 }
\ No newline at end of file
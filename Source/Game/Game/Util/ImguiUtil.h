@@ -3,6 +3,8 @@
 
 #include <Base/Util/Reflection.h>
 
+#include <Game/Util/StringInterner.h>
+
 struct ImGuiWindow;
 
 namespace Util
@@ -62,6 +64,10 @@ namespace Util
 		bool Inspect(const char* name, std::string& value, f32 speed);
 		bool Inspect(const char* name, const std::string& value, f32 speed);
 
+		// Interned strings are shared, so they are always read only
+		bool Inspect(const char* name, Util::InternedString& value, f32 speed);
+		bool Inspect(const char* name, const Util::InternedString& value, f32 speed);
+
 
 		template <typename ComponentType>
 		bool Inspect(ComponentType& component) 
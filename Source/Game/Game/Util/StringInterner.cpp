@@ -0,0 +1,74 @@
+#include "StringInterner.h"
+
+#include <mutex>
+
+namespace Util
+{
+	std::shared_mutex StringInterner::_mutex;
+	std::deque<std::string> StringInterner::_strings;
+	robin_hood::unordered_map<std::string_view, u32> StringInterner::_stringToID;
+	size_t StringInterner::_numStringBytes = 0;
+
+	InternedString StringInterner::Intern(std::string_view string)
+	{
+		InternedString handle;
+
+		// Most calls will be for strings we already know about, so try the shared lock first
+		{
+			std::shared_lock lock(_mutex);
+
+			auto itr = _stringToID.find(string);
+			if (itr != _stringToID.end())
+			{
+				handle.id = itr->second;
+				return handle;
+			}
+		}
+
+		std::unique_lock lock(_mutex);
+
+		// Another thread might have interned the string while we waited for the lock
+		auto itr = _stringToID.find(string);
+		if (itr != _stringToID.end())
+		{
+			handle.id = itr->second;
+			return handle;
+		}
+
+		handle.id = static_cast<u32>(_strings.size());
+
+		const std::string& storedString = _strings.emplace_back(string);
+		_stringToID[std::string_view(storedString)] = handle.id;
+		_numStringBytes += storedString.capacity() + 1;
+
+		return handle;
+	}
+
+	const std::string& StringInterner::Resolve(InternedString handle)
+	{
+		static const std::string invalidString = "";
+
+		std::shared_lock lock(_mutex);
+
+		if (handle.id >= _strings.size())
+			return invalidString;
+
+		return _strings[handle.id];
+	}
+
+	u32 StringInterner::GetNumStrings()
+	{
+		std::shared_lock lock(_mutex);
+		return static_cast<u32>(_strings.size());
+	}
+
+	size_t StringInterner::GetMemoryUsage()
+	{
+		std::shared_lock lock(_mutex);
+
+		size_t stringObjectBytes = _strings.size() * sizeof(std::string);
+		size_t lookupBytes = _stringToID.size() * (sizeof(std::string_view) + sizeof(u32));
+
+		return _numStringBytes + stringObjectBytes + lookupBytes;
+	}
+}
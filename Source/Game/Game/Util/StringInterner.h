@@ -0,0 +1,45 @@
+#pragma once
+#include <Base/Types.h>
+
+#include <robinhood/robinhood.h>
+
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+namespace Util
+{
+	struct InternedString
+	{
+	public:
+		static constexpr u32 Invalid = std::numeric_limits<u32>().max();
+
+		bool IsValid() const { return id != Invalid; }
+		bool operator==(const InternedString& other) const { return id == other.id; }
+		bool operator!=(const InternedString& other) const { return id != other.id; }
+
+		u32 id = Invalid;
+	};
+
+	// Global, thread-safe storage for strings that are shared by many objects (model paths, entity names etc)
+	// Each unique string is stored once and referenced through a stable InternedString handle
+	class StringInterner
+	{
+	public:
+		static InternedString Intern(std::string_view string);
+		static const std::string& Resolve(InternedString handle);
+
+		static u32 GetNumStrings();
+		static size_t GetMemoryUsage();
+
+	private:
+		StringInterner() { }
+
+		static std::shared_mutex _mutex;
+		static std::deque<std::string> _strings; // std::deque never moves its elements, this keeps both references and views stable
+		static robin_hood::unordered_map<std::string_view, u32> _stringToID;
+		static size_t _numStringBytes;
+	};
+}
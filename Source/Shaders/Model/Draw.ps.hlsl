@@ -70,7 +70,7 @@ PSOutput main(PSInput input)
 
 #if !SHADOW_PASS
     ModelInstanceData instanceData = _modelInstanceDatas[drawCallData.instanceID];
-    float4x4 instanceMatrix = _modelInstanceMatrices[drawCallData.instanceID];
+    float4x4 instanceMatrix = UnpackInstanceMatrix(_modelInstanceTransforms[drawCallData.instanceID]);
 
     // Get the VertexIDs of the triangle we're in
     Draw draw = _modelDraws[input.drawID];
@@ -39,7 +39,7 @@ VSOutput main(VSInput input)
 
     ModelDrawCallData drawCallData = LoadModelDrawCallData(drawCallID);
     ModelInstanceData instanceData = _modelInstanceDatas[drawCallData.instanceID];
-    float4x4 instanceMatrix = _modelInstanceMatrices[drawCallData.instanceID];
+    float4x4 instanceMatrix = UnpackInstanceMatrix(_modelInstanceTransforms[drawCallData.instanceID]);
 
     // Skin this vertex
     float4x4 boneTransformMatrix = CalcBoneTransformMatrix(instanceData, vertex);
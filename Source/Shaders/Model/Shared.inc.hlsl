@@ -148,7 +148,7 @@ ModelVertex LoadModelVertex(uint vertexID)
 }
 
 [[vk::binding(2, MODEL)]] StructuredBuffer<ModelInstanceData> _modelInstanceDatas;
-[[vk::binding(3, MODEL)]] StructuredBuffer<float4x4> _modelInstanceMatrices;
+[[vk::binding(3, MODEL)]] StructuredBuffer<PackedInstanceTransform> _modelInstanceTransforms;
 [[vk::binding(4, MODEL)]] StructuredBuffer<float4x4> _instanceBoneMatrices;
 
 struct PackedAnimatedVertexPosition
@@ -36,7 +36,7 @@ struct CullingData
 [[vk::binding(0, PER_PASS)]] StructuredBuffer<Draw> _drawCalls;
 [[vk::binding(1, PER_PASS)]] ByteAddressBuffer _drawCallDatas;
 [[vk::binding(2, PER_PASS)]] StructuredBuffer<PackedCullingData> _cullingDatas;
-[[vk::binding(3, PER_PASS)]] StructuredBuffer<float4x4> _instanceMatrices;
+[[vk::binding(3, PER_PASS)]] StructuredBuffer<PackedInstanceTransform> _instanceTransforms;
 [[vk::binding(4, PER_PASS)]] SamplerState _depthSampler;
 [[vk::binding(5, PER_PASS)]] Texture2D<float> _depthPyramid; // TODO: Occlusion culling for shadow cascades?
 
@@ -236,7 +236,7 @@ void main(CSInput input)
 
     const CullingData cullingData = LoadCullingData(modelID);
 
-    float4x4 instanceMatrix = _instanceMatrices[instanceID];
+    float4x4 instanceMatrix = UnpackInstanceMatrix(_instanceTransforms[instanceID]);
 
     // Get center and extents (Center is stored in min & Extents is stored in max)
     float3 center = cullingData.boundingBox.min;
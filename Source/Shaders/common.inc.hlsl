@@ -119,6 +119,23 @@ void WriteDrawToByteAdressBuffer(RWByteAddressBuffer byteAddressBuffer, uint dra
     byteAddressBuffer.Store(byteOffset + (4 * sizeof(uint)), draw.firstInstance);
 }
 
+struct PackedInstanceTransform
+{
+    float4 row0;
+    float4 row1;
+    float4 row2;
+}; // 48 bytes, the last row of an affine transform is always (0, 0, 0, 1) so it's not stored
+
+float4x4 UnpackInstanceMatrix(PackedInstanceTransform packed)
+{
+    // Returns the same layout as the float4x4 instance matrices we used to upload
+    return float4x4(
+        float4(packed.row0.x, packed.row1.x, packed.row2.x, 0.0f),
+        float4(packed.row0.y, packed.row1.y, packed.row2.y, 0.0f),
+        float4(packed.row0.z, packed.row1.z, packed.row2.z, 0.0f),
+        float4(packed.row0.w, packed.row1.w, packed.row2.w, 1.0f));
+}
+
 uint3 GetVertexIDs(uint triangleID, Draw draw, StructuredBuffer<uint> indexBuffer)
 {
     uint localIndexID = triangleID * 3;
@@ -126,7 +126,7 @@ float4 ShadeModel(const uint2 pixelPos, const float2 screenUV, const VisibilityB
 {
 	ModelDrawCallData drawCallData = LoadModelDrawCallData(vBuffer.drawID);
 	ModelInstanceData instanceData = _modelInstanceDatas[drawCallData.instanceID];
-	float4x4 instanceMatrix = _modelInstanceMatrices[drawCallData.instanceID];
+	float4x4 instanceMatrix = UnpackInstanceMatrix(_modelInstanceTransforms[drawCallData.instanceID]);
 
 	// Get the VertexIDs of the triangle we're in
 	Draw draw = _modelDraws[vBuffer.drawID];